@@ -0,0 +1,530 @@
+#pragma once
+
+#include "BenchSample.hpp"
+#include "ByteSource.hpp"
+#include "ColorMapEffect.hpp"
+#include "Crc32.hpp"
+#include "Hal.hpp"
+#include "ImageConvert.hpp"
+#include "ImageDecode.hpp"
+#include "InkyBase.hpp"
+#include "JpegParallel.hpp"
+#include "PhotoPipeline.hpp"
+#include "ScratchArena.hpp"
+#include "Trace.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <ostream>
+#include <string>
+
+// The bench command: each stage of the snap path timed on its own, then
+// decode and dither together, never refreshing the panel. The inputs are
+// fixed (the JPEG in BenchSample.hpp, and YUV and RGB565 frames made from
+// the same benchPattern), and so are the settings, so figures from two
+// builds on the same board can be compared. Each stage runs once to warm up
+// (flash cache, lookup tables) and then BenchRuns times, keeping the
+// fastest. Its check is a CRC of what it produced, which only changes if
+// its output does.
+//
+// Pixels are the source's for decoding and conversion, and the display's
+// for everything after. Dithering is timed over BenchDitherRows rows of the
+// display, and its ms/frame scaled up to the whole display.
+constexpr int BenchRuns = 5;
+constexpr int BenchDitherRows = 48;
+constexpr float BenchDitherAccuracy = 0.95f;
+// Raw frames repeat a block of this many rows of the pattern
+constexpr int BenchBlockRows = 8;
+// Chip select for the SPI stage. Nothing on the board is wired to it.
+constexpr uint BenchDummyCsPin = 22;
+
+// The bench picture: color ramps under a checkerboard, a gray ramp along
+// the bottom and some grain. Integer only, so it's the same everywhere.
+inline RGBColor benchPattern(int x, int y, int width, int height)
+{
+  int r = x * 255 / (width - 1);
+  int g = y * 255 / (height - 1);
+  int b = 255 - (x + y) * 255 / (width + height - 2);
+  if (y >= height * 7 / 8)
+  {
+    r = g = b = x * 255 / (width - 1);
+  }
+  else if (((x >> 3) + (y >> 3)) & 1)
+  {
+    r = r * 3 / 4;
+    g = g * 3 / 4;
+    b = b * 3 / 4;
+  }
+  uint32_t n = ((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u);
+  n = (n ^ (n >> 13)) * 0x5bd1e995;
+  int grain = (int)((n >> 24) & 15) - 8;
+  return RGBColor{(uint8_t)std::clamp(r + grain, 0, 255), (uint8_t)std::clamp(g + grain, 0, 255), (uint8_t)std::clamp(b + grain, 0, 255)};
+}
+
+// Row y of a block spread over the whole height of the pattern
+inline int benchBlockRow(int y, int height)
+{
+  return (y % BenchBlockRows) * height / BenchBlockRows;
+}
+
+// A frame of size bytes, made by repeating block over and over
+class RepeatingByteSource : public ByteSource
+{
+public:
+  RepeatingByteSource(const uint8_t* block, uint32_t blockSize, uint32_t size)
+    : block_{block}
+    , blockSize_{blockSize}
+    , remaining_{size}
+  { }
+
+  virtual uint32_t remaining() const override
+  {
+    return remaining_;
+  }
+
+  virtual uint32_t read(uint8_t* dest, uint32_t len) override
+  {
+    uint32_t count = std::min(len, remaining_);
+    for (uint32_t done = 0; done < count;)
+    {
+      uint32_t chunk = std::min(count - done, blockSize_ - offset_);
+      memcpy(dest + done, block_ + offset_, chunk);
+      done += chunk;
+      offset_ = (offset_ + chunk) % blockSize_;
+    }
+    remaining_ -= count;
+    return count;
+  }
+
+  virtual void discard() override
+  {
+    remaining_ = 0;
+  }
+
+private:
+  const uint8_t* block_;
+  uint32_t blockSize_;
+  uint32_t remaining_;
+  uint32_t offset_ = 0;
+};
+
+// Swallows decoded pixels, keeping a CRC of them while checking
+template <typename PixelT>
+class BenchSinkView : public ImageView<PixelT>
+{
+public:
+  bool checking = false;
+  uint32_t crc = 0;
+
+  BenchSinkView(int width, int height)
+    : ImageView<PixelT>(width, height)
+  { }
+
+  virtual PixelT getPixel(int /*x*/, int /*y*/) const override
+  {
+    return PixelT{};
+  }
+
+  virtual void setPixel(int x, int y, const PixelT& color) override
+  {
+    setPixels(x, y, &color, 1);
+  }
+
+  virtual void setPixels(int /*x*/, int /*y*/, const PixelT* colors, int count) override
+  {
+    if (checking)
+    {
+      crc = crc32(crc, (const uint8_t*)colors, count * sizeof(PixelT));
+    }
+  }
+};
+
+class Bench
+{
+public:
+  Bench(Inky& inky, PhotoPipeline& pipeline, std::ostream& out)
+    : inky_{inky}
+    , pipeline_{pipeline}
+    , out_{out}
+    , display_{inky.bufferIndexed()}
+    , labError_{display_.width}
+    , lumaError_{display_.width}
+  { }
+
+  // Run the stages whose names start with filter, all of them for "all".
+  // Leaves the display buffer holding whatever ran last.
+  bool run(const std::string& filter)
+  {
+    filter_ = filter == "all" ? "" : filter;
+    if (!jpegDimensions(BenchSampleJpeg, sizeof(BenchSampleJpeg), width_, height_))
+    {
+      out_ << "Bench sample is not a JPEG" << std::endl;
+      return false;
+    }
+
+    bool tracing = Trace::enabled;
+    Trace::enabled = false;
+    out_ << "Bench: " << display_.width << "x" << display_.height << " display, " << width_ << "x" << height_ << " sample, "
+         << halCpuHz() / 1000000 << " MHz, " << labKernels().name << " Lab kernels, fastest of " << BenchRuns << " runs" << std::endl;
+    stages_ = 0;
+    failures_ = 0;
+    decodeStages();
+    convertStages();
+    ditherStages();
+    packStage();
+    spiStage();
+    endToEndStages();
+    Trace::enabled = tracing;
+
+    if (stages_ == 0)
+    {
+      out_ << "No stage starts with " << filter << std::endl;
+      return false;
+    }
+    return failures_ == 0;
+  }
+
+private:
+  // Time run(checking) as one stage. The warm up run is the checking one,
+  // it's the only one that's allowed to be slow.
+  template <typename F>
+  void stage(const std::string& name, uint32_t pixels, uint32_t framePixels, F&& run)
+  {
+    if (name.compare(0, filter_.size(), filter_) != 0)
+    {
+      return;
+    }
+    ++stages_;
+    failed_ = false;
+    uint32_t check = run(true);
+    if (failed_)
+    {
+      ++failures_;
+      out_ << "  " << name << std::string(std::max<int>(1, 28 - (int)name.size()), ' ') << "failed" << std::endl;
+      return;
+    }
+    uint64_t best = UINT64_MAX;
+    for (int i=0; i < BenchRuns; ++i)
+    {
+      uint64_t startUs = halTimeUs();
+      run(false);
+      best = std::min(best, halTimeUs() - startUs);
+    }
+
+    float cyclesPerPixel = (float)best * ((float)halCpuHz() / 1000000.0f) / (float)pixels;
+    float msPerFrame = (float)best / 1000.0f * (float)framePixels / (float)pixels;
+    out_ << "  " << name << std::string(std::max<int>(1, 28 - (int)name.size()), ' ') << pixels << " px  "
+         << msPerFrame << " ms/frame  " << cyclesPerPixel << " cycles/px  check " << std::hex << check << std::dec << std::endl;
+  }
+
+  uint32_t displayCrc()
+  {
+    uint32_t crc = 0;
+    for (const FramePlane& plane : inky_.framePlanes())
+    {
+      crc = crc32(crc, plane.data, plane.size);
+    }
+    return crc;
+  }
+
+  // Raw frames the size of the sample, one block of rows repeated
+  void fillRawBlocks(uint8_t* yuyv, uint16_t* rgb565, RGBColor* rgb, int width)
+  {
+    for (int row=0; row < BenchBlockRows; ++row)
+    {
+      int y = benchBlockRow(row, height_);
+      for (int x=0; x < width; ++x)
+      {
+        RGBColor c = benchPattern(x, y, width, height_);
+        rgb[row * width + x] = c;
+        rgb565[row * width + x] = (uint16_t)(((c.R >> 3) << 11) | ((c.G >> 2) << 5) | (c.B >> 3));
+        // BT.601, full range. U goes with even pixels and V with odd ones.
+        uint8_t* p = yuyv + (row * width + x) * 2;
+        p[0] = (uint8_t)std::clamp((77 * c.R + 150 * c.G + 29 * c.B) >> 8, 0, 255);
+        p[1] = (x % 2 == 0) ? (uint8_t)std::clamp(((-43 * c.R - 85 * c.G + 128 * c.B) >> 8) + 128, 0, 255)
+                            : (uint8_t)std::clamp(((128 * c.R - 107 * c.G - 21 * c.B) >> 8) + 128, 0, 255);
+      }
+    }
+  }
+
+  template <typename PixelT, typename Decode>
+  void decodeStage(const std::string& name, int width, int height, Decode&& decode)
+  {
+    uint32_t pixels = (uint32_t)(width_ * height_);
+    stage(name, pixels, pixels, [&](bool checking)
+    {
+      BenchSinkView<PixelT> sink(width, height);
+      sink.checking = checking;
+      failed_ |= !decode(sink);
+      return sink.crc;
+    });
+  }
+
+  void decodeStages()
+  {
+    uint32_t rawSize = (uint32_t)(width_ * height_ * 2);
+    uint32_t blockSize = (uint32_t)(width_ * BenchBlockRows * 2);
+    ScratchBuffer<uint8_t> yuyv(blockSize);
+    ScratchBuffer<uint16_t> rgb565(width_ * BenchBlockRows);
+    ScratchBuffer<RGBColor> rgb(width_ * BenchBlockRows);
+    fillRawBlocks(yuyv.data(), rgb565.data(), rgb.data(), width_);
+
+    decodeStage<RGBColor>("decode/jpeg", width_, height_, [&](auto& sink)
+    {
+      MemoryByteSource src(BenchSampleJpeg, sizeof(BenchSampleJpeg));
+      return decodeImageJPG(width_, height_, src, sink);
+    });
+    decodeStage<RGBColor>("decode/jpeg-pipelined", width_, height_, [&](auto& sink)
+    {
+      MemoryByteSource src(BenchSampleJpeg, sizeof(BenchSampleJpeg));
+      return decodeImageJPGPipelined(width_, height_, src, sink);
+    });
+    decodeStage<RGBColor>("decode/jpeg-parallel", width_, height_, [&](auto& sink)
+    {
+      return decodeImageJPGParallel(width_, height_, BenchSampleJpeg, sizeof(BenchSampleJpeg), sink);
+    });
+    decodeStage<RGBColor>("decode/yuv", width_, height_, [&](auto& sink)
+    {
+      RepeatingByteSource src(yuyv.data(), blockSize, rawSize);
+      return decodeImageYUYV(width_, height_, src, sink);
+    });
+    decodeStage<RGBColor>("decode/yuv-half", width_ / 2, height_ / 2, [&](auto& sink)
+    {
+      RepeatingByteSource src(yuyv.data(), blockSize, rawSize);
+      return decodeImageYUYVHalf(width_, height_, src, sink);
+    });
+    decodeStage<RGBColor>("decode/rgb565", width_, height_, [&](auto& sink)
+    {
+      RepeatingByteSource src((const uint8_t*)rgb565.data(), blockSize, rawSize);
+      return decodeImageRGB565(width_, height_, src, sink);
+    });
+  }
+
+  // To Lab through the lookup tables, a decoder's chunk at a time
+  void convertStages()
+  {
+    uint32_t pixels = (uint32_t)(width_ * height_);
+    ScratchBuffer<uint8_t> yuyv(width_ * BenchBlockRows * 2);
+    ScratchBuffer<uint16_t> rgb565(width_ * BenchBlockRows);
+    ScratchBuffer<RGBColor> rgb(width_ * BenchBlockRows);
+    fillRawBlocks(yuyv.data(), rgb565.data(), rgb.data(), width_);
+
+    // YUYV split into planes, chroma shared by each pair
+    ScratchBuffer<uint8_t> planes(width_ * BenchBlockRows * 3);
+    uint8_t* ys = planes.data();
+    uint8_t* us = ys + width_ * BenchBlockRows;
+    uint8_t* vs = us + width_ * BenchBlockRows;
+    for (int i=0; i < width_ * BenchBlockRows; ++i)
+    {
+      int pair = i & ~1;
+      ys[i] = yuyv[i * 2];
+      us[i] = yuyv[pair * 2 + 1];
+      vs[i] = yuyv[pair * 2 + 3];
+    }
+
+    auto convert = [&](bool checking, auto&& chunk)
+    {
+      LabColor lab[DecodeChunkSize];
+      uint32_t crc = 0;
+      for (int y=0; y < height_; ++y)
+      {
+        int row = (y % BenchBlockRows) * width_;
+        for (int x=0; x < width_; x += DecodeChunkSize)
+        {
+          int count = std::min(DecodeChunkSize, width_ - x);
+          chunk(row + x, lab, count);
+          if (checking)
+          {
+            crc = crc32(crc, (const uint8_t*)lab, count * sizeof(LabColor));
+          }
+        }
+      }
+      return crc;
+    };
+    stage("convert/rgb", pixels, pixels, [&](bool checking)
+    {
+      return convert(checking, [&](int i, LabColor* lab, int count) { pixelsFromRGB(rgb.data() + i, lab, count); });
+    });
+    stage("convert/yuv", pixels, pixels, [&](bool checking)
+    {
+      return convert(checking, [&](int i, LabColor* lab, int count) { pixelsFromYUV(ys + i, us + i, vs + i, lab, count); });
+    });
+  }
+
+  // Rows of the display from a block of input, ditherAccuracy fixed
+  template <typename View, typename PixelT>
+  void ditherRows(View& view, const PixelT* block, int rows)
+  {
+    view.ditherAccuracy = BenchDitherAccuracy;
+    for (int y=0; y < rows; ++y)
+    {
+      view.setPixels(0, y, block + (y % BenchBlockRows) * display_.width, display_.width);
+    }
+    view.flush();
+  }
+
+  void ditherStages()
+  {
+    int width = display_.width;
+    uint32_t pixels = (uint32_t)(width * BenchDitherRows);
+    uint32_t framePixels = (uint32_t)(width * display_.height);
+
+    ScratchBuffer<RGBColor> rgb(width * BenchBlockRows);
+    ScratchBuffer<LabColor> lab(width * BenchBlockRows);
+    ScratchBuffer<LumaColor> luma(width * BenchBlockRows);
+    for (int row=0; row < BenchBlockRows; ++row)
+    {
+      int y = benchBlockRow(row, display_.height);
+      for (int x=0; x < width; ++x)
+      {
+        RGBColor c = benchPattern(x, y, width, display_.height);
+        rgb[row * width + x] = c;
+        pixelFromRGB(c.R, c.G, c.B, lab[row * width + x]);
+        pixelFromRGB(c.R, c.G, c.B, luma[row * width + x]);
+      }
+    }
+
+    for (ColorMapEffect effect : magic_enum::enum_values<ColorMapEffect>())
+    {
+      std::shared_ptr<IndexedColorMap> effectMap = getColorMapWithEffect(inky_.colorMap(), effect);
+      if (effect != ColorMapEffect::None && !effectMap)
+      {
+        continue;
+      }
+      const IndexedColorMap& colorMap = effectMap ? *effectMap : inky_.colorMap();
+      std::string suffix = "/" + std::string(magic_enum::enum_name(effect));
+
+      inky_.clear();
+      stage("dither/lab" + suffix, pixels, framePixels, [&](bool checking)
+      {
+        LabInputDitherView view(display_, colorMap, &labError_);
+        ditherRows(view, lab.data(), BenchDitherRows);
+        return checking ? displayCrc() : 0;
+      });
+      inky_.clear();
+      stage("dither/rgb" + suffix, pixels, framePixels, [&](bool checking)
+      {
+        LabDitherView view(display_, colorMap, &labError_);
+        ditherRows(view, rgb.data(), BenchDitherRows);
+        return checking ? displayCrc() : 0;
+      });
+      if (colorMap.isMonochrome())
+      {
+        inky_.clear();
+        stage("dither/luma" + suffix, pixels, framePixels, [&](bool checking)
+        {
+          LumaDitherView view(display_, colorMap, &lumaError_);
+          ditherRows(view, luma.data(), BenchDitherRows);
+          return checking ? displayCrc() : 0;
+        });
+      }
+      inky_.clear();
+      stage("dither/nearest" + suffix, pixels, framePixels, [&](bool checking)
+      {
+        RGBToIndexedImageView view(display_, colorMap);
+        for (int y=0; y < BenchDitherRows; ++y)
+        {
+          view.setPixels(0, y, rgb.data() + (y % BenchBlockRows) * width, width);
+        }
+        return checking ? displayCrc() : 0;
+      });
+    }
+  }
+
+  // Indexed colors straight into the display buffer
+  void packStage()
+  {
+    uint32_t pixels = (uint32_t)(display_.width * display_.height);
+    const auto& colors = inky_.colorMap().indexedColors();
+    stage("pack", pixels, pixels, [&](bool checking)
+    {
+      for (int y=0; y < display_.height; ++y)
+      {
+        for (int x=0; x < display_.width; ++x)
+        {
+          display_.setPixel(x, y, colors[((x >> 3) + (y >> 3)) % colors.size()]);
+        }
+      }
+      display_.flush();
+      return checking ? displayCrc() : 0;
+    });
+  }
+
+  void spiStage()
+  {
+    uint32_t pixels = (uint32_t)(display_.width * display_.height);
+    inky_.clear();
+    stage("spi", pixels, pixels, [&](bool checking)
+    {
+      inky_.uploadToDummy(BenchDummyCsPin);
+      return checking ? displayCrc() : 0;
+    });
+  }
+
+  // Decode into the dither, as a snap does, with the panel's own colors
+  template <typename Source>
+  void endToEndStage(const std::string& name, CaptureFormat format, bool yuvDownsample, DecodeMode mode, Source&& makeSource)
+  {
+    uint32_t pixels = (uint32_t)(width_ * height_);
+    const IndexedColorMap& colorMap = inky_.colorMap();
+    bool downsample = pipeline_.yuvDownsample;
+    pipeline_.yuvDownsample = yuvDownsample;
+    ProgressUpdateCallback noProgress = nullptr;
+    inky_.clear();
+    stage(name, pixels, pixels, [&](bool checking)
+    {
+      auto src = makeSource();
+      if (colorMap.isMonochrome())
+      {
+        LumaDitherView view(display_, colorMap, &lumaError_);
+        view.ditherAccuracy = BenchDitherAccuracy;
+        failed_ |= !pipeline_.decodeImage(view, src, format, width_, height_, noProgress, mode);
+      }
+      else
+      {
+        LabInputDitherView view(display_, colorMap, &labError_);
+        view.ditherAccuracy = BenchDitherAccuracy;
+        failed_ |= !pipeline_.decodeImage(view, src, format, width_, height_, noProgress, mode);
+      }
+      return checking ? displayCrc() : 0;
+    });
+    pipeline_.yuvDownsample = downsample;
+  }
+
+  void endToEndStages()
+  {
+    uint32_t rawSize = (uint32_t)(width_ * height_ * 2);
+    uint32_t blockSize = (uint32_t)(width_ * BenchBlockRows * 2);
+    ScratchBuffer<uint8_t> yuyv(blockSize);
+    ScratchBuffer<uint16_t> rgb565(width_ * BenchBlockRows);
+    ScratchBuffer<RGBColor> rgb(width_ * BenchBlockRows);
+    fillRawBlocks(yuyv.data(), rgb565.data(), rgb.data(), width_);
+
+    auto jpeg = [&]() { return MemoryByteSource(BenchSampleJpeg, sizeof(BenchSampleJpeg)); };
+    auto yuv = [&]() { return RepeatingByteSource(yuyv.data(), blockSize, rawSize); };
+    endToEndStage("e2e/jpeg", CaptureFormat::JPG, true, DecodeMode::SingleCore, jpeg);
+    endToEndStage("e2e/jpeg-parallel", CaptureFormat::JPG, true, DecodeMode::Any, jpeg);
+    endToEndStage("e2e/yuv", CaptureFormat::YUV, false, DecodeMode::Any, yuv);
+    endToEndStage("e2e/yuv-half", CaptureFormat::YUV, true, DecodeMode::Any, yuv);
+    endToEndStage("e2e/rgb565", CaptureFormat::RGB565, true, DecodeMode::Any, [&]()
+    {
+      return RepeatingByteSource((const uint8_t*)rgb565.data(), blockSize, rawSize);
+    });
+  }
+
+  Inky& inky_;
+  PhotoPipeline& pipeline_;
+  std::ostream& out_;
+  ImageView<IndexedColor>& display_;
+  LabDiffusionBuffer labError_;
+  LumaDiffusionBuffer lumaError_;
+  std::string filter_;
+  int width_ = 0;
+  int height_ = 0;
+  int stages_ = 0;
+  int failures_ = 0;
+  // Set by a stage's run when its decode fails
+  bool failed_ = false;
+};
@@ -0,0 +1,647 @@
+#pragma once
+
+#include <stdint.h>
+
+// The JPEG the bench command decodes: benchPattern() (Bench.hpp) at
+// 320x240, encoded the way the camera's captures are (4:2:0, quality 75,
+// a restart marker every MCU row). Being const it stays in flash, and is
+// decoded from there. It must never change, or bench results stop being
+// comparable between builds.
+inline constexpr uint8_t BenchSampleJpeg[] =
+{
+  0xff, 0xd8, 0xff, 0xe0, 0x00, 0x10, 0x4a, 0x46, 0x49, 0x46, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01,
+  0x00, 0x01, 0x00, 0x00, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x08, 0x06, 0x06, 0x07, 0x06, 0x05, 0x08,
+  0x07, 0x07, 0x07, 0x09, 0x09, 0x08, 0x0a, 0x0c, 0x14, 0x0d, 0x0c, 0x0b, 0x0b, 0x0c, 0x19, 0x12,
+  0x13, 0x0f, 0x14, 0x1d, 0x1a, 0x1f, 0x1e, 0x1d, 0x1a, 0x1c, 0x1c, 0x20, 0x24, 0x2e, 0x27, 0x20,
+  0x22, 0x2c, 0x23, 0x1c, 0x1c, 0x28, 0x37, 0x29, 0x2c, 0x30, 0x31, 0x34, 0x34, 0x34, 0x1f, 0x27,
+  0x39, 0x3d, 0x38, 0x32, 0x3c, 0x2e, 0x33, 0x34, 0x32, 0xff, 0xdb, 0x00, 0x43, 0x01, 0x09, 0x09,
+  0x09, 0x0c, 0x0b, 0x0c, 0x18, 0x0d, 0x0d, 0x18, 0x32, 0x21, 0x1c, 0x21, 0x32, 0x32, 0x32, 0x32,
+  0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+  0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32,
+  0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0x32, 0xff, 0xc0,
+  0x00, 0x11, 0x08, 0x00, 0xf0, 0x01, 0x40, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11,
+  0x01, 0xff, 0xc4, 0x00, 0x1f, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+  0x0a, 0x0b, 0xff, 0xc4, 0x00, 0xb5, 0x10, 0x00, 0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05,
+  0x05, 0x04, 0x04, 0x00, 0x00, 0x01, 0x7d, 0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21,
+  0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23,
+  0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17,
+  0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a,
+  0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a,
+  0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a,
+  0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+  0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7,
+  0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5,
+  0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1,
+  0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xff, 0xc4, 0x00, 0x1f, 0x01, 0x00, 0x03,
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+  0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0xb5, 0x11, 0x00,
+  0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00, 0x01, 0x02, 0x77, 0x00,
+  0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13,
+  0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15,
+  0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26, 0x27,
+  0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+  0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+  0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88,
+  0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6,
+  0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4,
+  0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe2,
+  0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9,
+  0xfa, 0xff, 0xdd, 0x00, 0x04, 0x00, 0x14, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11,
+  0x03, 0x11, 0x00, 0x3f, 0x00, 0xf1, 0xf0, 0x31, 0x8c, 0x02, 0x4d, 0x40, 0x46, 0x39, 0xfd, 0x29,
+  0x70, 0x71, 0xf4, 0xf4, 0xab, 0x62, 0x30, 0x0e, 0x31, 0xc7, 0x7a, 0xfd, 0x79, 0xcb, 0xeb, 0x3e,
+  0x56, 0x3c, 0xf4, 0xf9, 0x46, 0xe3, 0xaf, 0xa0, 0xf5, 0xaa, 0xd9, 0xf9, 0x73, 0x4e, 0x0b, 0xf3,
+  0x64, 0x67, 0xeb, 0x57, 0x0a, 0x00, 0x33, 0x9e, 0x47, 0xe3, 0x59, 0x39, 0x7d, 0x67, 0xca, 0xc6,
+  0xa9, 0xd8, 0x8c, 0x60, 0x75, 0x35, 0x06, 0x30, 0x39, 0xe3, 0xf1, 0xa7, 0x6c, 0x3c, 0xf1, 0xdf,
+  0x1d, 0x6a, 0xea, 0xa9, 0xe3, 0x23, 0xbf, 0x03, 0x3d, 0x2b, 0x39, 0x4b, 0xeb, 0x1e, 0x56, 0x36,
+  0x4c, 0x8f, 0x19, 0x27, 0xd7, 0xd0, 0xd5, 0x7f, 0x4c, 0xf5, 0xf6, 0xed, 0x4a, 0x17, 0x76, 0x31,
+  0xce, 0x7a, 0xe2, 0xae, 0x95, 0xce, 0x3a, 0x9a, 0xca, 0x52, 0xfa, 0xc7, 0x95, 0x8d, 0x53, 0x19,
+  0xdf, 0x1f, 0xa5, 0x56, 0xef, 0xc1, 0x19, 0xf6, 0xa0, 0x2e, 0x31, 0x9c, 0xff, 0x00, 0x4c, 0xd5,
+  0xed, 0xbd, 0x47, 0x6f, 0xa5, 0x66, 0xe5, 0xed, 0xfc, 0xac, 0x6c, 0x9d, 0xc6, 0xe0, 0x93, 0xd3,
+  0xd3, 0x8a, 0xab, 0x8c, 0x11, 0xce, 0x29, 0x40, 0x3e, 0x87, 0xd8, 0xd5, 0xe0, 0x39, 0xc9, 0x3c,
+  0x8a, 0xc9, 0xcb, 0xdb, 0xf9, 0x58, 0xd5, 0x3b, 0x8d, 0x03, 0xb9, 0x1d, 0x78, 0xe2, 0xaa, 0xe3,
+  0x8f, 0x6e, 0xfd, 0xa9, 0x40, 0xc9, 0x3c, 0x72, 0x39, 0xc1, 0xad, 0x05, 0x03, 0x3c, 0x0e, 0xf5,
+  0x9b, 0x97, 0xb6, 0xf2, 0xb1, 0xaa, 0x7c, 0xc3, 0x02, 0xf5, 0x3d, 0x06, 0x33, 0xcf, 0x15, 0x48,
+  0x64, 0x03, 0xea, 0x29, 0x42, 0x9c, 0xfd, 0x6b, 0x48, 0x21, 0x07, 0xae, 0x73, 0xc6, 0x7a, 0xd6,
+  0x4e, 0x5e, 0xdb, 0xca, 0xc6, 0xc9, 0xf3, 0x0c, 0xc6, 0x31, 0xcf, 0x4a, 0xa3, 0xcf, 0x39, 0xfe,
+  0x74, 0xec, 0x63, 0x90, 0x32, 0x31, 0x5a, 0x00, 0x00, 0x71, 0xfc, 0xeb, 0x39, 0x4b, 0xdb, 0x79,
+  0x58, 0xd5, 0x3e, 0x71, 0xbb, 0x76, 0x92, 0xbd, 0xea, 0x91, 0x04, 0x1c, 0xe3, 0xaf, 0xb5, 0x2f,
+  0x1e, 0x87, 0x93, 0x9c, 0xd6, 0x96, 0x33, 0xcb, 0x56, 0x52, 0x97, 0xb5, 0xf2, 0xb1, 0xb2, 0x7c,
+  0xe3, 0x47, 0xd0, 0x75, 0xaa, 0x20, 0x75, 0x1b, 0x68, 0xc7, 0x4e, 0x32, 0x3a, 0x8c, 0x56, 0x98,
+  0x51, 0x9e, 0x9c, 0x9e, 0xb5, 0x9c, 0xa5, 0xed, 0x7c, 0xac, 0x6a, 0x9f, 0xb4, 0x18, 0x14, 0x91,
+  0xce, 0x0e, 0x7f, 0x4a, 0xa3, 0x8c, 0x8e, 0x9d, 0x3d, 0x29, 0x7b, 0x0e, 0xa3, 0xbf, 0x5a, 0xd2,
+  0x55, 0xc2, 0x81, 0x9e, 0x3d, 0x2b, 0x27, 0x2f, 0x69, 0xe4, 0x6c, 0x9f, 0xb4, 0x10, 0x01, 0x91,
+  0xdb, 0xb5, 0x67, 0xe3, 0xae, 0x69, 0x54, 0x0c, 0x73, 0x9f, 0x7a, 0xd4, 0xdb, 0xe9, 0x9e, 0x39,
+  0xac, 0xe5, 0x2f, 0x68, 0x6a, 0x9f, 0xb5, 0xf2, 0xb0, 0xd0, 0x33, 0xd3, 0x3f, 0x5a, 0xcf, 0xe9,
+  0xde, 0x85, 0xe0, 0x12, 0x45, 0x6a, 0x60, 0xb0, 0xc9, 0x27, 0xda, 0xb2, 0x72, 0xe7, 0x36, 0x4f,
+  0xda, 0xf9, 0x58, 0x68, 0x5c, 0x13, 0xc7, 0x7e, 0xf5, 0x9d, 0x81, 0x9c, 0x67, 0x3f, 0x85, 0x2e,
+  0xc2, 0x46, 0x32, 0x79, 0xad, 0x65, 0x1c, 0x73, 0xf8, 0xd6, 0x4e, 0x5c, 0xe6, 0xa9, 0xfb, 0x6f,
+  0x2b, 0x0c, 0xdb, 0xc7, 0x4a, 0xce, 0x03, 0x8c, 0x1c, 0xfd, 0x69, 0x47, 0x71, 0xc7, 0xb5, 0x6a,
+  0x80, 0x70, 0x4e, 0xde, 0x3d, 0x6b, 0x39, 0x4b, 0x98, 0xd5, 0x3f, 0x6d, 0xe5, 0x61, 0xa0, 0x60,
+  0x8f, 0xf1, 0xac, 0xdc, 0x74, 0xcd, 0x2f, 0x1d, 0xc7, 0x02, 0xb5, 0x82, 0x02, 0x79, 0xe0, 0x76,
+  0xe2, 0xb3, 0x72, 0xe6, 0x36, 0x4f, 0xdb, 0xf9, 0x58, 0x66, 0x0e, 0x71, 0x8f, 0xc4, 0x56, 0x6e,
+  0x3b, 0xd2, 0xed, 0xc1, 0x24, 0x7e, 0x15, 0xae, 0xa3, 0x9e, 0x38, 0xed, 0x59, 0x39, 0x73, 0x1a,
+  0xa7, 0xed, 0xfc, 0xac, 0x26, 0x33, 0xc9, 0xe0, 0x56, 0x5f, 0x24, 0x7c, 0xdc, 0x71, 0x46, 0x00,
+  0xe0, 0x7d, 0xee, 0x7a, 0x0a, 0xd8, 0x0b, 0xce, 0x71, 0x8f, 0xa5, 0x65, 0x29, 0x5c, 0xd9, 0x3f,
+  0xac, 0x79, 0x58, 0x4c, 0x0e, 0x7a, 0x56, 0x48, 0x07, 0x18, 0xf4, 0xa5, 0x2b, 0xb7, 0xa6, 0x79,
+  0xad, 0xa0, 0x06, 0x73, 0xd3, 0x8a, 0xcd, 0xca, 0xe6, 0xa9, 0xfd, 0x63, 0xca, 0xc7, 0xff, 0xd0,
+  0xf2, 0x7d, 0xbe, 0xc6, 0xab, 0x01, 0x95, 0xc0, 0xea, 0x3d, 0xa9, 0xfb, 0x32, 0x71, 0x8e, 0x07,
+  0xa5, 0x5d, 0xd8, 0x73, 0xc0, 0xc8, 0x15, 0xfa, 0xbb, 0x97, 0xd6, 0x3c, 0xac, 0x79, 0x49, 0xf2,
+  0x91, 0x85, 0xe4, 0xfc, 0xa3, 0xa7, 0x3c, 0x55, 0x50, 0xbd, 0xff, 0x00, 0x51, 0x4e, 0x0a, 0x70,
+  0x38, 0xe4, 0x9e, 0xc6, 0xaf, 0x04, 0xf9, 0xb3, 0xb4, 0x10, 0x7a, 0x56, 0x52, 0x97, 0xd6, 0x3c,
+  0xac, 0x6a, 0x9d, 0x86, 0x00, 0x08, 0x04, 0x1f, 0xce, 0xaa, 0x6d, 0xe9, 0x85, 0xc7, 0x5c, 0x7b,
+  0xd3, 0xd4, 0x0e, 0x87, 0x07, 0xd6, 0xaf, 0x01, 0x86, 0xcf, 0xaf, 0x5a, 0xce, 0x52, 0xf6, 0xfe,
+  0x56, 0x36, 0x4e, 0xc3, 0x36, 0x36, 0x48, 0xcd, 0x53, 0x08, 0x09, 0xc0, 0x1c, 0x53, 0xca, 0xe4,
+  0x13, 0xdc, 0x77, 0x15, 0x78, 0xa7, 0xcb, 0x8d, 0xbf, 0x28, 0xef, 0x59, 0x39, 0x7b, 0x7f, 0x2b,
+  0x1a, 0xa6, 0x34, 0x20, 0x20, 0xe0, 0x71, 0xeb, 0xeb, 0x54, 0x80, 0x1c, 0x1c, 0x9c, 0x77, 0xf7,
+  0xa7, 0x01, 0xd4, 0x1e, 0x48, 0xad, 0x00, 0xa7, 0xd0, 0x60, 0x77, 0x15, 0x9c, 0xa5, 0xed, 0xfc,
+  0xac, 0x6c, 0x98, 0xdc, 0x60, 0xe7, 0xaf, 0x15, 0x44, 0x0c, 0x77, 0x04, 0xe7, 0xfc, 0xff, 0x00,
+  0x2a, 0x90, 0x8d, 0xa4, 0xf1, 0x86, 0xf5, 0x35, 0xa1, 0x8f, 0x7c, 0xe3, 0xa8, 0xc5, 0x65, 0x29,
+  0x7b, 0x6f, 0x2b, 0x1a, 0xa7, 0x71, 0xa8, 0xbd, 0x3e, 0x5c, 0x7f, 0x5a, 0xcf, 0x0b, 0x86, 0xe4,
+  0x81, 0xeb, 0xfe, 0x7f, 0x0a, 0x7e, 0xde, 0x47, 0x19, 0x07, 0xdf, 0xad, 0x69, 0x05, 0xcf, 0x1c,
+  0x92, 0x3d, 0xb8, 0xac, 0xdc, 0xbd, 0xb7, 0x95, 0x8d, 0x53, 0xb8, 0xce, 0x72, 0x47, 0x1c, 0xfa,
+  0x7f, 0x4a, 0xa0, 0x33, 0xb7, 0x00, 0x02, 0x33, 0xc9, 0xa7, 0xe3, 0x68, 0x3d, 0x47, 0xa7, 0x6a,
+  0xd1, 0x2b, 0x8e, 0x07, 0x4e, 0xbd, 0x6b, 0x29, 0x4b, 0xda, 0xf9, 0x58, 0xd9, 0x3e, 0x61, 0xa1,
+  0x70, 0x73, 0x9f, 0xa9, 0xac, 0xf0, 0x38, 0x18, 0x50, 0x07, 0x51, 0x4f, 0x23, 0x1c, 0x9f, 0x5e,
+  0x6b, 0x48, 0xa1, 0xee, 0x3b, 0x73, 0x8a, 0xce, 0x52, 0xf6, 0xbe, 0x56, 0x35, 0x4f, 0x98, 0x40,
+  0xa4, 0x67, 0x03, 0xb7, 0xe7, 0x59, 0xa5, 0x47, 0x6e, 0x94, 0xf0, 0xbd, 0xb0, 0x41, 0xc7, 0xad,
+  0x6a, 0x04, 0xc9, 0xc1, 0xfe, 0x55, 0x93, 0x97, 0xb4, 0xf2, 0xb1, 0xb2, 0x7c, 0xe3, 0x02, 0x7a,
+  0x75, 0xcf, 0x7a, 0xcd, 0xda, 0x78, 0x38, 0xe6, 0xa4, 0x0a, 0x33, 0xf9, 0xd6, 0xa2, 0xae, 0x38,
+  0xc0, 0xeb, 0xc1, 0x35, 0x9c, 0xa5, 0xed, 0x0d, 0x53, 0xe7, 0x18, 0x14, 0xe4, 0xf7, 0x6a, 0xcd,
+  0x28, 0x72, 0x7d, 0x29, 0xe1, 0x54, 0x82, 0x07, 0x53, 0xdb, 0xd6, 0xb5, 0x71, 0xc6, 0x7b, 0x7f,
+  0x3a, 0xca, 0x52, 0xf6, 0x86, 0xc9, 0xfb, 0x41, 0x8a, 0x32, 0x30, 0x01, 0x3c, 0xd6, 0x60, 0x53,
+  0xf4, 0xed, 0xf5, 0xff, 0x00, 0x0a, 0x76, 0xd3, 0x85, 0x23, 0xf9, 0x56, 0xb0, 0x1c, 0x16, 0x38,
+  0xc6, 0x7a, 0xfa, 0xd6, 0x6e, 0x5c, 0xe6, 0xa9, 0xfb, 0x4f, 0x21, 0xa1, 0x08, 0x19, 0xed, 0x59,
+  0x81, 0x71, 0x9c, 0xf2, 0x7a, 0xfd, 0x29, 0xd8, 0xcf, 0x4e, 0x2b, 0x5c, 0x03, 0xdc, 0x0c, 0x0e,
+  0xb5, 0x93, 0x97, 0x39, 0xb2, 0x7e, 0xd7, 0xca, 0xc4, 0x7c, 0x7a, 0x9f, 0xa9, 0xac, 0xc5, 0x5e,
+  0x47, 0x39, 0xc0, 0xf4, 0xed, 0x4e, 0xc0, 0xe0, 0xe3, 0x81, 0xfe, 0x15, 0xaf, 0xb7, 0x3c, 0x63,
+  0x3f, 0x5a, 0xca, 0x52, 0xe6, 0x35, 0x4f, 0xda, 0xf9, 0x58, 0x69, 0x07, 0xa9, 0xcf, 0xae, 0x6b,
+  0x2f, 0x6f, 0x24, 0x6d, 0xe7, 0xaf, 0xa5, 0x3b, 0x6e, 0x72, 0x7f, 0x21, 0x5b, 0x01, 0x07, 0x04,
+  0x7e, 0x63, 0xbf, 0xe3, 0x59, 0xb9, 0x73, 0x1a, 0xc5, 0xfb, 0x6f, 0x2b, 0x0d, 0x0a, 0x70, 0x06,
+  0x78, 0x1e, 0x95, 0x91, 0x8c, 0x90, 0x78, 0xfc, 0xa9, 0xe3, 0x80, 0x38, 0x15, 0xb2, 0x13, 0xa6,
+  0x07, 0x5f, 0x53, 0x59, 0x39, 0x5c, 0xd9, 0x3f, 0x6d, 0xe5, 0x61, 0x9b, 0x7d, 0x7e, 0xa2, 0xb2,
+  0x0a, 0x93, 0xd4, 0x72, 0x4e, 0x3a, 0xd3, 0xb6, 0x9e, 0xe3, 0xbe, 0x05, 0x6e, 0x04, 0x3c, 0xf1,
+  0x8e, 0xf9, 0xcd, 0x67, 0x29, 0x5c, 0xd5, 0x3f, 0x6f, 0xe5, 0x62, 0x30, 0x9f, 0x36, 0x39, 0xc6,
+  0x3d, 0x2b, 0x1f, 0x07, 0x1c, 0x1e, 0xbf, 0x85, 0x48, 0x17, 0x8e, 0x00, 0xe3, 0x91, 0x8a, 0xd9,
+  0x2b, 0xf3, 0x0e, 0x46, 0x7e, 0x9c, 0x9a, 0xca, 0x52, 0x36, 0x4f, 0xdb, 0xf9, 0x58, 0x6e, 0x39,
+  0xc6, 0xde, 0xfd, 0xf9, 0x15, 0x8f, 0x83, 0xdb, 0x9e, 0xd8, 0xa7, 0x00, 0x70, 0x71, 0xd0, 0xfa,
+  0xd6, 0xe0, 0x5e, 0x79, 0x39, 0x1f, 0x5a, 0xcd, 0xc8, 0xd5, 0x3f, 0xac, 0x79, 0x58, 0xff, 0xd1,
+  0xf3, 0x1d, 0xa3, 0xaf, 0x4f, 0xa7, 0x35, 0x53, 0xa1, 0x27, 0x23, 0x06, 0x9c, 0xa3, 0x04, 0x12,
+  0x0f, 0x35, 0x7f, 0x69, 0x65, 0xce, 0x3a, 0xf1, 0x81, 0x5f, 0xa7, 0xb9, 0x7d, 0x63, 0xca, 0xc7,
+  0x8a, 0x9f, 0x20, 0xcc, 0x77, 0xe9, 0xf8, 0xd5, 0x10, 0xbf, 0x37, 0x51, 0xc5, 0x48, 0x06, 0x38,
+  0x23, 0x38, 0xab, 0xfb, 0x3d, 0x71, 0x8e, 0x99, 0xcd, 0x66, 0xe5, 0xed, 0xfc, 0xac, 0x6a, 0x9f,
+  0x28, 0xdd, 0xb8, 0x03, 0xa0, 0x3f, 0xca, 0xa8, 0xed, 0x1b, 0xba, 0xf3, 0xcd, 0x3f, 0x1f, 0x2e,
+  0x0f, 0x53, 0xd6, 0xb4, 0x08, 0xc9, 0xfa, 0xf6, 0xac, 0xdc, 0xbd, 0xbf, 0x95, 0x8d, 0x93, 0xe5,
+  0x18, 0x14, 0xff, 0x00, 0x9e, 0xfe, 0xf5, 0x47, 0x1f, 0xc5, 0x9e, 0xbd, 0x3d, 0xa9, 0xd8, 0xe7,
+  0xa1, 0x19, 0xf4, 0x35, 0xa3, 0xb7, 0x8f, 0xe7, 0xed, 0x59, 0x4a, 0x5e, 0xdb, 0xca, 0xc6, 0xa9,
+  0xd8, 0x4c, 0x67, 0x20, 0x1c, 0xfa, 0x66, 0xa8, 0x60, 0xa8, 0xfe, 0x63, 0x14, 0xaa, 0xbc, 0x0e,
+  0x40, 0x20, 0xf3, 0x5a, 0x65, 0x7d, 0x30, 0x7b, 0x83, 0x59, 0x4a, 0x5e, 0xdb, 0xca, 0xc6, 0xa9,
+  0x8c, 0x0b, 0x80, 0x7a, 0x67, 0xa0, 0xaa, 0x21, 0x0f, 0x7a, 0x14, 0x64, 0xf4, 0xc8, 0xf4, 0xc5,
+  0x6a, 0x04, 0xcd, 0x66, 0xe5, 0xed, 0xbc, 0xac, 0x6c, 0x98, 0xcd, 0xbb, 0x46, 0x79, 0xaa, 0x01,
+  0x46, 0x39, 0xce, 0x0f, 0x6a, 0x5d, 0x9f, 0x36, 0xd2, 0x00, 0xf4, 0xad, 0x40, 0xbb, 0x81, 0xdf,
+  0xc7, 0xf3, 0x35, 0x94, 0xa5, 0xed, 0x7c, 0xac, 0x6a, 0x9d, 0xc6, 0x85, 0x50, 0x0f, 0x71, 0xda,
+  0xb3, 0x42, 0x12, 0x79, 0xe4, 0x53, 0xb9, 0x1c, 0x7e, 0x47, 0x38, 0xad, 0x5d, 0xa0, 0xe3, 0xbf,
+  0x6c, 0x71, 0x59, 0xca, 0x5e, 0xd7, 0xca, 0xc6, 0xc9, 0xdc, 0x66, 0xcc, 0x0e, 0x0f, 0xe5, 0x59,
+  0xa4, 0x64, 0xf4, 0xcf, 0xd0, 0xd3, 0xc0, 0xc0, 0x18, 0xc0, 0xad, 0x5d, 0xa7, 0x9c, 0x72, 0x2b,
+  0x27, 0x2f, 0x68, 0x6a, 0x9f, 0x30, 0xc5, 0x41, 0xdb, 0xa7, 0x1d, 0x6b, 0x37, 0x1d, 0xb0, 0x79,
+  0xe6, 0x9d, 0xb7, 0x03, 0xa7, 0xff, 0x00, 0xaa, 0xb5, 0xc2, 0x67, 0x39, 0xc0, 0x3e, 0x86, 0xb3,
+  0x94, 0xbd, 0xa1, 0xb2, 0x7c, 0xc4, 0x7b, 0x78, 0x3c, 0x70, 0x7d, 0x7b, 0x56, 0x68, 0x03, 0x1c,
+  0xfe, 0xa7, 0xad, 0x28, 0x1d, 0x08, 0xc6, 0x4f, 0x5a, 0xd7, 0x09, 0xc1, 0x38, 0x5a, 0xc9, 0xcb,
+  0x9c, 0xd5, 0x3e, 0x71, 0xb8, 0xe0, 0x8c, 0x9f, 0xa5, 0x65, 0x1e, 0x17, 0x07, 0xa6, 0x79, 0xa7,
+  0x15, 0xc9, 0xc7, 0x1c, 0x0c, 0x56, 0xc0, 0x5f, 0x4f, 0xca, 0xb3, 0x94, 0xb9, 0xcd, 0x93, 0xe7,
+  0x19, 0x8e, 0x00, 0xea, 0x31, 0xcd, 0x65, 0x05, 0x18, 0xff, 0x00, 0x1e, 0xf4, 0xe5, 0x1b, 0x8e,
+  0x48, 0xeb, 0x5b, 0x21, 0x7b, 0x60, 0xe7, 0xd4, 0x56, 0x52, 0x97, 0x31, 0xaa, 0x7e, 0xd0, 0x6a,
+  0xa9, 0xfb, 0xb9, 0x35, 0x92, 0x00, 0x4f, 0x4c, 0x71, 0x4e, 0x51, 0x91, 0xd3, 0x1d, 0xf1, 0x5b,
+  0x25, 0x39, 0xce, 0x39, 0xc7, 0x7a, 0xce, 0x52, 0xe6, 0x35, 0x4f, 0xda, 0x7c, 0x86, 0xed, 0xed,
+  0x59, 0x18, 0xfc, 0x4a, 0xfb, 0x52, 0x82, 0x47, 0xa6, 0x0f, 0xe1, 0x5b, 0x7b, 0x73, 0xef, 0xd6,
+  0xb2, 0x72, 0xe6, 0x36, 0x4f, 0xda, 0xf9, 0x58, 0x62, 0x27, 0x6e, 0x33, 0x59, 0x23, 0x04, 0xf1,
+  0xcf, 0xa9, 0x14, 0xed, 0xa0, 0xe4, 0x74, 0x24, 0x67, 0x1d, 0xab, 0x65, 0x46, 0x4e, 0x48, 0xfd,
+  0x3b, 0xfa, 0xd6, 0x72, 0x95, 0xcd, 0x53, 0xf6, 0xbe, 0x56, 0x18, 0x17, 0x1e, 0x80, 0x03, 0xe9,
+  0x8c, 0xd6, 0x4e, 0xcc, 0x10, 0x7d, 0x3b, 0x9a, 0x55, 0x03, 0x68, 0xe4, 0x03, 0x5b, 0x7b, 0x70,
+  0xa7, 0x03, 0xa7, 0x3d, 0x33, 0x59, 0x4a, 0x57, 0x36, 0x4f, 0xdb, 0x79, 0x58, 0x6e, 0xdd, 0xa7,
+  0x03, 0xf4, 0xac, 0x6d, 0xb9, 0x53, 0x85, 0x14, 0xfd, 0xbc, 0x0c, 0x2e, 0x07, 0xa5, 0x6e, 0x28,
+  0x27, 0xeb, 0xd2, 0xb3, 0x94, 0x8d, 0x53, 0xf6, 0xde, 0x56, 0x1a, 0xa9, 0xb7, 0x92, 0x47, 0x35,
+  0x8b, 0x81, 0xb4, 0x11, 0x8a, 0x76, 0xdc, 0xf4, 0x3f, 0x8f, 0xf9, 0xfc, 0x2b, 0x74, 0x06, 0xc7,
+  0x23, 0x27, 0xde, 0xb2, 0x72, 0x36, 0x4f, 0xdb, 0xf9, 0x58, 0x66, 0x33, 0xce, 0x0e, 0x41, 0xc6,
+  0x2b, 0x18, 0x2e, 0x70, 0x48, 0xeb, 0x4e, 0x0a, 0x77, 0x0f, 0x97, 0x82, 0x7b, 0x7b, 0xd6, 0xe6,
+  0xc6, 0xe3, 0x07, 0x03, 0x15, 0x9b, 0x95, 0x8d, 0x53, 0xf6, 0xfe, 0x56, 0x3f, 0xff, 0xd2, 0xf3,
+  0x9d, 0x9d, 0x87, 0xe1, 0x54, 0xf1, 0x8e, 0x73, 0x9c, 0x77, 0xa5, 0x03, 0x04, 0xfa, 0x7d, 0x2b,
+  0x48, 0x29, 0x00, 0xf5, 0xe2, 0xbf, 0x48, 0x72, 0xf6, 0xfe, 0x56, 0x3c, 0x04, 0xf9, 0x06, 0x6d,
+  0xc7, 0x20, 0x64, 0x9e, 0x6a, 0x88, 0x1d, 0x81, 0x02, 0x97, 0x6f, 0x7c, 0x8a, 0xd1, 0x51, 0xfd,
+  0xe3, 0x8a, 0xcd, 0xcb, 0xdb, 0xf9, 0x58, 0xd5, 0x3e, 0x51, 0xa1, 0x4a, 0xaf, 0x4f, 0xae, 0x47,
+  0x15, 0x43, 0x00, 0x03, 0x9f, 0xa9, 0xcf, 0x7a, 0x70, 0x0d, 0xd3, 0xd7, 0xad, 0x69, 0x80, 0x49,
+  0x19, 0xe7, 0x1d, 0xbd, 0x2b, 0x29, 0x4b, 0xdb, 0x79, 0x58, 0xd9, 0x3e, 0x51, 0x9b, 0x79, 0x3e,
+  0x86, 0xb3, 0xf1, 0xc9, 0xce, 0x7e, 0x9e, 0x94, 0xe0, 0xa7, 0x1d, 0xc6, 0x6b, 0x50, 0x8f, 0xa6,
+  0x4d, 0x66, 0xe5, 0xed, 0xbc, 0xac, 0x6a, 0x9d, 0x86, 0x85, 0x19, 0xce, 0x41, 0x22, 0xb3, 0x47,
+  0x3c, 0x13, 0xc1, 0xf5, 0xa7, 0xed, 0x1c, 0x93, 0xc9, 0xef, 0x9e, 0x95, 0xab, 0xb4, 0x73, 0x8c,
+  0xd6, 0x52, 0x97, 0xb5, 0xf2, 0xb1, 0xaa, 0x76, 0x19, 0xb0, 0xe4, 0x00, 0x39, 0x3d, 0xeb, 0x30,
+  0x28, 0x2d, 0xd7, 0x9e, 0x78, 0xa7, 0x00, 0x77, 0x0c, 0xe7, 0x1d, 0x2b, 0x63, 0x66, 0x32, 0x07,
+  0xd7, 0x19, 0xef, 0x59, 0xca, 0x5e, 0xd7, 0xca, 0xc6, 0xc9, 0x91, 0x10, 0x3d, 0x06, 0x3b, 0x91,
+  0x59, 0x9d, 0x4e, 0x0f, 0x38, 0x1d, 0x6a, 0x40, 0x9d, 0x78, 0xc5, 0x6a, 0xe3, 0x1e, 0xb8, 0xf7,
+  0xef, 0x59, 0x4a, 0x5e, 0xd3, 0xca, 0xc6, 0xa9, 0x91, 0xa8, 0xe7, 0xbe, 0x3e, 0xb5, 0x98, 0x54,
+  0x60, 0xe7, 0x3c, 0x7f, 0x2a, 0x93, 0x66, 0x17, 0xeb, 0x5a, 0xe1, 0x39, 0x3c, 0x91, 0xf8, 0xf5,
+  0xac, 0xdc, 0xbd, 0xa1, 0xb2, 0x77, 0x23, 0xdb, 0xf3, 0x60, 0xe7, 0x9f, 0x7e, 0x95, 0x98, 0x3e,
+  0x53, 0xd3, 0x03, 0xd4, 0x52, 0x8c, 0xe3, 0x1d, 0x7d, 0xb1, 0x5b, 0x25, 0x30, 0x79, 0x1c, 0xfd,
+  0x7a, 0xd6, 0x52, 0x97, 0xb4, 0x35, 0x4e, 0xe3, 0x36, 0x6d, 0xec, 0x39, 0xe2, 0xb2, 0xc2, 0xb0,
+  0xf5, 0xcd, 0x29, 0x18, 0x03, 0x23, 0x1f, 0x85, 0x6c, 0x05, 0xec, 0x3b, 0xfb, 0xd6, 0x72, 0x97,
+  0x39, 0xb2, 0x7c, 0xc3, 0x15, 0x79, 0x18, 0xef, 0xe8, 0x2b, 0x2b, 0x18, 0x3f, 0x74, 0x63, 0xb6,
+  0x05, 0x3c, 0x2e, 0x1b, 0x1d, 0xb0, 0x05, 0x6c, 0x80, 0x70, 0x4a, 0x8e, 0x6b, 0x27, 0x2e, 0x73,
+  0x54, 0xf9, 0x88, 0xf6, 0xa8, 0x23, 0x8c, 0x7a, 0x56, 0x56, 0x38, 0x04, 0x9c, 0x11, 0x90, 0x69,
+  0x71, 0x93, 0xe8, 0x4d, 0x6d, 0x15, 0xce, 0x4f, 0x6f, 0x50, 0x2b, 0x39, 0x4b, 0x98, 0xd9, 0x3e,
+  0x71, 0x81, 0x72, 0x70, 0x47, 0x7c, 0xd6, 0x4e, 0xd3, 0xdc, 0x13, 0x4e, 0xc6, 0x00, 0x24, 0xd6,
+  0xd0, 0x1f, 0x37, 0x6c, 0x9f, 0x4a, 0xca, 0x52, 0xe6, 0x35, 0x4f, 0x9c, 0x66, 0xdc, 0x1c, 0x37,
+  0x3c, 0xff, 0x00, 0x5a, 0xc7, 0xd8, 0x7a, 0x63, 0xd7, 0x34, 0xf0, 0x0e, 0x31, 0xeb, 0xe9, 0x5b,
+  0x61, 0x46, 0x7a, 0x74, 0xfd, 0x6b, 0x29, 0x4a, 0xe6, 0xa9, 0xfb, 0x41, 0x8a, 0x38, 0xc0, 0x19,
+  0x1e, 0xb5, 0x90, 0x3d, 0xbf, 0x3a, 0x50, 0x01, 0xc9, 0xfc, 0xbb, 0xd6, 0xe0, 0x5c, 0x81, 0xd8,
+  0x8a, 0xce, 0x52, 0xb9, 0xb2, 0x7e, 0xd3, 0xca, 0xc3, 0x00, 0x03, 0xaf, 0x4c, 0xf4, 0xac, 0x60,
+  0x3a, 0x00, 0x73, 0xf5, 0xa7, 0x28, 0xc1, 0xe4, 0x81, 0xc5, 0x6f, 0x04, 0xe7, 0xa7, 0x1c, 0x60,
+  0x56, 0x52, 0x91, 0xaa, 0x7e, 0xd7, 0xca, 0xc4, 0x7b, 0x73, 0x90, 0x7a, 0x0a, 0xc4, 0x0b, 0x93,
+  0x8f, 0x4f, 0x6c, 0x54, 0x80, 0x72, 0x7f, 0x2e, 0x38, 0xad, 0xe0, 0xb9, 0x5c, 0x77, 0x3c, 0x71,
+  0xe9, 0x59, 0xb9, 0x1b, 0x27, 0xed, 0x7c, 0xac, 0x30, 0x02, 0x78, 0xcd, 0x61, 0xb0, 0xe3, 0x38,
+  0xe7, 0x3c, 0xf1, 0x4e, 0xdb, 0xc9, 0x19, 0xe6, 0xb7, 0xf1, 0x95, 0x27, 0xd6, 0xb2, 0x72, 0x35,
+  0x4f, 0xdb, 0x79, 0x58, 0x66, 0x30, 0x49, 0xfe, 0x75, 0x8a, 0x07, 0xe4, 0x78, 0xeb, 0x4b, 0xb4,
+  0x80, 0x06, 0x78, 0x06, 0xba, 0x00, 0x3e, 0xee, 0x47, 0x1e, 0xd5, 0x9c, 0xa5, 0x63, 0x64, 0xfd,
+  0xb7, 0x95, 0x88, 0xc0, 0x38, 0xe4, 0x7b, 0x9a, 0xc4, 0x03, 0xbf, 0x41, 0xd3, 0x9a, 0x77, 0x04,
+  0x74, 0xad, 0xf5, 0x1c, 0x8c, 0x1c, 0x71, 0xc0, 0xac, 0x9c, 0xac, 0x6a, 0x9f, 0xb7, 0xf2, 0xb1,
+  0xff, 0xd3, 0xe0, 0xf0, 0x0f, 0x1e, 0x95, 0x9c, 0x10, 0x64, 0x64, 0x9f, 0xca, 0x9f, 0x80, 0x71,
+  0xc0, 0xfc, 0xeb, 0x4c, 0x76, 0xe3, 0xdc, 0xd7, 0xe8, 0x2e, 0x5e, 0xdb, 0xca, 0xc7, 0xcd, 0xa7,
+  0xec, 0xc4, 0x00, 0x01, 0x8e, 0xc0, 0xfa, 0xd6, 0x6f, 0x4c, 0x75, 0xfc, 0x29, 0xdb, 0x46, 0x79,
+  0x3d, 0x0f, 0x1d, 0xeb, 0x53, 0x00, 0x1e, 0x3f, 0x97, 0x4a, 0xce, 0x52, 0xf6, 0xde, 0x56, 0x35,
+  0x4f, 0x90, 0x6e, 0xc2, 0x38, 0xe0, 0xe6, 0xb3, 0x76, 0xe7, 0x27, 0x93, 0xda, 0x9c, 0x54, 0x82,
+  0x48, 0x1d, 0x05, 0x6b, 0x6d, 0xee, 0x79, 0xf7, 0xac, 0xa5, 0x2f, 0x6b, 0xe5, 0x63, 0x54, 0xf9,
+  0x46, 0x15, 0xea, 0x49, 0xe7, 0xf9, 0x56, 0x62, 0x82, 0x07, 0x7f, 0x5a, 0x76, 0x30, 0x46, 0x7b,
+  0x74, 0xad, 0x80, 0xa7, 0x39, 0x1c, 0xf6, 0xc5, 0x66, 0xe5, 0xed, 0x7c, 0xac, 0x6c, 0x9f, 0x29,
+  0x19, 0x5f, 0x5e, 0xe6, 0xb2, 0xf1, 0x9f, 0x5c, 0x7b, 0xd3, 0x82, 0xed, 0xfb, 0xd9, 0xf7, 0xf7,
+  0xad, 0x7d, 0x99, 0x39, 0x38, 0xc7, 0xad, 0x65, 0x29, 0x7b, 0x5f, 0x2b, 0x1a, 0xa7, 0x61, 0xa0,
+  0x6d, 0xf4, 0xc7, 0x7a, 0xca, 0xda, 0x09, 0xc6, 0xdc, 0x8e, 0xc2, 0x9e, 0x00, 0xcf, 0x4f, 0x7e,
+  0x6b, 0x5c, 0x00, 0x4f, 0xf4, 0xf5, 0xac, 0x9c, 0xbd, 0xa1, 0xb2, 0x76, 0x18, 0x40, 0xc6, 0xdf,
+  0x4e, 0xa6, 0xb3, 0x0a, 0xf2, 0x49, 0xf4, 0xa5, 0x00, 0x01, 0xc1, 0x1c, 0x1e, 0x95, 0xb2, 0x14,
+  0x03, 0xc7, 0x7a, 0xcd, 0xcb, 0xda, 0x1a, 0xa6, 0x33, 0x1c, 0xfd, 0xd3, 0xc7, 0x5c, 0x7a, 0xd6,
+  0x4e, 0x39, 0x1d, 0xe9, 0xe0, 0x63, 0x92, 0x72, 0x2b, 0x60, 0x27, 0x38, 0x3c, 0x8e, 0xbb, 0x4d,
+  0x65, 0x29, 0x73, 0x9b, 0x26, 0x34, 0x2e, 0x00, 0x27, 0x81, 0xd7, 0x3d, 0x6b, 0x1b, 0x66, 0x30,
+  0x7b, 0x13, 0xd4, 0xd4, 0xbb, 0x73, 0x82, 0x0e, 0xe0, 0x4e, 0x71, 0x5b, 0x41, 0x48, 0x3f, 0xca,
+  0xb3, 0x94, 0xb9, 0xcd, 0x53, 0xb8, 0xc5, 0x19, 0x1b, 0x4f, 0xe9, 0x59, 0x1c, 0x67, 0xd7, 0x1e,
+  0xb4, 0xbe, 0x5e, 0x13, 0xa6, 0x6b, 0x73, 0x6f, 0x38, 0xcf, 0x1e, 0xbf, 0xe7, 0xe9, 0x59, 0x4a,
+  0x5c, 0xc6, 0xc9, 0xdc, 0x8c, 0x29, 0x1f, 0x36, 0x3f, 0x13, 0x59, 0x18, 0x1b, 0x71, 0x8e, 0x4d,
+  0x3f, 0x00, 0xe7, 0x19, 0x3d, 0x7b, 0xd6, 0xde, 0xde, 0x33, 0x81, 0x9c, 0xf1, 0x59, 0xb9, 0x73,
+  0x1a, 0xa7, 0xcc, 0x33, 0x69, 0x2b, 0x58, 0xd8, 0xc0, 0xcf, 0x60, 0x29, 0xe0, 0x0e, 0x38, 0xfc,
+  0x2b, 0x6c, 0x2f, 0x3d, 0x8f, 0xa1, 0xac, 0xa5, 0x2b, 0x9a, 0xa7, 0xcc, 0x33, 0x60, 0xe7, 0xdf,
+  0xf9, 0x56, 0x38, 0x5c, 0x8e, 0x29, 0xc1, 0x73, 0xec, 0x33, 0xd6, 0xb7, 0x48, 0x18, 0x3b, 0x8f,
+  0x5a, 0xce, 0x52, 0xb9, 0xb2, 0x7c, 0xe4, 0x6b, 0xf2, 0xf0, 0x01, 0xf5, 0xac, 0x6e, 0x00, 0x38,
+  0x19, 0x1d, 0x69, 0x40, 0x24, 0x74, 0x38, 0xf6, 0x15, 0xba, 0x17, 0xd0, 0x1f, 0xa5, 0x65, 0x29,
+  0x5c, 0xd5, 0x3e, 0x71, 0xa1, 0x72, 0x00, 0x39, 0xf6, 0xac, 0x50, 0xb9, 0x19, 0xfd, 0x3d, 0x69,
+  0xc1, 0x3e, 0xbc, 0xd6, 0xfa, 0xaf, 0x4c, 0x67, 0xaf, 0xe5, 0x59, 0xca, 0x46, 0xc9, 0xfb, 0x42,
+  0x36, 0xc7, 0x03, 0x1c, 0x0e, 0xa2, 0xb1, 0x00, 0xed, 0x8e, 0x9d, 0x85, 0x2e, 0xdc, 0xb7, 0x4e,
+  0x87, 0xad, 0x74, 0x00, 0x71, 0xfd, 0xdf, 0xa5, 0x65, 0x29, 0x1a, 0xa7, 0xed, 0x3c, 0xac, 0x33,
+  0x1f, 0x29, 0xe0, 0x7e, 0x35, 0x88, 0xa0, 0xe0, 0x0e, 0x70, 0x69, 0xd8, 0x19, 0xce, 0x31, 0xf8,
+  0x57, 0x41, 0x83, 0x8e, 0x78, 0x23, 0x9a, 0xcd, 0xca, 0xc6, 0xc9, 0xfb, 0x5f, 0x2b, 0x0c, 0x23,
+  0x3d, 0x47, 0x15, 0x84, 0x14, 0x70, 0x09, 0xe7, 0xdb, 0xb5, 0x3b, 0x03, 0x76, 0x40, 0x3c, 0x8a,
+  0xe8, 0x76, 0xfd, 0x78, 0xcf, 0x35, 0x94, 0xa5, 0x63, 0x54, 0xfd, 0xaf, 0x95, 0x88, 0xc2, 0x73,
+  0xb4, 0xff, 0x00, 0xfa, 0xeb, 0x08, 0x0c, 0xf5, 0xe0, 0x0e, 0xb4, 0xa0, 0x75, 0x1e, 0xf9, 0xae,
+  0x8c, 0x2f, 0x6c, 0x9e, 0x9f, 0xad, 0x67, 0x29, 0x72, 0x9b, 0x27, 0xed, 0xbc, 0xac, 0x30, 0x01,
+  0x8e, 0x0f, 0x15, 0x80, 0x13, 0x90, 0x31, 0xdf, 0x8a, 0x7a, 0xf2, 0x30, 0x01, 0x3e, 0xb5, 0xd1,
+  0x6d, 0xc0, 0xc7, 0x6c, 0x56, 0x4e, 0x5c, 0xa6, 0xa9, 0xfb, 0x6f, 0x2b, 0x1f, 0xff, 0xd4, 0xe3,
+  0x30, 0x07, 0xcb, 0x8a, 0xcd, 0xc0, 0x23, 0x9e, 0x9d, 0x73, 0x4e, 0xc7, 0xb0, 0xcf, 0x6a, 0xd6,
+  0x00, 0x67, 0xdb, 0xb8, 0xcd, 0x7d, 0xd3, 0x97, 0xb6, 0xf2, 0xb1, 0xf2, 0xc9, 0xfb, 0x31, 0x9b,
+  0x71, 0x83, 0xed, 0xd6, 0xb2, 0xc0, 0xe7, 0x9e, 0x99, 0xa9, 0x30, 0x46, 0x72, 0x79, 0xf7, 0xad,
+  0x52, 0xa0, 0x90, 0x76, 0xe4, 0x7a, 0x56, 0x52, 0x97, 0xb5, 0xf2, 0xb1, 0xaa, 0x7e, 0xcc, 0x6a,
+  0x8c, 0x8c, 0x30, 0x1c, 0x56, 0x66, 0x39, 0xe7, 0x18, 0xe9, 0x9a, 0x5c, 0x74, 0x3d, 0x00, 0x38,
+  0x3e, 0xd5, 0xb1, 0xb4, 0x8e, 0xe4, 0xd6, 0x72, 0x97, 0xb5, 0xf2, 0xb1, 0xaa, 0x7c, 0x83, 0x15,
+  0x72, 0xc0, 0x1c, 0x62, 0xb2, 0xb0, 0x77, 0x67, 0x6e, 0x47, 0xbf, 0x7a, 0x70, 0x19, 0x19, 0xe4,
+  0x9f, 0x4a, 0xd9, 0x0b, 0x92, 0x0f, 0x00, 0x11, 0xd3, 0xd6, 0xb2, 0x94, 0xbd, 0xa7, 0x91, 0xb2,
+  0x7c, 0xa3, 0x36, 0xfe, 0x18, 0xf6, 0xac, 0x82, 0xbb, 0xb0, 0x33, 0xec, 0x0f, 0x4c, 0xd4, 0x9c,
+  0xe4, 0x81, 0xdf, 0x8c, 0x8e, 0xb5, 0xb5, 0xb4, 0x72, 0x79, 0x07, 0xaf, 0xd6, 0xb3, 0x94, 0xbd,
+  0xa1, 0xaa, 0x7c, 0xa4, 0x61, 0x77, 0x0c, 0xf3, 0xf4, 0xac, 0x91, 0xc0, 0x00, 0xf6, 0xed, 0xeb,
+  0x4e, 0x51, 0xe9, 0xd7, 0xda, 0xb6, 0xb6, 0x92, 0x4e, 0x3a, 0x8e, 0x9c, 0xd6, 0x4e, 0x5c, 0xe6,
+  0xc9, 0xd8, 0x61, 0x1d, 0xf9, 0x03, 0xae, 0x09, 0xac, 0x7d, 0xa3, 0x81, 0x93, 0x9a, 0x7e, 0x3d,
+  0x07, 0x07, 0xb6, 0x6b, 0x68, 0x28, 0xdb, 0x59, 0xca, 0x5c, 0xe6, 0xa9, 0xd8, 0x6e, 0xd5, 0xc8,
+  0x1c, 0x75, 0xc8, 0xc5, 0x63, 0x05, 0x24, 0x7b, 0x7e, 0xb5, 0x21, 0x51, 0x90, 0x7a, 0xe7, 0x81,
+  0xd2, 0xb6, 0xc2, 0xf3, 0x81, 0xce, 0x2b, 0x29, 0x4b, 0x98, 0xd9, 0x32, 0x30, 0x38, 0xc1, 0x03,
+  0x82, 0x7b, 0x56, 0x46, 0xd1, 0xdc, 0x67, 0xb8, 0xe6, 0x9c, 0x07, 0x38, 0xc0, 0xce, 0x3a, 0xd6,
+  0xe6, 0xc0, 0x47, 0x03, 0xeb, 0xeb, 0x59, 0xb9, 0x73, 0x1a, 0xa6, 0x30, 0xa8, 0x3d, 0x38, 0xef,
+  0xd2, 0xb1, 0x31, 0xc9, 0xcf, 0x5c, 0x7a, 0xd3, 0xf0, 0x4f, 0x04, 0x0c, 0x67, 0xa1, 0xe2, 0xb7,
+  0xb1, 0x9f, 0x4c, 0x74, 0xc1, 0x35, 0x94, 0xa5, 0xcc, 0x6c, 0x9d, 0xc6, 0x60, 0x02, 0x4e, 0x00,
+  0xfa, 0xd6, 0x20, 0x41, 0x91, 0xed, 0xd3, 0x3d, 0xe9, 0xe1, 0x48, 0x3c, 0xf4, 0xf7, 0x35, 0xbd,
+  0x8c, 0x61, 0x89, 0xe3, 0xf5, 0xac, 0xe5, 0x2b, 0x9a, 0xa7, 0x71, 0x80, 0x64, 0xe7, 0xd7, 0x82,
+  0x45, 0x62, 0x15, 0xc7, 0x24, 0x0f, 0x71, 0x4e, 0x00, 0x60, 0xf1, 0x8e, 0x3a, 0x56, 0xf6, 0xd3,
+  0xc7, 0xa8, 0xf4, 0xac, 0x9c, 0xae, 0x6a, 0x9f, 0x30, 0xc5, 0x4c, 0x83, 0xfc, 0xb1, 0x58, 0xa0,
+  0x00, 0xc3, 0x8f, 0x97, 0xa5, 0x28, 0x1b, 0x7a, 0x80, 0x4e, 0x73, 0xe9, 0x5d, 0x0a, 0xae, 0x3d,
+  0xbd, 0xc7, 0x7a, 0xce, 0x52, 0x36, 0x4f, 0x98, 0x8c, 0x2e, 0x0e, 0x33, 0x9c, 0xd6, 0x10, 0xe9,
+  0xc8, 0xcf, 0x3f, 0x5a, 0x70, 0x5c, 0x8e, 0x40, 0x38, 0xfd, 0x6b, 0xa1, 0x09, 0xb8, 0x03, 0xd3,
+  0xda, 0xb2, 0x94, 0x8d, 0x53, 0xe7, 0x23, 0x41, 0xc9, 0x1c, 0x0f, 0x61, 0x58, 0x58, 0xc7, 0x4e,
+  0x39, 0xc0, 0x34, 0xf2, 0xbc, 0x9d, 0xa3, 0xaf, 0x63, 0x5d, 0x01, 0x52, 0x3d, 0x87, 0x4e, 0x2b,
+  0x37, 0x2b, 0x1b, 0x27, 0xce, 0x34, 0x2f, 0x6e, 0xc3, 0xbd, 0x60, 0xa8, 0x1d, 0x4e, 0x3a, 0xd3,
+  0x97, 0x8e, 0xbf, 0x85, 0x74, 0x41, 0x46, 0x71, 0x83, 0xec, 0x4f, 0x6a, 0xca, 0x52, 0xb1, 0xaa,
+  0x7e, 0xd0, 0x8f, 0x03, 0xaf, 0x63, 0x9c, 0x7b, 0xd6, 0x08, 0x00, 0x1e, 0x72, 0x49, 0xfc, 0xe9,
+  0xc3, 0xd8, 0x62, 0xba, 0x3d, 0xa4, 0x80, 0x3a, 0x76, 0xac, 0xa5, 0x2b, 0x1a, 0xa7, 0xed, 0x3c,
+  0xac, 0x33, 0xae, 0x46, 0x39, 0xf6, 0xef, 0x58, 0x04, 0x02, 0x33, 0x8e, 0xa3, 0x34, 0xbb, 0x72,
+  0x73, 0xf9, 0x57, 0x46, 0x10, 0x9e, 0x39, 0xc7, 0x5a, 0xce, 0x52, 0xe5, 0x36, 0x4f, 0xda, 0xf9,
+  0x58, 0x60, 0x4c, 0xfc, 0xbd, 0x7e, 0x86, 0xb0, 0x36, 0x9e, 0xbc, 0x71, 0xde, 0x9c, 0x41, 0xc9,
+  0x04, 0x71, 0xdf, 0x3e, 0x95, 0xd2, 0x85, 0x27, 0x38, 0xea, 0x3d, 0xab, 0x27, 0x2e, 0x53, 0x54,
+  0xfd, 0xaf, 0x95, 0x88, 0xc0, 0xc6, 0x7d, 0x31, 0x9e, 0x7b, 0xd7, 0x3b, 0xb5, 0xb9, 0x63, 0xc9,
+  0xa7, 0xed, 0x1f, 0xc2, 0x17, 0xf3, 0xae, 0x97, 0x68, 0x38, 0xf5, 0x3d, 0x78, 0xac, 0xdc, 0xb9,
+  0x0d, 0x93, 0xf6, 0xde, 0x56, 0x3f, 0xff, 0xd5, 0xe5, 0x71, 0xce, 0x31, 0x9a, 0xcb, 0xc0, 0x03,
+  0x38, 0x34, 0xec, 0x63, 0xa6, 0x08, 0x3e, 0xd5, 0xb1, 0xb4, 0x90, 0x7a, 0x7f, 0x8d, 0x7d, 0x9b,
+  0x97, 0xb5, 0xf2, 0xb1, 0xf2, 0x29, 0xfb, 0x2f, 0x3b, 0x8d, 0x00, 0x67, 0xae, 0x7b, 0x72, 0x3a,
+  0x56, 0x40, 0xc8, 0xcf, 0x18, 0x03, 0x8e, 0x0d, 0x2f, 0x04, 0x0e, 0x46, 0x79, 0xc5, 0x6d, 0x80,
+  0xd9, 0xac, 0x9c, 0xbd, 0xa7, 0x95, 0x8d, 0x53, 0xf6, 0x63, 0x31, 0xf3, 0x00, 0x47, 0x1e, 0xb5,
+  0x92, 0x14, 0x71, 0xcf, 0xd3, 0xdc, 0xd3, 0xb9, 0x0b, 0xfc, 0xce, 0x2b, 0x6f, 0x80, 0xb8, 0x2a,
+  0x6b, 0x39, 0x4b, 0xda, 0x1a, 0xa7, 0xc8, 0x45, 0xb0, 0x03, 0xc8, 0x15, 0x92, 0x02, 0xf3, 0x93,
+  0xf9, 0x53, 0xb1, 0xcf, 0x19, 0xe2, 0xb7, 0x31, 0x90, 0x07, 0x4f, 0xe5, 0x59, 0x39, 0x73, 0x9b,
+  0x27, 0xc8, 0x46, 0x54, 0x9f, 0xa5, 0x63, 0xed, 0x05, 0xb2, 0x00, 0x39, 0xa7, 0x60, 0x8c, 0x9f,
+  0x5e, 0xbe, 0x95, 0xb9, 0x83, 0xbb, 0xaf, 0xff, 0x00, 0x5a, 0xb3, 0x72, 0xe7, 0x35, 0x4f, 0x94,
+  0x61, 0x19, 0x3e, 0xf8, 0xe0, 0x7a, 0x56, 0x28, 0x00, 0x01, 0xd6, 0xa4, 0x03, 0xd0, 0x63, 0xf9,
+  0x56, 0xe7, 0x18, 0xe4, 0x74, 0xac, 0xa5, 0x2e, 0x73, 0x64, 0xf9, 0x46, 0x63, 0x39, 0x24, 0xf4,
+  0xe3, 0xda, 0xb1, 0x86, 0x71, 0x82, 0x3a, 0x75, 0xc7, 0x34, 0xed, 0xbd, 0x8b, 0x0c, 0x8f, 0x7a,
+  0xdd, 0x09, 0x86, 0xc8, 0xe9, 0xdf, 0xe9, 0x59, 0xca, 0x5c, 0xc6, 0xa9, 0xd8, 0x66, 0x30, 0x08,
+  0x15, 0x8b, 0xb3, 0x0a, 0x4e, 0x71, 0xfa, 0x53, 0xb6, 0x91, 0xc6, 0x30, 0x3b, 0xf1, 0x5b, 0xdb,
+  0x41, 0x27, 0x8a, 0xca, 0x52, 0xe6, 0x35, 0x4e, 0xc3, 0x02, 0x9c, 0xf0, 0x31, 0x58, 0x78, 0x03,
+  0x3f, 0x2f, 0xe5, 0x52, 0x60, 0x93, 0xef, 0x5b, 0xfb, 0x71, 0xc8, 0x38, 0x1e, 0xf5, 0x94, 0xa5,
+  0x73, 0x64, 0xc8, 0xb6, 0x76, 0x07, 0xb7, 0xe6, 0x2b, 0x10, 0x60, 0x67, 0xfc, 0xf1, 0x4e, 0x00,
+  0x0e, 0x36, 0x9c, 0x9e, 0x95, 0xd0, 0x0c, 0x0e, 0x9d, 0x3d, 0x3d, 0x38, 0xac, 0xe5, 0x2b, 0x9a,
+  0xa6, 0x30, 0x21, 0x18, 0xc0, 0xe7, 0x35, 0x85, 0x81, 0xbb, 0xd7, 0x34, 0xf0, 0x06, 0x3d, 0xba,
+  0x1f, 0x6a, 0xe8, 0x15, 0x79, 0xfe, 0x59, 0xac, 0x9c, 0x8d, 0x93, 0xb8, 0xc0, 0xa7, 0xf2, 0xe8,
+  0x6b, 0x08, 0x02, 0x32, 0x0f, 0x18, 0xa5, 0x50, 0x0b, 0x64, 0xfa, 0xf4, 0xc5, 0x74, 0x5b, 0x7f,
+  0xc6, 0xb3, 0x72, 0x35, 0x4e, 0xe3, 0x02, 0xee, 0x50, 0x46, 0x73, 0xef, 0x58, 0x3b, 0x4e, 0x46,
+  0x4e, 0x06, 0x29, 0xc5, 0x72, 0xc3, 0x39, 0xc7, 0x6f, 0xf0, 0xae, 0x8f, 0x6f, 0xcb, 0xd3, 0xad,
+  0x65, 0x29, 0x1b, 0x27, 0xcc, 0x44, 0xa9, 0xd3, 0xa9, 0xf4, 0xc7, 0x71, 0x58, 0x40, 0x11, 0xd4,
+  0x64, 0x1a, 0x5f, 0x50, 0x48, 0xc7, 0xe5, 0xc5, 0x74, 0x7b, 0x79, 0xf5, 0x3e, 0xa2, 0xb3, 0x72,
+  0xb1, 0xaa, 0x7c, 0xc3, 0x00, 0x00, 0xe3, 0x9c, 0xe7, 0x38, 0x35, 0xcf, 0xf2, 0x4f, 0x7e, 0x3b,
+  0x81, 0xcd, 0x38, 0x03, 0xc7, 0x5f, 0xce, 0xba, 0x42, 0x3e, 0x6c, 0x82, 0x39, 0xeb, 0xde, 0xb2,
+  0x94, 0xac, 0x6c, 0x9f, 0x38, 0xcf, 0xaf, 0x3d, 0xeb, 0x9e, 0x0b, 0x83, 0xec, 0x78, 0xa7, 0xe0,
+  0x80, 0xc4, 0x67, 0x27, 0x83, 0x91, 0x5d, 0x1f, 0x20, 0x63, 0xb7, 0x63, 0x9a, 0xce, 0x52, 0xe5,
+  0x35, 0x4f, 0x9c, 0x40, 0x38, 0xc9, 0xc9, 0x5a, 0xe7, 0x70, 0x49, 0xe3, 0xf3, 0xce, 0x29, 0xe1,
+  0x4e, 0x73, 0xfd, 0x3a, 0xd7, 0x48, 0xa0, 0x67, 0x18, 0xf7, 0xe9, 0x59, 0x4a, 0x5c, 0xa6, 0xa9,
+  0xfb, 0x42, 0x30, 0xa0, 0x9e, 0xdf, 0x8d, 0x73, 0xc1, 0x73, 0xfe, 0x34, 0xe2, 0x3e, 0x5c, 0xe7,
+  0x8f, 0x4e, 0x2b, 0xa5, 0x20, 0x76, 0xe4, 0x9e, 0x9e, 0x95, 0x9c, 0xa5, 0xc8, 0x6c, 0x9f, 0xb4,
+  0xf2, 0xb0, 0xc0, 0x9f, 0x36, 0x3f, 0x1e, 0x2b, 0x9e, 0xda, 0x41, 0xe0, 0x8e, 0x0f, 0x5a, 0x70,
+  0xe8, 0x70, 0x78, 0x1e, 0xdd, 0x2b, 0xa7, 0x0a, 0x38, 0xf7, 0xe9, 0xcf, 0x5a, 0xc9, 0xcb, 0x90,
+  0xd5, 0x3f, 0x6b, 0xe5, 0x62, 0x35, 0x43, 0xcf, 0xa6, 0x40, 0xc5, 0x73, 0x80, 0x12, 0x00, 0x23,
+  0x8f, 0x5c, 0x0c, 0x53, 0xd4, 0x0f, 0xce, 0xba, 0x6d, 0x98, 0x61, 0x9e, 0xfd, 0x4d, 0x66, 0xe5,
+  0xc8, 0x6c, 0x9f, 0xb5, 0xf2, 0xb1, 0xff, 0xd6, 0xe7, 0xb0, 0x40, 0x07, 0x1d, 0xb8, 0xac, 0x90,
+  0xb9, 0x03, 0x27, 0xbf, 0xe5, 0x4e, 0xc6, 0x30, 0x71, 0xc7, 0xd2, 0xb6, 0x88, 0xc0, 0xe3, 0xf4,
+  0xed, 0x5f, 0x56, 0xe5, 0xed, 0x0f, 0x8c, 0x4f, 0xd9, 0x79, 0xdc, 0x8c, 0x2e, 0x37, 0x67, 0xf9,
+  0x56, 0x40, 0x51, 0xb8, 0x02, 0x0f, 0xd3, 0xd6, 0x9c, 0xa0, 0x9e, 0x06, 0x7e, 0x87, 0x9a, 0xdc,
+  0x55, 0xc0, 0xe4, 0x7e, 0x35, 0x9c, 0xa5, 0xed, 0x0d, 0x53, 0xf6, 0x7e, 0x77, 0x19, 0xb7, 0xe6,
+  0xe4, 0x60, 0x67, 0xd6, 0xb1, 0xb6, 0xfc, 0xc3, 0x9e, 0x69, 0xf8, 0x5e, 0xa3, 0xbe, 0x38, 0xe9,
+  0x5b, 0x9b, 0x7e, 0xe9, 0xfe, 0x67, 0xa5, 0x65, 0x29, 0x73, 0x9a, 0xa7, 0xec, 0xc8, 0xc6, 0x00,
+  0xff, 0x00, 0x1a, 0xc7, 0x20, 0xe3, 0x38, 0xc7, 0x1d, 0xba, 0x53, 0x88, 0x20, 0x63, 0x07, 0x9e,
+  0x31, 0x5b, 0xa4, 0x60, 0x7b, 0xf7, 0xf7, 0xac, 0xdc, 0xb9, 0xcd, 0x93, 0xe4, 0x18, 0xa3, 0x23,
+  0xbf, 0xbf, 0xa0, 0xac, 0x5c, 0x60, 0x67, 0x8c, 0x0e, 0x29, 0xe1, 0x71, 0x83, 0xdb, 0xb5, 0x6e,
+  0x94, 0xc7, 0x00, 0xfc, 0xa3, 0xb5, 0x65, 0x29, 0x73, 0x1a, 0xa7, 0xc8, 0x30, 0x00, 0x77, 0x03,
+  0x8e, 0x39, 0x3e, 0xf5, 0x89, 0x8e, 0x81, 0xb8, 0xe3, 0xaf, 0x5a, 0x71, 0x00, 0x7a, 0xe3, 0xf0,
+  0xad, 0xf4, 0x56, 0xe8, 0x4f, 0x38, 0xef, 0xd2, 0xb3, 0x94, 0xb9, 0x8d, 0x53, 0xe5, 0x18, 0x07,
+  0xa7, 0x3e, 0xd5, 0x88, 0x73, 0xfc, 0x43, 0x8e, 0xb8, 0xc6, 0x29, 0xd8, 0xed, 0xd7, 0xdf, 0xe9,
+  0x5b, 0xfb, 0x39, 0xfa, 0xf1, 0x59, 0x39, 0x73, 0x1b, 0x27, 0xca, 0x34, 0x2f, 0x50, 0x0e, 0x78,
+  0xfa, 0xd6, 0x16, 0xd3, 0x9e, 0x3d, 0x7b, 0xf6, 0xa7, 0x11, 0xcf, 0x1f, 0xce, 0xba, 0x10, 0xbd,
+  0x01, 0x18, 0x39, 0xe9, 0x59, 0xb9, 0x5c, 0xd5, 0x3b, 0x11, 0xe0, 0xed, 0x1d, 0x3d, 0xcd, 0x61,
+  0x05, 0xc1, 0x20, 0x9f, 0xf1, 0xa9, 0x31, 0xc9, 0xcf, 0x3d, 0x3a, 0x73, 0x5b, 0xfb, 0x08, 0x39,
+  0xce, 0x7e, 0x83, 0xad, 0x65, 0x29, 0x5c, 0xd9, 0x3b, 0x0c, 0x0b, 0xc6, 0x08, 0xcd, 0x60, 0x94,
+  0x07, 0x19, 0x07, 0x02, 0x9f, 0xfc, 0x59, 0xe9, 0x91, 0x5d, 0x12, 0xa8, 0x51, 0x90, 0x0e, 0x6b,
+  0x39, 0x48, 0xd5, 0x32, 0x20, 0x39, 0x18, 0x1d, 0x7d, 0xab, 0x08, 0x02, 0x78, 0x39, 0x03, 0xd2,
+  0x97, 0x18, 0xe3, 0xbe, 0x3f, 0xa5, 0x74, 0x7e, 0xf8, 0xeb, 0x59, 0x4a, 0x46, 0xc9, 0x8d, 0x0b,
+  0xf2, 0xe0, 0x80, 0x31, 0xf8, 0xd7, 0x3d, 0x81, 0xdf, 0xbf, 0xa1, 0xa9, 0x31, 0x9c, 0x64, 0x7a,
+  0xf4, 0xef, 0x5d, 0x10, 0x19, 0x20, 0x83, 0xd3, 0xbd, 0x67, 0x29, 0x58, 0xd5, 0x3b, 0x91, 0x95,
+  0x23, 0xae, 0x31, 0xe9, 0x58, 0x1b, 0x48, 0x20, 0x9c, 0x7f, 0x3a, 0x70, 0x5c, 0xf3, 0x8f, 0x7f,
+  0xa5, 0x74, 0x9b, 0x70, 0x78, 0x23, 0x3e, 0xdc, 0x71, 0x59, 0x4a, 0x56, 0x36, 0x4e, 0xe3, 0x36,
+  0xe7, 0x39, 0xed, 0xde, 0xb9, 0xef, 0x5c, 0xe4, 0x63, 0xb5, 0x3c, 0x02, 0x58, 0x71, 0x93, 0x8f,
+  0xca, 0xba, 0x5d, 0xa4, 0x02, 0x46, 0x39, 0xfd, 0x3f, 0xce, 0x6b, 0x37, 0x2b, 0x1a, 0xa7, 0xcc,
+  0x45, 0xb4, 0xf0, 0x0f, 0xe4, 0x0d, 0x73, 0xdb, 0x4e, 0x54, 0x91, 0x9c, 0x8a, 0x7e, 0x38, 0xce,
+  0x38, 0xed, 0xed, 0x5d, 0x28, 0x18, 0xc0, 0xc8, 0xfa, 0x66, 0xb2, 0x94, 0xb9, 0x4d, 0x53, 0xe6,
+  0x18, 0x06, 0x70, 0x0f, 0x63, 0xdc, 0x57, 0x3b, 0x80, 0x18, 0x60, 0x93, 0xfa, 0x53, 0x86, 0x4f,
+  0x5e, 0x3d, 0xbd, 0x2b, 0xa7, 0x09, 0xc7, 0x23, 0xf3, 0xac, 0xdc, 0xb9, 0x4d, 0x93, 0xe7, 0x23,
+  0x03, 0x8e, 0x98, 0x1f, 0xa5, 0x73, 0x98, 0x03, 0x23, 0x9c, 0x8f, 0x6a, 0x76, 0xdc, 0x1e, 0x39,
+  0xc7, 0x43, 0x5d, 0x3e, 0x3d, 0x3f, 0x53, 0x59, 0x39, 0x72, 0x1a, 0xa7, 0xce, 0x30, 0x28, 0x0d,
+  0x82, 0x3b, 0xf5, 0xcd, 0x73, 0x7d, 0xfa, 0xf4, 0xea, 0x69, 0xd8, 0xc7, 0xd3, 0xbf, 0x15, 0xd4,
+  0x2a, 0xe0, 0xe4, 0xf0, 0x0f, 0x4a, 0xca, 0x52, 0xe4, 0x36, 0x4f, 0xda, 0x0c, 0xda, 0x0f, 0x3e,
+  0xd5, 0xcd, 0x6d, 0x04, 0x90, 0x39, 0xfc, 0x69, 0xe4, 0x10, 0x3a, 0xe4, 0x63, 0x9a, 0xe9, 0xc2,
+  0x8c, 0x8e, 0xbb, 0xbd, 0xc5, 0x67, 0x29, 0x7b, 0x33, 0x54, 0xfd, 0xa7, 0x95, 0x86, 0xed, 0x1b,
+  0x76, 0x8c, 0x75, 0xe3, 0x9a, 0xe6, 0x86, 0x01, 0xce, 0x48, 0xec, 0x7d, 0xa9, 0xfc, 0x0e, 0x0b,
+  0x73, 0xd6, 0xba, 0x80, 0x36, 0xf2, 0x79, 0x26, 0xb2, 0x72, 0xf6, 0x66, 0xc9, 0xfb, 0x5f, 0x2b,
+  0x1f, 0xff, 0xd7, 0xc7, 0xda, 0x7b, 0x71, 0x58, 0xe0, 0x6e, 0x1e, 0xfe, 0x94, 0xe0, 0xa0, 0x8c,
+  0x63, 0x3d, 0xf1, 0x5b, 0xa1, 0x32, 0xd8, 0x1c, 0x71, 0xc7, 0xbd, 0x7d, 0x23, 0x97, 0x39, 0xf0,
+  0xe9, 0xfb, 0x1f, 0x3b, 0x91, 0xaa, 0x81, 0x8f, 0xd7, 0x9a, 0xc5, 0x03, 0x71, 0xce, 0x33, 0xf5,
+  0xa9, 0x30, 0x0e, 0x31, 0x8f, 0x5e, 0xb5, 0xb8, 0xab, 0xc6, 0x7a, 0x62, 0xb3, 0x94, 0xb9, 0xcd,
+  0x53, 0xf6, 0x5e, 0x77, 0x18, 0xa3, 0x3d, 0xf3, 0x9f, 0x51, 0x58, 0xb8, 0xc6, 0x32, 0x3a, 0xfa,
+  0xd2, 0x91, 0xce, 0x39, 0xae, 0x80, 0x0e, 0x9d, 0x7f, 0x0e, 0xf5, 0x93, 0x97, 0x39, 0xaa, 0x7e,
+  0xcf, 0xce, 0xe3, 0x00, 0x24, 0xe0, 0x63, 0xdf, 0xad, 0x61, 0xa8, 0xf9, 0x78, 0xce, 0x3d, 0x0d,
+  0x3b, 0x1b, 0x8f, 0xb9, 0xf4, 0xad, 0xfd, 0x9f, 0x28, 0xc8, 0x3c, 0x1a, 0xce, 0x52, 0xe6, 0x36,
+  0x4f, 0xd9, 0x8c, 0x00, 0x60, 0x0f, 0xc7, 0x04, 0x56, 0x1a, 0xa9, 0x5e, 0x39, 0x07, 0xb5, 0x3f,
+  0x67, 0x7e, 0x73, 0xeb, 0x9a, 0xe8, 0x36, 0xe7, 0xa1, 0x03, 0x1d, 0xbf, 0xfa, 0xd5, 0x94, 0xa5,
+  0xcc, 0x6a, 0x9f, 0x21, 0x10, 0x18, 0xf5, 0xc9, 0x1f, 0xc5, 0x58, 0x7b, 0x71, 0x9e, 0x79, 0xcf,
+  0x1d, 0xe9, 0xf8, 0xc8, 0xf9, 0x7f, 0x10, 0x2b, 0xa0, 0x55, 0x0d, 0x9c, 0x9c, 0x7b, 0xfa, 0x1a,
+  0xc9, 0xca, 0xe6, 0xa9, 0xf2, 0x0c, 0xdb, 0x91, 0x9e, 0xb8, 0xf5, 0x15, 0x82, 0x13, 0x00, 0x67,
+  0xb7, 0x5a, 0x78, 0x00, 0x11, 0x8e, 0xbe, 0xb5, 0xd1, 0x04, 0xc1, 0xc8, 0xe3, 0xd7, 0x35, 0x9c,
+  0xa5, 0x73, 0x64, 0xf9, 0x46, 0x15, 0x03, 0x04, 0xf3, 0x9a, 0xe7, 0xca, 0xf3, 0x80, 0x38, 0xa7,
+  0xe3, 0x90, 0x70, 0x39, 0xeb, 0x8e, 0xd5, 0xd1, 0xe0, 0xe7, 0xa8, 0x20, 0x1a, 0xca, 0x52, 0x35,
+  0x4f, 0x94, 0x8f, 0x69, 0x27, 0x07, 0x3c, 0xe0, 0xf4, 0xed, 0x58, 0x03, 0x27, 0xb1, 0xc0, 0xef,
+  0x4a, 0x00, 0x03, 0x3e, 0xfd, 0x6b, 0xa4, 0x0a, 0xb8, 0x2c, 0x3f, 0x00, 0x3b, 0x1a, 0xcd, 0xc8,
+  0xd9, 0x3b, 0x0c, 0xc1, 0x04, 0x63, 0xb1, 0xae, 0x7f, 0x19, 0x07, 0x34, 0xf0, 0x3e, 0x53, 0xed,
+  0xeb, 0x5d, 0x26, 0xd1, 0x8c, 0x6d, 0xce, 0x3d, 0x7b, 0x56, 0x4e, 0x46, 0xa9, 0xd8, 0x60, 0x51,
+  0x8c, 0x0e, 0x49, 0xae, 0x77, 0x03, 0xd7, 0x04, 0x74, 0xa7, 0x75, 0xc8, 0xe7, 0x07, 0xa9, 0x15,
+  0xd3, 0x15, 0x05, 0xb1, 0xd8, 0xfb, 0x56, 0x72, 0x95, 0x8d, 0x93, 0x23, 0x2b, 0xc9, 0xed, 0x9e,
+  0xb5, 0xce, 0xe0, 0xe3, 0x1b, 0xb1, 0x52, 0x05, 0x19, 0x18, 0x1f, 0xa8, 0xae, 0x90, 0x2e, 0xdc,
+  0xfe, 0x7c, 0x8a, 0xca, 0x52, 0xb1, 0xaa, 0x63, 0x31, 0x96, 0xe9, 0xd3, 0xbd, 0x73, 0xa0, 0x16,
+  0xe3, 0x00, 0x8f, 0x6a, 0x70, 0x19, 0x5c, 0x7a, 0xf5, 0x15, 0xd3, 0x2a, 0x56, 0x72, 0x97, 0x29,
+  0xaa, 0x77, 0x19, 0xb3, 0x27, 0x00, 0xf1, 0xed, 0x5c, 0xea, 0x83, 0xd4, 0x62, 0x97, 0x1c, 0x74,
+  0xeb, 0xc9, 0xf7, 0xae, 0x9c, 0x64, 0xf4, 0xce, 0x2b, 0x29, 0x4b, 0x94, 0xd9, 0x3b, 0x91, 0xed,
+  0xf9, 0x8e, 0x31, 0xfd, 0x6b, 0x9c, 0x0a, 0x4b, 0x73, 0xd4, 0xf6, 0x14, 0xf0, 0x38, 0xce, 0x39,
+  0x3d, 0x2b, 0xa9, 0x55, 0x39, 0xf4, 0xf6, 0xcf, 0x4a, 0xce, 0x52, 0xe4, 0x35, 0x4f, 0x98, 0x89,
+  0x41, 0xc9, 0xe4, 0x63, 0xdf, 0xbd, 0x73, 0x6a, 0xa3, 0xb6, 0x7d, 0x72, 0x29, 0xc3, 0x38, 0x04,
+  0x01, 0x8f, 0x53, 0xda, 0xba, 0x9e, 0x3d, 0x4f, 0xe5, 0x59, 0x39, 0x72, 0x1b, 0x27, 0xcc, 0x47,
+  0xb3, 0x8f, 0xa7, 0x5e, 0x2b, 0x9a, 0xc6, 0x31, 0xdf, 0x1c, 0xf5, 0xa7, 0x70, 0x7d, 0x3f, 0xc2,
+  0xba, 0xac, 0x1f, 0xbd, 0xd7, 0xeb, 0x59, 0xb9, 0x72, 0x1a, 0xa7, 0xce, 0x46, 0xaa, 0x09, 0xdd,
+  0x81, 0xf4, 0xc5, 0x73, 0x23, 0x77, 0x1b, 0x41, 0x3f, 0xad, 0x3c, 0x8e, 0x71, 0x91, 0xc7, 0x5f,
+  0x4a, 0xea, 0x0a, 0xf1, 0x8e, 0x3a, 0xd6, 0x52, 0x97, 0xb3, 0x36, 0x4f, 0x9c, 0x8f, 0x69, 0x3c,
+  0x75, 0xfc, 0x2b, 0x9b, 0xc1, 0x19, 0x20, 0x9e, 0x3a, 0x1c, 0xd3, 0x82, 0xfb, 0x7e, 0x42, 0xba,
+  0xac, 0x13, 0xc7, 0xa7, 0x43, 0x59, 0xca, 0x5e, 0xcf, 0xce, 0xe6, 0xa9, 0xfb, 0x42, 0x3d, 0x99,
+  0xce, 0x7d, 0x32, 0x31, 0xe9, 0x5c, 0xb8, 0x41, 0x8f, 0x51, 0xeb, 0x4f, 0x00, 0xa8, 0xeb, 0x5d,
+  0x68, 0x5c, 0x9c, 0x9e, 0x73, 0x59, 0x4a, 0x5e, 0xcb, 0xce, 0xe6, 0xc9, 0xfb, 0x4f, 0x2b, 0x1f,
+  0xff, 0xd0, 0xa3, 0xb7, 0x9e, 0x9f, 0x9d, 0x61, 0xf2, 0x32, 0x47, 0x27, 0x34, 0xe0, 0xbc, 0xf0,
+  0x09, 0x15, 0xd0, 0x81, 0x81, 0xb8, 0xf4, 0x27, 0xbd, 0x7b, 0xae, 0x5c, 0xe7, 0xc0, 0xa7, 0xec,
+  0x7c, 0xee, 0x44, 0x07, 0x1b, 0xb3, 0xf9, 0xd6, 0x20, 0xc6, 0x70, 0x3e, 0xb4, 0xed, 0x98, 0x19,
+  0x35, 0xd0, 0x01, 0x8c, 0x92, 0x33, 0xc7, 0x24, 0x75, 0xac, 0x9c, 0xb9, 0x8d, 0x53, 0xf6, 0x5e,
+  0x77, 0x19, 0xb7, 0x38, 0x18, 0xc8, 0xf6, 0x35, 0x82, 0x17, 0x04, 0xff, 0x00, 0x85, 0x38, 0x05,
+  0xc9, 0x27, 0x1c, 0xd7, 0x43, 0x8c, 0x9f, 0xfe, 0xbd, 0x67, 0x29, 0x73, 0x1b, 0x27, 0xec, 0xbc,
+  0xee, 0x30, 0x28, 0x3d, 0x40, 0x24, 0x7a, 0x73, 0x9a, 0xc2, 0xdb, 0x81, 0x8e, 0x07, 0x3c, 0xd2,
+  0xe3, 0x1d, 0xbd, 0xeb, 0xa3, 0x55, 0x20, 0xe7, 0x03, 0xe9, 0xfa, 0x56, 0x52, 0x95, 0xcd, 0x53,
+  0xf6, 0x7e, 0x77, 0x23, 0xc1, 0x1d, 0x38, 0xc7, 0x1c, 0xd6, 0x16, 0x30, 0xa3, 0x22, 0x94, 0x67,
+  0x0b, 0x81, 0x8f, 0xa5, 0x74, 0x61, 0x78, 0xc9, 0xe9, 0xfc, 0xab, 0x39, 0x4a, 0xe6, 0xc9, 0xfb,
+  0x32, 0x3d, 0xa3, 0x9e, 0xe7, 0xae, 0x2b, 0x9f, 0x0b, 0x83, 0xd0, 0x7b, 0xe4, 0x53, 0xc0, 0xdc,
+  0x46, 0x78, 0xe3, 0x3f, 0x5a, 0xe8, 0xf9, 0xc8, 0xe0, 0x83, 0x59, 0x39, 0x5c, 0xd5, 0x3e, 0x41,
+  0x9c, 0x83, 0xde, 0xb9, 0xfd, 0xa0, 0x6e, 0x1d, 0xf8, 0xfc, 0x69, 0xfe, 0xd8, 0xe4, 0xf5, 0xae,
+  0x94, 0x2f, 0x6e, 0x87, 0xd3, 0xbd, 0x67, 0x29, 0x1b, 0x27, 0xc8, 0x44, 0x10, 0x81, 0x8c, 0x71,
+  0xed, 0x5c, 0xfa, 0xe7, 0x9c, 0x82, 0x7d, 0x29, 0xc0, 0x0e, 0x78, 0xc1, 0xc0, 0xed, 0x5d, 0x20,
+  0x52, 0x08, 0xfe, 0x9d, 0xab, 0x27, 0x23, 0x54, 0xf9, 0x46, 0x6d, 0x38, 0xee, 0x07, 0xb5, 0x73,
+  0xc0, 0x16, 0x1c, 0xfe, 0x74, 0xe0, 0xa0, 0x01, 0xc0, 0x3c, 0xf3, 0xef, 0x5d, 0x29, 0x5e, 0x3a,
+  0xe0, 0x7a, 0x56, 0x6e, 0x56, 0x36, 0x4f, 0x94, 0x66, 0xd2, 0x30, 0x48, 0xe7, 0xae, 0x6b, 0x9d,
+  0x08, 0x33, 0x92, 0x71, 0x9e, 0x94, 0xe5, 0x1c, 0x0e, 0x98, 0x23, 0xb8, 0xae, 0x9b, 0x1d, 0x00,
+  0x1f, 0x9f, 0xbd, 0x65, 0x29, 0x58, 0xd5, 0x3b, 0x0c, 0x20, 0x9e, 0x70, 0x4f, 0x6e, 0x9c, 0xd7,
+  0x3c, 0x06, 0x0e, 0x48, 0x03, 0x8e, 0x29, 0x76, 0xae, 0x47, 0x19, 0xae, 0x9f, 0x1c, 0x6e, 0x2b,
+  0x9e, 0x33, 0x9a, 0xce, 0x52, 0xe5, 0x35, 0x4e, 0xc4, 0x65, 0x41, 0x39, 0x20, 0xfe, 0x35, 0xcd,
+  0xed, 0xc7, 0x27, 0x3c, 0x7e, 0x94, 0xf1, 0x90, 0x3d, 0x46, 0x7d, 0x3a, 0x7d, 0x2b, 0xa8, 0x03,
+  0xb8, 0xce, 0x4f, 0x1f, 0x5a, 0xc9, 0xcb, 0x94, 0xd9, 0x31, 0xa0, 0x60, 0x73, 0xc7, 0xd0, 0xd7,
+  0x32, 0x00, 0xdc, 0x3d, 0x4d, 0x38, 0x03, 0x82, 0x48, 0xe6, 0xba, 0x81, 0x9c, 0x63, 0xbd, 0x67,
+  0x29, 0x72, 0x9a, 0xa6, 0x30, 0x26, 0x07, 0xa0, 0xe3, 0xf1, 0xae, 0x68, 0x0e, 0xdf, 0xd2, 0x9d,
+  0x8c, 0x9c, 0x8c, 0x03, 0x5d, 0x48, 0x5c, 0x76, 0xf6, 0xe9, 0xc5, 0x65, 0x29, 0x72, 0x1b, 0x27,
+  0x71, 0x9b, 0x72, 0x38, 0xe8, 0x3d, 0x2b, 0x99, 0x00, 0x63, 0xa7, 0xe3, 0x9a, 0x90, 0x29, 0xce,
+  0x4f, 0x03, 0xeb, 0xd2, 0xba, 0x9c, 0x64, 0xf3, 0xe9, 0xd4, 0x56, 0x6e, 0x5c, 0x86, 0xa9, 0xdc,
+  0x60, 0x07, 0x6f, 0x1c, 0xfb, 0xd7, 0x2e, 0x07, 0x70, 0xa7, 0x26, 0x9e, 0x17, 0x9e, 0xa7, 0x23,
+  0x07, 0x9e, 0xd5, 0xd5, 0x00, 0x3b, 0x91, 0xeb, 0xcf, 0x6a, 0xc9, 0xcb, 0xd9, 0x9b, 0x27, 0xcc,
+  0x33, 0x6f, 0x53, 0x8c, 0x8f, 0x41, 0x5c, 0xc0, 0x42, 0xb8, 0x3d, 0x3d, 0x69, 0xc4, 0x60, 0x0c,
+  0x8c, 0xf3, 0xda, 0xba, 0xc0, 0xb8, 0x6c, 0x80, 0x6b, 0x29, 0x4b, 0xd9, 0x9a, 0xa7, 0xcc, 0x30,
+  0x29, 0x3d, 0x4e, 0x3d, 0x4e, 0x6b, 0x96, 0x0b, 0xc6, 0x4e, 0x39, 0xe6, 0x9d, 0xb7, 0x04, 0x67,
+  0x91, 0xfa, 0xd7, 0x58, 0x33, 0x83, 0xe9, 0xd2, 0xb3, 0x94, 0xbd, 0x97, 0x9d, 0xcd, 0x93, 0xe7,
+  0x18, 0x07, 0x39, 0x3e, 0xbd, 0xab, 0x96, 0x23, 0x83, 0xeb, 0x8f, 0x6a, 0x70, 0xe3, 0xb0, 0xe2,
+  0xba, 0xed, 0xb9, 0xc9, 0x19, 0xe9, 0xd0, 0x75, 0xac, 0xe5, 0x2f, 0x65, 0xe7, 0x73, 0x54, 0xf9,
+  0xc8, 0xc8, 0x39, 0xc1, 0x52, 0x4f, 0x70, 0x2b, 0x95, 0x2a, 0x70, 0x30, 0x30, 0x7a, 0x53, 0xb6,
+  0xe4, 0x70, 0xbc, 0x7f, 0x3a, 0xeb, 0xf1, 0xe9, 0xd0, 0x76, 0xac, 0xa5, 0x2f, 0x63, 0xe7, 0x73,
+  0x54, 0xfd, 0xa1, 0xff, 0xd1, 0x8f, 0x68, 0xe0, 0x90, 0x39, 0xeb, 0x58, 0x1f, 0xc5, 0xeb, 0x91,
+  0xcd, 0x28, 0x51, 0xdf, 0x07, 0xd6, 0xba, 0x30, 0xbf, 0x2e, 0x08, 0xe2, 0xbd, 0x67, 0x2e, 0x63,
+  0xf3, 0xc4, 0xfd, 0x87, 0x9d, 0xc6, 0x05, 0xf9, 0x4f, 0x07, 0x3e, 0xf5, 0x80, 0x57, 0x93, 0x9f,
+  0xcf, 0xd2, 0x9c, 0x14, 0xf2, 0x47, 0xf2, 0xeb, 0x5d, 0x18, 0x07, 0xa6, 0x72, 0x3d, 0x47, 0x38,
+  0xac, 0xa5, 0x2e, 0x63, 0x54, 0xfd, 0x8f, 0x9d, 0xc6, 0x28, 0xc6, 0x0f, 0x6e, 0x95, 0xcf, 0x91,
+  0xd4, 0x76, 0xfe, 0x74, 0xe1, 0xc9, 0x07, 0xdb, 0xb5, 0x74, 0xa1, 0x76, 0xe3, 0x1d, 0x2b, 0x39,
+  0x4a, 0xe6, 0xc9, 0xfb, 0x2f, 0x3b, 0x91, 0xed, 0x1d, 0x30, 0x0f, 0x1e, 0xb8, 0xae, 0x77, 0x07,
+  0xa9, 0xea, 0x4e, 0x29, 0xe4, 0x60, 0x1c, 0xe3, 0x1c, 0x57, 0x49, 0x82, 0x30, 0x7b, 0x0e, 0xd5,
+  0x93, 0x95, 0xcd, 0x53, 0xf6, 0x5e, 0x77, 0x18, 0x46, 0x47, 0x4c, 0x8f, 0x6e, 0xa2, 0xb9, 0xf0,
+  0x33, 0xdc, 0x1f, 0x4c, 0xd2, 0xed, 0xcf, 0x1f, 0xca, 0xba, 0x60, 0x38, 0xce, 0x70, 0x73, 0xc8,
+  0x15, 0x9c, 0xa4, 0x6c, 0x9f, 0xb3, 0xf3, 0xb9, 0x1f, 0xa7, 0x6e, 0xe2, 0xb9, 0xc0, 0x07, 0x03,
+  0x03, 0x3f, 0xce, 0xa4, 0x2a, 0x30, 0x30, 0x3a, 0x0a, 0xe9, 0x82, 0x8e, 0x49, 0x1c, 0x75, 0xfa,
+  0xd6, 0x52, 0x91, 0xaa, 0x7e, 0xcc, 0x62, 0x8e, 0x41, 0xee, 0x7f, 0x4a, 0xe6, 0xf6, 0x8c, 0x64,
+  0xf5, 0xc7, 0x71, 0xd3, 0xda, 0xa4, 0x5c, 0x93, 0xcf, 0x5f, 0x4a, 0xe9, 0x82, 0xf3, 0xc8, 0xe8,
+  0x31, 0x59, 0x4a, 0x56, 0x36, 0x4f, 0x90, 0x8c, 0xa9, 0xe3, 0xfc, 0x8a, 0xe7, 0x76, 0x82, 0x78,
+  0x1c, 0x83, 0x8e, 0x29, 0x40, 0x1e, 0x9e, 0xfc, 0x57, 0x50, 0x14, 0xe4, 0x1d, 0xbc, 0xf5, 0xe2,
+  0xb3, 0x72, 0xb1, 0xaa, 0x7c, 0x83, 0x15, 0x36, 0xf3, 0xcf, 0xf8, 0x57, 0x34, 0x14, 0x9e, 0x31,
+  0xfd, 0x29, 0xfc, 0xe7, 0x3c, 0x63, 0xd8, 0xd7, 0x51, 0xb4, 0x12, 0x08, 0xe3, 0xd7, 0x35, 0x94,
+  0xa5, 0x63, 0x64, 0xf9, 0x46, 0x84, 0x07, 0xaf, 0xe2, 0x6b, 0x98, 0x2b, 0xcf, 0x6a, 0x90, 0x2e,
+  0x5b, 0x8c, 0x13, 0xd4, 0xd7, 0x4e, 0x14, 0xe5, 0x87, 0x41, 0xdf, 0x15, 0x9b, 0x97, 0x29, 0xaa,
+  0x7c, 0xa3, 0x02, 0xe4, 0xe7, 0x07, 0xfa, 0x0a, 0xe6, 0x8a, 0x63, 0x93, 0xe9, 0xc0, 0xa7, 0x01,
+  0xc1, 0xe7, 0x19, 0xe6, 0xba, 0xac, 0x60, 0x91, 0xdf, 0x1c, 0xd6, 0x4e, 0x5c, 0xa6, 0xa9, 0xd8,
+  0x68, 0x5e, 0x9c, 0xe1, 0x7d, 0xba, 0x57, 0x2d, 0x82, 0x01, 0x1f, 0xd2, 0x9f, 0xb4, 0x10, 0x4e,
+  0x31, 0xc7, 0x4a, 0xea, 0x80, 0xe4, 0xe0, 0x2f, 0xb0, 0xf5, 0xac, 0xdc, 0xb9, 0x0d, 0x93, 0xb0,
+  0xd0, 0x3e, 0x5e, 0x7a, 0x03, 0xd7, 0x35, 0xcb, 0xaa, 0x60, 0x01, 0xd7, 0xbd, 0x3c, 0x01, 0xd0,
+  0x75, 0xfe, 0x55, 0xd5, 0xed, 0xca, 0x90, 0x0e, 0x36, 0xfa, 0x0a, 0xca, 0x52, 0xe4, 0x35, 0x4c,
+  0x61, 0x5c, 0xfd, 0x71, 0xc7, 0xb5, 0x72, 0xe7, 0x91, 0xd0, 0xe4, 0xf7, 0xa7, 0xe3, 0x2c, 0x71,
+  0xdb, 0xbd, 0x75, 0x61, 0x73, 0x9c, 0xf0, 0x3e, 0xb5, 0x9b, 0x97, 0xb3, 0x36, 0x4c, 0x61, 0x5e,
+  0x31, 0x9c, 0x60, 0xf1, 0xcd, 0x72, 0xfb, 0x48, 0x18, 0xfc, 0x0e, 0x29, 0x7b, 0x92, 0x73, 0x8f,
+  0x7a, 0xeb, 0x40, 0xf4, 0x3c, 0x8a, 0xca, 0x52, 0xf6, 0x66, 0xa9, 0xdc, 0x66, 0xd1, 0x91, 0xc7,
+  0x07, 0xf3, 0xfc, 0xeb, 0x96, 0x19, 0xdd, 0xd4, 0x7e, 0x14, 0xf2, 0x00, 0x39, 0xc7, 0x5e, 0xf5,
+  0xd5, 0x85, 0x04, 0x0e, 0xc0, 0x1e, 0xa6, 0xb3, 0x94, 0xbd, 0x97, 0x9d, 0xcd, 0x93, 0xb8, 0xcd,
+  0xa0, 0x72, 0x06, 0x3b, 0x57, 0x2c, 0x17, 0x0b, 0x92, 0x33, 0xc6, 0x69, 0xdb, 0x71, 0xc9, 0x19,
+  0xc7, 0x60, 0x2b, 0xae, 0x08, 0x78, 0xc0, 0x00, 0xf4, 0xac, 0x9c, 0xbd, 0x97, 0x9d, 0xcd, 0x53,
+  0xe6, 0x18, 0xab, 0xd8, 0xfe, 0x95, 0xc9, 0xec, 0xc2, 0xf5, 0x1f, 0xe3, 0x52, 0x63, 0xae, 0xee,
+  0x73, 0xc0, 0xae, 0xb4, 0x0c, 0x8c, 0x91, 0xfa, 0x75, 0xac, 0xe5, 0x2f, 0x65, 0xe7, 0x73, 0x54,
+  0xf9, 0xc6, 0xed, 0xcb, 0x63, 0xd6, 0xb9, 0x31, 0xd0, 0xe3, 0xd6, 0x94, 0x8e, 0x78, 0xfe, 0x55,
+  0xd8, 0x00, 0x70, 0x33, 0xd7, 0xbf, 0x15, 0x94, 0xa5, 0xec, 0x7c, 0xee, 0x6c, 0x9f, 0x38, 0xcd,
+  0xa4, 0x81, 0x91, 0x90, 0x3e, 0x95, 0xc9, 0xed, 0x01, 0x4f, 0xa6, 0x7a, 0x53, 0xba, 0x2f, 0x38,
+  0x27, 0xb5, 0x75, 0xe0, 0x10, 0x7a, 0xfe, 0x42, 0xb3, 0x72, 0xf6, 0x3e, 0x77, 0x35, 0x4f, 0x9c,
+  0xff, 0xd2, 0x78, 0x41, 0xdb, 0xf0, 0xc5, 0x60, 0x60, 0x0e, 0xf8, 0xe3, 0x3c, 0x53, 0x94, 0x73,
+  0x8f, 0x5a, 0xe9, 0xb0, 0x3b, 0x8c, 0x8a, 0xee, 0x72, 0xb9, 0xf9, 0xba, 0x7e, 0xc3, 0xce, 0xe4,
+  0x3b, 0x71, 0xc9, 0xe8, 0x6b, 0x9f, 0x08, 0xa3, 0xd4, 0xfe, 0x34, 0xed, 0xbf, 0x36, 0x7a, 0xf3,
+  0xd4, 0xd7, 0x4a, 0xa0, 0x75, 0xe7, 0x1f, 0xca, 0xb3, 0x94, 0xae, 0x6a, 0x9f, 0xb1, 0xf3, 0xb9,
+  0x1e, 0xd3, 0xc7, 0xa0, 0xe9, 0xeb, 0x5c, 0xf6, 0xd2, 0x33, 0x8e, 0x71, 0x4b, 0x8e, 0x3b, 0x92,
+  0x2b, 0xa8, 0x28, 0x36, 0xf0, 0x0e, 0x09, 0xac, 0xa5, 0x23, 0x64, 0xfd, 0x8f, 0x9d, 0xc8, 0xc2,
+  0x7c, 0xa0, 0x7e, 0x18, 0xcf, 0x4a, 0xe7, 0x00, 0x07, 0x23, 0x3e, 0xc4, 0x53, 0x99, 0x78, 0x1d,
+  0x71, 0xef, 0x5d, 0x31, 0x5e, 0x39, 0x27, 0xf2, 0xac, 0xdc, 0x8d, 0x53, 0xf6, 0x5e, 0x77, 0x1a,
+  0x11, 0x71, 0xd7, 0x9f, 0x6a, 0xe6, 0xf6, 0xb1, 0xc9, 0x19, 0x27, 0xd6, 0x9e, 0x06, 0x33, 0xdc,
+  0x9f, 0x7c, 0x57, 0x4c, 0x14, 0x81, 0xd8, 0x1c, 0x67, 0x35, 0x94, 0xa4, 0x6c, 0x9f, 0xb2, 0xf3,
+  0xb8, 0x9b, 0x00, 0x3e, 0xa2, 0xb9, 0xad, 0xbc, 0x72, 0x01, 0xc5, 0x3f, 0xa9, 0x00, 0x7e, 0x82,
+  0xba, 0x7d, 0xa4, 0x9c, 0x75, 0x15, 0x9b, 0x95, 0x8d, 0x53, 0xf6, 0x7e, 0x77, 0x18, 0xa0, 0xe3,
+  0xa7, 0x39, 0xe4, 0x8a, 0xe6, 0xf1, 0x83, 0xc7, 0x38, 0x1c, 0x52, 0xa8, 0x27, 0x20, 0x1f, 0x97,
+  0x3d, 0x2b, 0xa9, 0x55, 0xc8, 0x25, 0x87, 0x02, 0xb2, 0x94, 0xac, 0x6a, 0x9f, 0xb3, 0x19, 0xb7,
+  0x23, 0xf4, 0xeb, 0x5c, 0xce, 0xce, 0xdd, 0x7d, 0x73, 0x4f, 0x2b, 0xd7, 0x20, 0xfe, 0x15, 0xd4,
+  0x84, 0xc2, 0xe4, 0xf5, 0xf7, 0xff, 0x00, 0x3f, 0x5a, 0xce, 0x52, 0xe5, 0x36, 0x4f, 0x90, 0x6e,
+  0xcc, 0x1c, 0x63, 0x9e, 0xd5, 0xcc, 0x75, 0x18, 0x1f, 0xe1, 0x4a, 0x70, 0x7a, 0x9e, 0x4e, 0x47,
+  0x15, 0xd5, 0x85, 0xea, 0x07, 0xa0, 0xc5, 0x64, 0xe5, 0xca, 0x6a, 0x9f, 0x20, 0xc0, 0xa0, 0x67,
+  0xd0, 0xf4, 0xe2, 0xb9, 0x8e, 0xa0, 0x8e, 0xbc, 0x53, 0xb1, 0xed, 0x8c, 0xfb, 0xf5, 0xae, 0xaf,
+  0xb0, 0x03, 0xaf, 0x6a, 0xce, 0x52, 0xe5, 0x36, 0x4f, 0x94, 0x8c, 0x28, 0xc7, 0x6f, 0x6a, 0xe6,
+  0x1b, 0x38, 0xe5, 0xa9, 0xca, 0xa7, 0x6f, 0xcb, 0xc5, 0x75, 0x7b, 0x30, 0x38, 0x1c, 0x63, 0xd6,
+  0xb2, 0x94, 0xb9, 0x0d, 0x53, 0xe5, 0x18, 0xa9, 0xc8, 0x39, 0xcf, 0x35, 0xcc, 0x63, 0x9c, 0x7b,
+  0x67, 0x22, 0x9c, 0x3b, 0x8c, 0x63, 0xdb, 0x1d, 0x6b, 0xac, 0xf6, 0xe8, 0x79, 0xcf, 0xd6, 0xb3,
+  0x94, 0xb9, 0x0d, 0x93, 0xb1, 0x1e, 0xce, 0x71, 0xc8, 0x35, 0xcb, 0x6d, 0xe9, 0x8e, 0x98, 0xa9,
+  0x36, 0xe4, 0x82, 0x3b, 0x1c, 0x75, 0xae, 0xb3, 0x18, 0x03, 0xe9, 0x9e, 0x4f, 0xb5, 0x64, 0xe5,
+  0xec, 0xcd, 0x53, 0xb0, 0xcd, 0xa7, 0x07, 0x19, 0xfa, 0x57, 0x2a, 0x17, 0x03, 0x82, 0x41, 0xcd,
+  0x2e, 0xdd, 0xa3, 0xb9, 0x35, 0xd7, 0x8e, 0x09, 0xc0, 0xcd, 0x67, 0x29, 0x7b, 0x3f, 0x99, 0xb2,
+  0x63, 0x36, 0xf6, 0xef, 0x5c, 0xa6, 0xde, 0x49, 0x19, 0xc6, 0x39, 0xa5, 0x0a, 0x73, 0xd3, 0xf0,
+  0xe9, 0x9a, 0xeb, 0xc0, 0xc8, 0x24, 0x67, 0x8e, 0xf5, 0x94, 0xa5, 0xec, 0xbc, 0xee, 0x6a, 0x98,
+  0xcc, 0x67, 0x38, 0xeb, 0xdb, 0x15, 0xca, 0x04, 0xea, 0x49, 0xe7, 0xde, 0x9d, 0xb7, 0x03, 0x19,
+  0xf7, 0x27, 0x15, 0xd8, 0x6d, 0x04, 0x60, 0x9c, 0x8f, 0xd6, 0xb3, 0x94, 0xbd, 0x97, 0x9d, 0xcd,
+  0x53, 0xb9, 0x1b, 0x01, 0x8e, 0xbc, 0xd7, 0x28, 0x57, 0x91, 0x8f, 0xc3, 0xfc, 0x29, 0x76, 0x93,
+  0xd4, 0x7e, 0x35, 0xd8, 0x05, 0x18, 0xf4, 0x26, 0xb2, 0x72, 0xf6, 0x5e, 0x77, 0x36, 0x4e, 0xe3,
+  0x42, 0x92, 0x39, 0x04, 0x91, 0xde, 0xb9, 0x2d, 0x9c, 0x10, 0x3d, 0x78, 0xf4, 0xa7, 0x01, 0xc7,
+  0x03, 0x38, 0x35, 0xd9, 0x05, 0x1d, 0x0e, 0x05, 0x65, 0x29, 0x7b, 0x1f, 0x3b, 0x9a, 0xa7, 0xcc,
+  0x44, 0x07, 0x3c, 0x73, 0xc5, 0x72, 0x7b, 0x49, 0x00, 0x72, 0x73, 0xc5, 0x3b, 0x18, 0x20, 0xf4,
+  0x18, 0x3c, 0x9e, 0x6b, 0xb1, 0xef, 0x8e, 0x9f, 0x85, 0x67, 0x29, 0x7b, 0x1f, 0x3b, 0x9b, 0x27,
+  0xcc, 0x46, 0xbc, 0x8a, 0xe4, 0x42, 0xed, 0xdd, 0x9c, 0x1f, 0x5a, 0x51, 0xcf, 0x23, 0x27, 0x9a,
+  0xed, 0x02, 0x6d, 0x3d, 0x7e, 0x9c, 0x74, 0xac, 0xdc, 0xbd, 0x87, 0x9d, 0xcd, 0x53, 0xe7, 0x3f,
+  0xff, 0xd3, 0xbc, 0x53, 0x1e, 0x98, 0xf7, 0x15, 0xcd, 0x85, 0xe0, 0x67, 0x95, 0xa9, 0x31, 0xd8,
+  0xf3, 0xdb, 0xde, 0xba, 0x60, 0xa5, 0x57, 0x02, 0xb7, 0x72, 0xb9, 0xf9, 0x92, 0x7e, 0xc3, 0xce,
+  0xe4, 0x61, 0x03, 0x0e, 0xb8, 0xf4, 0xae, 0x73, 0x00, 0x1f, 0x98, 0xf1, 0xd7, 0x9a, 0x5d, 0xa7,
+  0x8e, 0x9c, 0x71, 0x8c, 0x57, 0x50, 0x17, 0xa0, 0x0b, 0x81, 0xfe, 0x4d, 0x66, 0xe4, 0x6a, 0x9f,
+  0xb0, 0xf3, 0xb8, 0xc0, 0xa4, 0x12, 0x71, 0x8f, 0x7f, 0x4a, 0xe6, 0xc0, 0x03, 0x3c, 0x53, 0x80,
+  0xc0, 0xc9, 0x15, 0xd4, 0x85, 0xfe, 0x13, 0xd7, 0xaf, 0xd2, 0xb2, 0x72, 0x36, 0x4f, 0xd8, 0xf9,
+  0xdc, 0x8f, 0x03, 0x1d, 0xc9, 0xeb, 0xcd, 0x73, 0x5b, 0x4f, 0x39, 0x18, 0x07, 0x8a, 0x78, 0x19,
+  0x07, 0x3c, 0xe6, 0xba, 0x80, 0xa0, 0x73, 0xc1, 0xac, 0xe5, 0x2b, 0x1a, 0xa7, 0xec, 0x7c, 0xee,
+  0x33, 0x66, 0x57, 0x01, 0x4f, 0xd3, 0xd2, 0xb9, 0xa2, 0x9e, 0xde, 0xd4, 0xfe, 0x41, 0x07, 0x18,
+  0x1d, 0x4d, 0x75, 0x2a, 0x32, 0x30, 0x00, 0xe9, 0x92, 0x01, 0xc5, 0x65, 0x29, 0x58, 0xd9, 0x3f,
+  0x65, 0xe7, 0x72, 0x20, 0xb8, 0x23, 0x3c, 0x7f, 0x4a, 0xe6, 0x54, 0x05, 0x39, 0xc1, 0xff, 0x00,
+  0x0a, 0x90, 0x0c, 0x8c, 0x73, 0x93, 0xef, 0xd2, 0xba, 0xa0, 0x3a, 0x73, 0xd3, 0x8a, 0xcd, 0xca,
+  0xc6, 0xa9, 0xfb, 0x2f, 0x3b, 0x91, 0xaa, 0xe0, 0xfa, 0x76, 0xeb, 0x9a, 0xe6, 0x00, 0xcf, 0x1c,
+  0x83, 0x4e, 0x2b, 0x91, 0x9e, 0x7a, 0xd7, 0x57, 0xb4, 0x0e, 0xc7, 0x91, 0x59, 0x4a, 0x5c, 0xa6,
+  0xa9, 0xfb, 0x3f, 0x3b, 0x91, 0xaa, 0x96, 0x3c, 0x93, 0x9c, 0x7a, 0x57, 0x32, 0x10, 0x11, 0x9c,
+  0x1f, 0x5c, 0x53, 0x82, 0x9c, 0xe0, 0x9c, 0x0f, 0xe9, 0x5d, 0x58, 0x5e, 0x46, 0x7f, 0x0a, 0xce,
+  0x52, 0xe5, 0x36, 0x4f, 0xd9, 0x91, 0xa8, 0xe0, 0x1c, 0xf3, 0xd4, 0xd7, 0x30, 0x46, 0x09, 0xc6,
+  0x47, 0xa6, 0x69, 0xd8, 0xce, 0x72, 0x2b, 0xad, 0xdb, 0xb7, 0x1c, 0x56, 0x52, 0x97, 0x21, 0xaa,
+  0x7c, 0x84, 0x78, 0x24, 0x73, 0x9c, 0xfa, 0x1a, 0xe5, 0xf1, 0xc6, 0x79, 0x27, 0xbd, 0x1b, 0x06,
+  0x4f, 0xaf, 0x7c, 0x9a, 0xeb, 0x80, 0xcf, 0x5c, 0xf3, 0x59, 0x4a, 0x5c, 0x86, 0xc9, 0xf2, 0x0d,
+  0xd9, 0x83, 0xc7, 0xd3, 0x00, 0xd7, 0x2b, 0xb4, 0xe0, 0xe4, 0x74, 0x18, 0xcd, 0x28, 0x1c, 0x0c,
+  0x63, 0xe8, 0x2b, 0xae, 0x0b, 0xf2, 0xf7, 0xf4, 0xc0, 0xac, 0xe5, 0x2f, 0x66, 0x6a, 0x9f, 0x28,
+  0x8a, 0xbf, 0x36, 0x3b, 0x77, 0xcd, 0x72, 0x58, 0xe0, 0x76, 0x20, 0x66, 0xa4, 0xdb, 0x83, 0xc0,
+  0x04, 0x9f, 0xd6, 0xba, 0xd0, 0xbd, 0x30, 0x33, 0x9e, 0xbc, 0xf2, 0x2b, 0x27, 0x2f, 0x66, 0x6c,
+  0x9f, 0x28, 0xcc, 0x90, 0x01, 0x18, 0xfe, 0xb5, 0xc9, 0xe3, 0x3d, 0x00, 0xc1, 0x3c, 0x91, 0x4f,
+  0x1c, 0x63, 0x3f, 0x85, 0x75, 0xfb, 0x46, 0x7d, 0xff, 0x00, 0x9d, 0x67, 0x29, 0x7b, 0x3f, 0x3b,
+  0x9a, 0xa7, 0x62, 0x30, 0x3f, 0x5f, 0x7a, 0xe4, 0xc2, 0xf3, 0xcf, 0xe5, 0x8a, 0x7e, 0x02, 0x92,
+  0x39, 0xc1, 0x1c, 0xd7, 0x60, 0xa0, 0x90, 0x31, 0xd7, 0xdf, 0xbd, 0x65, 0x29, 0x7b, 0x2f, 0x3b,
+  0x9a, 0xa7, 0x61, 0x81, 0x41, 0xc0, 0xec, 0x3d, 0x2b, 0x92, 0xd8, 0x07, 0x5a, 0x50, 0xb8, 0xc0,
+  0xc9, 0xfc, 0x7b, 0xd7, 0x64, 0x00, 0xef, 0x9f, 0xa9, 0xe6, 0xb3, 0x72, 0xf6, 0x5e, 0x77, 0x36,
+  0x4c, 0x60, 0x53, 0xdf, 0xad, 0x72, 0x05, 0x7d, 0x8f, 0xd0, 0xd3, 0x94, 0x0c, 0x11, 0x8c, 0x8a,
+  0xec, 0xb6, 0xe0, 0x8f, 0xaf, 0x4a, 0xca, 0x52, 0xf6, 0x3e, 0x77, 0x35, 0x4c, 0x6e, 0xde, 0x71,
+  0xce, 0x3d, 0xeb, 0x91, 0x03, 0xa7, 0x07, 0xfc, 0x28, 0x03, 0x2b, 0xc0, 0xc0, 0xf7, 0xef, 0x5d,
+  0xa0, 0x4c, 0x1c, 0x9f, 0xe5, 0x59, 0xca, 0x5e, 0xc7, 0xce, 0xe6, 0xc9, 0xdc, 0x66, 0xde, 0x70,
+  0x33, 0x9c, 0x76, 0xef, 0x5c, 0x7e, 0x33, 0x83, 0x8e, 0x33, 0x81, 0x93, 0x4f, 0x00, 0xe4, 0x77,
+  0x1d, 0xb3, 0x5d, 0x89, 0x00, 0x91, 0xd4, 0x1e, 0xd8, 0xac, 0xa5, 0x2f, 0x61, 0xe7, 0x73, 0x54,
+  0xf9, 0x84, 0xdb, 0x91, 0xd8, 0x71, 0x5c, 0x71, 0x8f, 0x3c, 0x7a, 0x76, 0x35, 0x26, 0xd3, 0x82,
+  0x08, 0xe4, 0xf3, 0xd6, 0xbb, 0x3d, 0xbd, 0x3f, 0xc2, 0xb3, 0x72, 0xf6, 0x1e, 0x77, 0x36, 0x4f,
+  0x98, 0x8c, 0x2e, 0xdc, 0x01, 0x8f, 0xcb, 0xad, 0x71, 0xe1, 0x79, 0xc6, 0x47, 0xe1, 0x4f, 0x03,
+  0x39, 0xef, 0x8a, 0xed, 0x06, 0x00, 0xc5, 0x64, 0xe5, 0xf5, 0x7f, 0x3b, 0x9a, 0xa7, 0xcc, 0x7f,
+  0xff, 0xd4, 0xf2, 0x65, 0xf1, 0xef, 0x89, 0xb8, 0x63, 0xa9, 0xf7, 0xff, 0x00, 0x9e, 0x11, 0xff,
+  0x00, 0xf1, 0x35, 0x12, 0xf8, 0xb7, 0x5c, 0xc1, 0xff, 0x00, 0x4e, 0xe7, 0xfe, 0xb9, 0x27, 0xff,
+  0x00, 0x13, 0x58, 0x03, 0x38, 0xf5, 0xa9, 0x14, 0x63, 0xa9, 0xa2, 0xe7, 0x2a, 0xc0, 0xe1, 0x63,
+  0xb5, 0x38, 0xfd, 0xc8, 0xea, 0xd7, 0xc7, 0x7e, 0x24, 0xc6, 0xef, 0xed, 0x13, 0xff, 0x00, 0x7e,
+  0x23, 0xe3, 0xff, 0x00, 0x1d, 0xa8, 0x57, 0xc4, 0xda, 0xc6, 0x00, 0xfb, 0x60, 0x3e, 0xc6, 0x24,
+  0xff, 0x00, 0x0a, 0xc1, 0x5c, 0x74, 0xc7, 0x1d, 0xaa, 0x75, 0xe7, 0x93, 0xc8, 0x34, 0x0d, 0x60,
+  0xb0, 0xd1, 0xda, 0x9c, 0x7e, 0xe4, 0x74, 0xc9, 0xe3, 0x6f, 0x10, 0x9e, 0xba, 0x86, 0x3d, 0x33,
+  0x0c, 0x7f, 0xfc, 0x4d, 0x44, 0x3c, 0x45, 0xaa, 0xf7, 0xbb, 0x18, 0xff, 0x00, 0xae, 0x69, 0xfe,
+  0x15, 0x8a, 0xa7, 0x3d, 0xc7, 0x03, 0x1f, 0x4a, 0x99, 0x14, 0x8f, 0xaf, 0x34, 0xac, 0x81, 0x60,
+  0xf0, 0xeb, 0x6a, 0x71, 0xfb, 0x91, 0xd1, 0xaf, 0x8c, 0xb5, 0xf2, 0xbc, 0xdf, 0xf4, 0xff, 0x00,
+  0xa6, 0x31, 0xff, 0x00, 0xf1, 0x35, 0x10, 0xd7, 0xf5, 0x3c, 0x81, 0xf6, 0x9c, 0x71, 0xff, 0x00,
+  0x3c, 0xd4, 0x7f, 0x4a, 0xc6, 0x41, 0xf2, 0x01, 0xeb, 0xde, 0xac, 0x2e, 0x73, 0x8c, 0xe3, 0x27,
+  0xa0, 0x19, 0xa3, 0x95, 0x76, 0x1a, 0xc2, 0x61, 0xd6, 0xd4, 0xd7, 0xdc, 0x8e, 0x88, 0x78, 0xb7,
+  0x5d, 0x1f, 0xf2, 0xfd, 0xed, 0xfe, 0xa5, 0x3f, 0xf8, 0x9a, 0x84, 0x6b, 0x57, 0xff, 0x00, 0xf3,
+  0xf3, 0xc8, 0xc7, 0xf0, 0x2f, 0xf8, 0x56, 0x42, 0x05, 0x24, 0x31, 0xcd, 0x4e, 0x98, 0xc7, 0x1d,
+  0x00, 0xe0, 0xe2, 0x97, 0x24, 0x7b, 0x0d, 0x61, 0x68, 0x2d, 0xa0, 0xbe, 0xe4, 0x6f, 0x2f, 0x8a,
+  0x75, 0xa6, 0x18, 0x37, 0xbf, 0xf9, 0x09, 0x3f, 0xf8, 0x9a, 0x89, 0x75, 0x5b, 0xe6, 0x3f, 0xeb,
+  0xfa, 0x76, 0xda, 0x3f, 0xc2, 0xb3, 0x38, 0x38, 0x24, 0x8e, 0x7d, 0xaa, 0xc2, 0x92, 0x39, 0xeb,
+  0x8e, 0x68, 0xe4, 0x8f, 0x60, 0x58, 0x6a, 0x2b, 0x68, 0x2f, 0xb9, 0x1b, 0x6b, 0xe2, 0x7d, 0x5c,
+  0x81, 0xfe, 0x97, 0x91, 0xe9, 0xe5, 0xa7, 0xf8, 0x54, 0x6b, 0xa8, 0x5d, 0xb6, 0x47, 0x9b, 0xc7,
+  0x71, 0xb4, 0x7f, 0x85, 0x66, 0xa6, 0x08, 0xf4, 0xcd, 0x4e, 0xa0, 0xe3, 0xdb, 0x1e, 0x94, 0xbd,
+  0x9c, 0x3b, 0x21, 0xac, 0x3d, 0x15, 0xb4, 0x17, 0xdc, 0x8d, 0x91, 0xe2, 0x1d, 0x53, 0xa1, 0xbb,
+  0xc1, 0xeb, 0xfe, 0xad, 0x7a, 0xfe, 0x55, 0x10, 0xbf, 0xb8, 0xef, 0x27, 0xe6, 0xa2, 0xa9, 0x21,
+  0x04, 0x0e, 0xd8, 0xe6, 0xa6, 0x5e, 0x80, 0x36, 0x07, 0x34, 0xbd, 0x94, 0x3f, 0x95, 0x7d, 0xc3,
+  0x54, 0x29, 0x2d, 0xa2, 0xbe, 0xe4, 0x6b, 0xae, 0xbd, 0xa9, 0x31, 0xff, 0x00, 0x8f, 0x8e, 0xdc,
+  0xe5, 0x17, 0x9f, 0xd2, 0xa2, 0x59, 0xe5, 0x2d, 0xcb, 0xf3, 0xdc, 0xe0, 0x55, 0x31, 0xc8, 0xc6,
+  0x7a, 0x75, 0x35, 0x3a, 0x9c, 0x0c, 0x0c, 0x64, 0x1f, 0x4e, 0x28, 0xf6, 0x34, 0xff, 0x00, 0x95,
+  0x7d, 0xc0, 0xa8, 0xd3, 0x5b, 0x45, 0x7d, 0xc6, 0xaa, 0x6b, 0x5a, 0x89, 0x18, 0x33, 0xe7, 0xb7,
+  0xfa, 0xb5, 0xff, 0x00, 0x0a, 0x80, 0x3b, 0x9c, 0x06, 0x3c, 0x0e, 0xf5, 0x04, 0x67, 0x38, 0x1d,
+  0x47, 0x7e, 0x7a, 0xd4, 0xd1, 0x8c, 0x70, 0x47, 0xeb, 0x4b, 0xd8, 0xd2, 0x5f, 0x65, 0x7d, 0xc3,
+  0x54, 0xa9, 0xad, 0xa2, 0xbe, 0xe3, 0x49, 0x35, 0x4b, 0xe2, 0x7f, 0xd7, 0x13, 0xef, 0xb0, 0x71,
+  0x50, 0x2a, 0x86, 0x24, 0x71, 0xfe, 0x15, 0x0a, 0x71, 0x9f, 0xeb, 0x53, 0x8c, 0x8e, 0xb8, 0xc6,
+  0x3d, 0x68, 0x54, 0x29, 0x2f, 0xb2, 0xbe, 0xe4, 0x35, 0x4e, 0x0b, 0x64, 0x8d, 0x05, 0xd4, 0x6e,
+  0xcf, 0xde, 0x9b, 0x8c, 0x7a, 0x0f, 0xf0, 0xa8, 0x44, 0x28, 0x71, 0xb9, 0x41, 0x3f, 0x53, 0x4d,
+  0x04, 0x1e, 0x0f, 0x53, 0xe8, 0x2a, 0x55, 0xea, 0x48, 0xef, 0x49, 0x61, 0xe8, 0xad, 0xa0, 0xbe,
+  0xe4, 0x0a, 0x9c, 0x57, 0x42, 0xf2, 0x5e, 0xce, 0x0f, 0xfa, 0xc1, 0xeb, 0xd0, 0x7f, 0x85, 0x40,
+  0x2d, 0x61, 0xc6, 0x3c, 0xbe, 0xbe, 0xe4, 0xd0, 0xa3, 0xfb, 0xdf, 0x88, 0xf5, 0xa9, 0x95, 0x49,
+  0xc0, 0x03, 0xbf, 0xeb, 0x42, 0xc3, 0x51, 0x5b, 0x41, 0x7d, 0xc8, 0x7c, 0x91, 0xec, 0x5b, 0x5b,
+  0x99, 0x31, 0xf7, 0xb9, 0xf5, 0xdb, 0x50, 0x0b, 0x1b, 0x62, 0x41, 0xf2, 0xf3, 0xea, 0x72, 0x69,
+  0xc8, 0x38, 0xf5, 0xc8, 0xc6, 0x45, 0x4c, 0xa3, 0x8c, 0x76, 0x14, 0x96, 0x16, 0x82, 0xda, 0x0b,
+  0xee, 0x43, 0xe5, 0x5d, 0x8b, 0x5e, 0x63, 0x12, 0x4f, 0x53, 0xdf, 0x8c, 0x54, 0x0b, 0xa6, 0x59,
+  0x64, 0x16, 0x8b, 0xaf, 0x3f, 0x78, 0xff, 0x00, 0x8d, 0x48, 0xa7, 0x9e, 0xa6, 0xa7, 0x41, 0xd0,
+  0x63, 0xaf, 0xb5, 0x0b, 0x0b, 0x41, 0x6d, 0x05, 0xf7, 0x21, 0xd8, 0x99, 0x49, 0x62, 0x33, 0xce,
+  0x2a, 0x04, 0xd1, 0xec, 0x33, 0x8f, 0x20, 0x7d, 0x77, 0xb7, 0xf8, 0xd4, 0xe0, 0x64, 0x8c, 0x71,
+  0x93, 0xda, 0xa7, 0x8c, 0x73, 0x90, 0x47, 0xa7, 0x5a, 0x4b, 0x09, 0x87, 0x5b, 0x53, 0x5f, 0x72,
+  0x01, 0xeb, 0x1a, 0xfa, 0x0c, 0xf5, 0xce, 0x6a, 0x05, 0xd1, 0x34, 0xe3, 0x9f, 0xf4, 0x6c, 0xfa,
+  0x65, 0xdb, 0xfc, 0x6a, 0xd2, 0x73, 0x8e, 0x83, 0xf0, 0xa9, 0x54, 0x12, 0x0e, 0x47, 0x7f, 0x4f,
+  0x7a, 0x4b, 0x07, 0x87, 0x5b, 0x53, 0x8f, 0xdc, 0x87, 0x76, 0x48, 0xb6, 0xb0, 0x13, 0xc2, 0x9c,
+  0xfd, 0x4d, 0x56, 0x1a, 0x06, 0x96, 0xc7, 0xfe, 0x3d, 0x46, 0x33, 0xd0, 0xc8, 0xdf, 0xe3, 0x57,
+  0x50, 0xee, 0xed, 0xd2, 0xa6, 0x07, 0x3d, 0x0f, 0x23, 0xd0, 0xd0, 0xb0, 0x58, 0x65, 0xb5, 0x38,
+  0xfd, 0xc8, 0x7c, 0xd2, 0xee, 0x22, 0xd9, 0xdb, 0x9c, 0x0f, 0x2f, 0x3c, 0x63, 0xef, 0x1a, 0x80,
+  0x78, 0x6f, 0x48, 0xce, 0x45, 0x9f, 0xfe, 0x44, 0x7f, 0xf1, 0xab, 0xcb, 0xf2, 0xf1, 0x9e, 0x7b,
+  0xf1, 0x56, 0x14, 0x64, 0x83, 0x9c, 0x0a, 0x4b, 0x03, 0x85, 0x5b, 0x53, 0x8f, 0xdc, 0x83, 0x9e,
+  0x5d, 0xc8, 0xd3, 0x4d, 0xb5, 0xed, 0x18, 0x19, 0xff, 0x00, 0x68, 0xff, 0x00, 0x8d, 0x56, 0x1e,
+  0x16, 0xd1, 0xba, 0x1b, 0x30, 0x7d, 0xc4, 0xaf, 0xfe, 0x35, 0xa4, 0x84, 0x8c, 0xe7, 0xa7, 0xbd,
+  0x4c, 0xa7, 0xd4, 0xf3, 0x42, 0xc0, 0xe1, 0x56, 0xd4, 0xa3, 0xf7, 0x2f, 0xf2, 0x1f, 0xb4, 0x9f,
+  0x76, 0x7f, 0xff, 0xd5, 0xf0, 0x11, 0x83, 0x8f, 0xd4, 0x54, 0xaa, 0xb9, 0x19, 0xe8, 0x71, 0xeb,
+  0xfa, 0xd3, 0x14, 0xe0, 0xe7, 0x35, 0x2a, 0x6d, 0x3e, 0x94, 0x01, 0x2a, 0x63, 0x83, 0xc6, 0x73,
+  0x53, 0xaf, 0xbe, 0x48, 0xf4, 0xf6, 0xa8, 0x23, 0x50, 0x57, 0x04, 0x81, 0xf4, 0xa9, 0xd0, 0x91,
+  0x9e, 0x9f, 0x85, 0x00, 0x4e, 0x83, 0x93, 0xe9, 0x8e, 0x3b, 0xe3, 0x15, 0x32, 0xe3, 0xdb, 0x8c,
+  0x54, 0x2a, 0x30, 0x77, 0x0c, 0x93, 0xed, 0x53, 0x21, 0x04, 0x8e, 0xd8, 0xed, 0xe8, 0x28, 0x02,
+  0x55, 0xeb, 0x90, 0x06, 0x7b, 0x8a, 0xb0, 0xbd, 0x32, 0x48, 0xeb, 0x50, 0x26, 0x48, 0xe3, 0x8f,
+  0x4c, 0x54, 0xf1, 0x8c, 0x8f, 0x7e, 0xe0, 0x7f, 0x4a, 0x00, 0x9d, 0x4e, 0x47, 0x27, 0xe9, 0x52,
+  0xa1, 0x27, 0xef, 0x75, 0xe9, 0x50, 0xaf, 0x23, 0x26, 0xac, 0x46, 0x49, 0xc0, 0x39, 0xe9, 0xcd,
+  0x00, 0x3d, 0x01, 0xcf, 0x5a, 0xb0, 0xa5, 0x41, 0xc6, 0x3f, 0x0f, 0x4a, 0x85, 0x58, 0x77, 0xfa,
+  0x66, 0xa6, 0x51, 0xcf, 0x1c, 0x00, 0x7d, 0x7a, 0xd0, 0x04, 0xea, 0x72, 0x3f, 0x95, 0x4e, 0x8d,
+  0x8f, 0x5f, 0x7a, 0x81, 0x07, 0x3d, 0xb2, 0x7b, 0xfa, 0x54, 0xc0, 0x8c, 0x8c, 0xe0, 0x83, 0xeb,
+  0x40, 0x13, 0x00, 0x78, 0x07, 0xa9, 0xf5, 0xa9, 0xd0, 0xf4, 0x20, 0x72, 0x3b, 0x81, 0x50, 0x47,
+  0xcf, 0x1d, 0xaa, 0x68, 0xce, 0x36, 0x92, 0x7a, 0x73, 0x40, 0x16, 0x13, 0xe5, 0x39, 0x1d, 0xbb,
+  0x13, 0xde, 0xa6, 0x5c, 0xe4, 0x77, 0xf6, 0x3e, 0xb5, 0x02, 0x31, 0x3e, 0x87, 0xd2, 0xa7, 0x40,
+  0x36, 0xe4, 0x74, 0xe7, 0x18, 0xf7, 0xa0, 0x09, 0x90, 0x92, 0x48, 0xe9, 0xc5, 0x4e, 0xb8, 0xff,
+  0x00, 0xf5, 0x9e, 0x95, 0x5d, 0x47, 0x03, 0x03, 0x3c, 0xd5, 0x85, 0xc1, 0xc1, 0xed, 0x9c, 0x73,
+  0xda, 0x80, 0x26, 0x41, 0xc7, 0x3c, 0xf3, 0xcd, 0x4c, 0x01, 0x0a, 0x00, 0x07, 0x27, 0xd2, 0xa0,
+  0x50, 0x31, 0x93, 0x8e, 0x7a, 0x76, 0xcd, 0x4e, 0xa7, 0xf3, 0x3c, 0x7d, 0x28, 0x02, 0x75, 0x27,
+  0x6e, 0x46, 0x49, 0xef, 0xc6, 0x6a, 0x55, 0x23, 0xa1, 0x22, 0xa2, 0x42, 0x39, 0x1c, 0x1c, 0x60,
+  0x74, 0xa9, 0x51, 0xb6, 0xf2, 0x06, 0x7d, 0x30, 0x68, 0x02, 0x75, 0x04, 0x9c, 0x63, 0x1f, 0x8d,
+  0x4e, 0xa4, 0x1c, 0x1e, 0x09, 0xee, 0x05, 0x43, 0x10, 0x3c, 0x64, 0xf5, 0xf4, 0xa9, 0x94, 0x67,
+  0x8c, 0x1c, 0x67, 0x9c, 0x50, 0x04, 0xa9, 0x9c, 0x1e, 0x78, 0xc7, 0x06, 0xac, 0x27, 0x41, 0xd4,
+  0x0c, 0xd4, 0x09, 0x92, 0x79, 0x1d, 0x7a, 0xd4, 0xeb, 0x9c, 0x8e, 0x28, 0x02, 0x60, 0x07, 0x03,
+  0xa8, 0xf5, 0xa9, 0xd4, 0x71, 0x9e, 0x9f, 0xca, 0xa0, 0x5c, 0xf5, 0x5f, 0x5f, 0xc4, 0x54, 0xaa,
+  0x48, 0xf4, 0x00, 0xd0, 0x05, 0x85, 0xe0, 0x60, 0x63, 0x6e, 0x31, 0x53, 0x2e, 0xd2, 0x08, 0xcf,
+  0xbe, 0x2a, 0x15, 0xc0, 0x1c, 0x1c, 0xfd, 0x2a, 0x70, 0x31, 0xc1, 0xc0, 0xf7, 0xa0, 0x09, 0xe3,
+  0xc9, 0x23, 0xb7, 0xe1, 0x52, 0x00, 0x4f, 0x39, 0x1c, 0xfb, 0xd4, 0x49, 0x8e, 0x39, 0x1c, 0x75,
+  0xc5, 0x4c, 0x83, 0x27, 0xa9, 0x22, 0x80, 0x26, 0x53, 0xc0, 0x3d, 0xc8, 0xed, 0x53, 0x2a, 0xf6,
+  0x23, 0x1e, 0x82, 0xa2, 0x43, 0xdb, 0x3f, 0xa5, 0x4b, 0x19, 0xe7, 0x6e, 0x73, 0x9a, 0x00, 0xb0,
+  0x84, 0x6d, 0xe7, 0xb8, 0xf5, 0xa9, 0x50, 0xe0, 0x0e, 0x83, 0xdc, 0xd4, 0x28, 0x0f, 0x6e, 0xa0,
+  0x76, 0xf5, 0xa9, 0xd4, 0xfc, 0xa3, 0x92, 0x07, 0xeb, 0x40, 0x13, 0x29, 0x39, 0xce, 0x08, 0xf7,
+  0x35, 0x32, 0xf6, 0xc0, 0xe3, 0x1c, 0xd4, 0x31, 0xe7, 0xa7, 0x07, 0xda, 0xa6, 0x55, 0xdb, 0x81,
+  0xc5, 0x00, 0x7f, 0xff, 0xd9,
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+// An abstract, forward-only stream of bytes that decoders pull image data from
+class ByteSource
+{
+public:
+  virtual ~ByteSource() = default;
+
+  // Number of bytes left to read
+  virtual uint32_t remaining() const = 0;
+
+  // Read up to len bytes into dest. Returns the number of bytes actually
+  // read, which is only less than len when the source runs out.
+  virtual uint32_t read(uint8_t* dest, uint32_t len) = 0;
+
+  // Throw away the rest of the data
+  virtual void discard() = 0;
+
+  // The remaining bytes, if the source holds them in addressable memory
+  virtual const uint8_t* data() const
+  {
+    return nullptr;
+  }
+};
+
+// Read exactly len bytes, returning false if the source ran out first
+inline bool readFully(ByteSource& src, uint8_t* dest, uint32_t len)
+{
+  return src.read(dest, len) == len;
+}
+
+// Byte source over a block of memory (RAM or memory mapped flash)
+class MemoryByteSource : public ByteSource
+{
+public:
+  MemoryByteSource(const uint8_t* data, uint32_t size)
+    : data_{data}
+    , size_{size}
+    , pos_{0}
+  { }
+
+  virtual uint32_t remaining() const override
+  {
+    return size_ - pos_;
+  }
+
+  virtual uint32_t read(uint8_t* dest, uint32_t len) override
+  {
+    uint32_t count = std::min(len, remaining());
+    memcpy(dest, data_ + pos_, count);
+    pos_ += count;
+    return count;
+  }
+
+  virtual void discard() override
+  {
+    pos_ = size_;
+  }
+
+  virtual const uint8_t* data() const override
+  {
+    return data_ + pos_;
+  }
+
+private:
+  const uint8_t* data_;
+  uint32_t size_;
+  uint32_t pos_;
+};
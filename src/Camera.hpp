@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ByteSource.hpp"
+
+#include <stdint.h>
+
+// Pixel formats a capture can come in. The values are the Arducam's own
+// (CAM_IMAGE_PIX_FMT), which is what spool headers store and
+// tools/pinky_link.py sends.
+enum class CaptureFormat : uint8_t
+{
+  JPG = 1,
+  RGB565 = 2,
+  YUV = 3
+};
+
+// What the snap path needs from a camera
+class Camera
+{
+public:
+  virtual ~Camera() = default;
+  // Capture a picture into the camera's own buffer
+  virtual bool takePicture(CaptureFormat format) = 0;
+  // Size and format of the picture last taken
+  virtual int width() const = 0;
+  virtual int height() const = 0;
+  virtual CaptureFormat format() const = 0;
+  // The picture last taken, read out of the camera as it is consumed.
+  // discard() drops whatever is left of it.
+  virtual ByteSource& picture() = 0;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+#include <array>
+
+// CRC-32 as in zlib (and PNG). Pass 0 to start, or the CRC so far to
+// continue it over more data.
+inline uint32_t crc32(uint32_t crc, const uint8_t* data, uint32_t len)
+{
+  static const std::array<uint32_t, 256> table = []()
+  {
+    std::array<uint32_t, 256> t;
+    for (uint32_t i=0; i < 256; ++i)
+    {
+      uint32_t c = i;
+      for (int k=0; k < 8; ++k)
+      {
+        c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+      }
+      t[i] = c;
+    }
+    return t;
+  }();
+
+  crc = ~crc;
+  for (uint32_t i=0; i < len; ++i)
+  {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
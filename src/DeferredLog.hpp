@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Hal.hpp"
+#include "SpscRing.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+
+// Logging for the snap path that never waits on USB. A message is recorded
+// as its id and up to LogMaxArgs integers into a ring per core (so both
+// cores can log without locking), and only printed, or sent as binary for
+// tools/pinky_log.py to expand, when the main loop is idle. Nothing is
+// formatted where it's logged. If a ring fills up before it's drained,
+// further messages are counted and dropped.
+//
+// Messages are listed once, in PINKY_LOG_MESSAGES, with a printf format
+// that takes only integers. Their position is their id, so new ones go at
+// the end. tools/pinky_log.py reads the list out of this file.
+//
+// Build with PINKY_DEFERRED_LOG=0 to print each message where it's logged.
+#ifndef PINKY_DEFERRED_LOG
+#define PINKY_DEFERRED_LOG 1
+#endif
+
+#define PINKY_LOG_MESSAGES(X) \
+  X(JpegDecoding, "Decoding JPG formatted image with size %u bytes") \
+  X(JpegHeaderError, "JPEG header error: %d") \
+  X(JpegBadScanType, "Bad scan type: %d") \
+  X(JpegScanType, "Scan type: %d") \
+  X(JpegDecodeError, "JPEG decode error: %d") \
+  X(JpegNoRestarts, "No restart markers to split the JPG decode at") \
+  X(JpegRestartsUnsplit, "Restart interval %d does not split into strips") \
+  X(JpegStrips, "Decoding JPG on %d cores: %d strips of %d MCU rows") \
+  X(JpegStripHeaderError, "JPEG header error") \
+  X(JpegStripError, "JPEG decode error in strip") \
+  X(ImageEndedEarly, "Image data ended early!") \
+  X(BadImageSize, "Bad image size! Got %u bytes, expected %u bytes") \
+  X(OddImageSize, "Image dims must be even.") \
+  X(PictureConverted, "Picture converted in %u ms") \
+  X(NoSourceCache, "No room to keep a %u byte source image for rerender") \
+  X(TakingPhoto, "Taking photo...") \
+  X(FetchingPhoto, "Fetching photo...") \
+  X(ScratchTooSmall, "Scratch arena too small for %u bytes, using the heap") \
+  X(FrameEndedEarly, "Frame data ended %u bytes early") \
+  X(DisplayRunningLong, "Display operation is running long.") \
+  X(SpoolTooBig, "Can't spool %u bytes to slot %d") \
+  X(SpoolEndedEarly, "Capture ended early, spooled %u of %u bytes") \
+  X(FrameCompressed, "Frame compressed %u -> %u bytes") \
+  X(FrameTooBig, "Can't fit a %u byte frame in slot %d") \
+  X(FrameOverflowed, "Frame didn't fit in slot %d") \
+  X(SpoolingPhoto, "Spooling photo...") \
+  X(Spooled, "Spooled %u bytes to slot %d in %u ms") \
+  X(AllocationGuardHit, "Allocation guard: %u allocations in a guarded scope, first %u bytes from 0x%08x") \
+  X(LinkReceiving, "Receiving %u byte %dx%d image...") \
+  X(UploadRendered, "Upload rendered in %u ms") \
+  X(LinkDroppedFrames, "Link dropped %u bad frames")
+
+enum class LogMessage : uint16_t
+{
+#define PINKY_LOG_ENUM(name, format) name,
+  PINKY_LOG_MESSAGES(PINKY_LOG_ENUM)
+#undef PINKY_LOG_ENUM
+  Count
+};
+
+inline const char* logFormat(LogMessage message)
+{
+  static const char* const formats[] =
+  {
+#define PINKY_LOG_FORMAT(name, format) format,
+    PINKY_LOG_MESSAGES(PINKY_LOG_FORMAT)
+#undef PINKY_LOG_FORMAT
+  };
+  return (uint16_t)message < (uint16_t)LogMessage::Count ? formats[(uint16_t)message] : "Unknown log message %u";
+}
+
+constexpr int LogMaxArgs = 4;
+constexpr uint32_t LogEntriesPerCore = 64;
+
+struct LogEntry
+{
+  uint32_t timeUs;
+  LogMessage message;
+  uint8_t core;
+  uint8_t argCount;
+  uint32_t args[LogMaxArgs];
+};
+
+// The entry's text, as printf would have printed its message
+inline int formatLogEntry(const LogEntry& entry, char* text, size_t size)
+{
+  const uint32_t* a = entry.args;
+  if ((uint16_t)entry.message >= (uint16_t)LogMessage::Count)
+  {
+    return snprintf(text, size, "Unknown log message %u", (unsigned)entry.message);
+  }
+  return snprintf(text, size, logFormat(entry.message), a[0], a[1], a[2], a[3]);
+}
+
+// Prints the entry on its own line, with the time and core it was logged on
+inline void printLogEntry(const LogEntry& entry)
+{
+  char text[128];
+  formatLogEntry(entry, text, sizeof(text));
+  printf("[%lu.%03lu core%u] %s\n", (unsigned long)(entry.timeUs / 1000), (unsigned long)(entry.timeUs % 1000), entry.core, text);
+}
+
+class DeferredLog
+{
+public:
+  template <typename... Args>
+  static void log(LogMessage message, Args... args)
+  {
+    static_assert(sizeof...(Args) <= LogMaxArgs, "Too many arguments for a log message");
+    uint core = halCoreNum();
+    uint32_t values[LogMaxArgs] = {(uint32_t)args...};
+#if PINKY_DEFERRED_LOG
+    LogEntry* entry = rings_[core].writeSlot();
+    if (!entry)
+    {
+      ++dropped_[core];
+      return;
+    }
+#else
+    LogEntry storage;
+    LogEntry* entry = &storage;
+#endif
+    entry->timeUs = (uint32_t)halTimeUs();
+    entry->message = message;
+    entry->core = (uint8_t)core;
+    entry->argCount = (uint8_t)sizeof...(Args);
+    std::copy(values, values + LogMaxArgs, entry->args);
+#if PINKY_DEFERRED_LOG
+    rings_[core].commitWrite();
+#else
+    printLogEntry(*entry);
+#endif
+  }
+
+  // Hand up to max of the oldest entries, both cores merged by time, to f
+  // and let them go, returning how many there were. Only ever call from
+  // one core (the main loop's).
+  template <typename F>
+  static uint32_t drain(F&& f, uint32_t max = UINT32_MAX)
+  {
+    uint32_t count = 0;
+#if PINKY_DEFERRED_LOG
+    for (; count < max; ++count)
+    {
+      const LogEntry* oldest = nullptr;
+      int oldestCore = 0;
+      for (int core=0; core < 2; ++core)
+      {
+        const LogEntry* entry = rings_[core].readSlot();
+        if (entry && (!oldest || (int32_t)(entry->timeUs - oldest->timeUs) < 0))
+        {
+          oldest = entry;
+          oldestCore = core;
+        }
+      }
+      if (!oldest)
+      {
+        break;
+      }
+      f(*oldest);
+      rings_[oldestCore].commitRead();
+    }
+#else
+    (void)f;
+    (void)max;
+#endif
+    return count;
+  }
+
+  // Entries waiting to be drained
+  static uint32_t pending()
+  {
+#if PINKY_DEFERRED_LOG
+    return rings_[0].size() + rings_[1].size();
+#else
+    return 0;
+#endif
+  }
+
+  // Messages lost to a full ring, ever
+  static uint32_t dropped()
+  {
+#if PINKY_DEFERRED_LOG
+    return dropped_[0] + dropped_[1];
+#else
+    return 0;
+#endif
+  }
+
+#if PINKY_DEFERRED_LOG
+private:
+  static inline LogEntry slots_[2][LogEntriesPerCore];
+  static inline SpscRing<LogEntry> rings_[2] = {{slots_[0], LogEntriesPerCore}, {slots_[1], LogEntriesPerCore}};
+  static inline uint32_t dropped_[2] = {0, 0};
+#endif
+};
+
+// PINKY_LOG(BadImageSize, got, expected)
+#define PINKY_LOG(message, ...) DeferredLog::log(LogMessage::message, ##__VA_ARGS__)
@@ -0,0 +1,664 @@
+#pragma once
+
+#include "ByteSource.hpp"
+#include "DeferredLog.hpp"
+#include "FrameCodec.hpp"
+#include "Image.hpp"
+#include "ImageView.hpp"
+#include "IndexedColor.hpp"
+#include "ScratchArena.hpp"
+#include "Scheduler.hpp"
+
+#include <hardware/flash.h>
+#include <hardware/sync.h>
+#include <pico/stdlib.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// Flash layout, counted back from the end of flash so the firmware image
+// can grow without moving anything:
+//
+//   [0, FlashImageBudget)                  firmware image
+//   [FlashFrameOffset, FlashSpoolOffset)   frame gallery, FlashFrameSlots slots
+//   [end - FlashSpoolSize, end)            capture spool, FlashSpoolSlots slots
+//
+// The image has to stay under PINKY_FLASH_IMAGE_BUDGET, which the firmware
+// link checks against __flash_binary_end (see src/FlashBudget.ld).
+#ifndef PINKY_FLASH_IMAGE_BUDGET
+#define PINKY_FLASH_IMAGE_BUDGET (1024 * 1024)
+#endif
+
+constexpr uint32_t FlashImageBudget = PINKY_FLASH_IMAGE_BUDGET;
+
+constexpr int FlashSpoolSlots = 4;
+constexpr uint32_t FlashSpoolSlotSize = 512 * 1024;
+constexpr uint32_t FlashSpoolSize = FlashSpoolSlots * FlashSpoolSlotSize;
+constexpr uint32_t FlashSpoolOffset = PICO_FLASH_SIZE_BYTES - FlashSpoolSize;
+
+constexpr uint32_t roundUpToSector(uint32_t size)
+{
+  return (size + FLASH_SECTOR_SIZE - 1) & ~(FLASH_SECTOR_SIZE - 1);
+}
+
+// Gallery slots fit the largest frame a supported panel takes (the E673's
+// 800x480, packed 4 bits a pixel) whether it compresses or not, so a frame
+// that doesn't compress can still be kept and shown straight out of XIP
+constexpr uint32_t FlashLargestFrameSize = 800 * 480 / 2;
+constexpr int FlashFrameSlots = 5;
+constexpr uint32_t FlashFrameSlotSize = roundUpToSector(FLASH_PAGE_SIZE + frameCodecMaxSize(FlashLargestFrameSize));
+constexpr uint32_t FlashFrameOffset = FlashSpoolOffset - FlashFrameSlots * FlashFrameSlotSize;
+
+static_assert(FlashSpoolSize + FlashFrameSlots * FlashFrameSlotSize <= PICO_FLASH_SIZE_BYTES, "Flash layout doesn't fit in flash");
+static_assert(FlashFrameOffset >= FlashImageBudget, "Flash layout overlaps the firmware image budget");
+static_assert(FlashSpoolSlotSize % FLASH_BLOCK_SIZE == 0 && FlashSpoolOffset % FLASH_BLOCK_SIZE == 0, "Spool slots must be whole erase blocks");
+
+// Flash contents, as mapped into the address space through XIP
+inline const uint8_t* flashPointer(uint32_t offset)
+{
+  return (const uint8_t*)(XIP_BASE + offset);
+}
+
+// Erase and program with interrupts off, since nothing can run from flash
+// in the meantime. core1 is kept in reset between jobs, see SecondCore.
+// Erasing goes up to a 64KB block boundary at a time, so aligned blocks
+// get the flash's much faster block erase, and programming a sector at a
+// time. Interrupts come back on and the scheduler gets a turn in between,
+// so a whole slot doesn't hold off USB and the button.
+inline void flashErase(uint32_t offset, uint32_t size)
+{
+  uint32_t end = offset + size;
+  while (offset < end)
+  {
+    uint32_t count = std::min(end - offset, FLASH_BLOCK_SIZE - offset % FLASH_BLOCK_SIZE);
+    uint32_t interrupts = save_and_disable_interrupts();
+    flash_range_erase(offset, count);
+    restore_interrupts(interrupts);
+    offset += count;
+    Scheduler::yield();
+  }
+}
+
+inline void flashProgram(uint32_t offset, const uint8_t* data, uint32_t size)
+{
+  for (uint32_t done = 0; done < size; done += FLASH_SECTOR_SIZE)
+  {
+    uint32_t interrupts = save_and_disable_interrupts();
+    flash_range_program(offset + done, data + done, std::min(size - done, (uint32_t)FLASH_SECTOR_SIZE));
+    restore_interrupts(interrupts);
+    Scheduler::yield();
+  }
+}
+
+// Streams data into an erased flash region a sector at a time, so flash is
+// programmed in a few large operations rather than a page per write
+class FlashWriter
+{
+public:
+  FlashWriter(uint32_t offset, uint32_t capacity)
+    : offset_{offset}
+    , capacity_{capacity}
+    , sector_(FLASH_SECTOR_SIZE)
+  { }
+
+  uint32_t written() const
+  {
+    return written_;
+  }
+
+  bool write(const uint8_t* data, uint32_t size)
+  {
+    if (written_ + fill_ + size > capacity_)
+    {
+      return false;
+    }
+    while (size > 0)
+    {
+      uint32_t count = std::min(size, (uint32_t)FLASH_SECTOR_SIZE - fill_);
+      memcpy(sector_.data() + fill_, data, count);
+      fill_ += count;
+      data += count;
+      size -= count;
+      if (fill_ == FLASH_SECTOR_SIZE)
+      {
+        flushSector();
+      }
+    }
+    return true;
+  }
+
+  // Copy size bytes from src, straight into flash
+  bool write(ByteSource& src, uint32_t size)
+  {
+    if (written_ + fill_ + size > capacity_)
+    {
+      return false;
+    }
+    while (size > 0)
+    {
+      uint32_t count = src.read(sector_.data() + fill_, std::min(size, (uint32_t)FLASH_SECTOR_SIZE - fill_));
+      if (count == 0)
+      {
+        return false;
+      }
+      fill_ += count;
+      size -= count;
+      if (fill_ == FLASH_SECTOR_SIZE)
+      {
+        flushSector();
+      }
+    }
+    return true;
+  }
+
+  // Program whatever is left in the sector buffer, padded to a whole page
+  void finish()
+  {
+    if (fill_ > 0)
+    {
+      uint32_t padded = (fill_ + FLASH_PAGE_SIZE - 1) & ~(FLASH_PAGE_SIZE - 1);
+      memset(sector_.data() + fill_, 0xFF, padded - fill_);
+      flashProgram(offset_ + written_, sector_.data(), padded);
+      written_ += fill_;
+      fill_ = 0;
+    }
+  }
+
+private:
+  void flushSector()
+  {
+    flashProgram(offset_ + written_, sector_.data(), FLASH_SECTOR_SIZE);
+    written_ += FLASH_SECTOR_SIZE;
+    fill_ = 0;
+  }
+
+  uint32_t offset_;
+  uint32_t capacity_;
+  uint32_t written_ = 0;
+  uint32_t fill_ = 0;
+  ScratchBuffer<uint8_t> sector_;
+};
+
+// Describes a spooled capture. Kept in the first page of its slot and
+// programmed last, so an interrupted spool never reads back as valid.
+struct FlashSpoolHeader
+{
+  static constexpr uint32_t Magic = 0x4C4F4F50; // "POOL"
+
+  uint32_t magic;
+  uint32_t size;
+  uint32_t sequence;
+  uint16_t width;
+  uint16_t height;
+  uint8_t format;
+};
+
+// Captures copied out of the camera into flash, so the camera is free
+// again as soon as the copy is done. Spooled images are decoded straight
+// out of XIP flash, as many times as needed.
+//
+// Erasing a slot takes far longer than programming it, so the slot the
+// next capture goes to is erased ahead of time by prepareNext(), while
+// nothing else is going on. That drops the capture in it early, which
+// leaves one slot fewer to look back on.
+class FlashSpool
+{
+public:
+  static constexpr uint32_t DataOffset = FLASH_PAGE_SIZE;
+  static constexpr uint32_t MaxImageSize = FlashSpoolSlotSize - DataOffset;
+
+  static uint32_t slotOffset(int slot)
+  {
+    return FlashSpoolOffset + slot * FlashSpoolSlotSize;
+  }
+
+  // The spooled capture in slot, or null if it doesn't hold one
+  static const FlashSpoolHeader* header(int slot)
+  {
+    if (slot < 0 || slot >= FlashSpoolSlots)
+    {
+      return nullptr;
+    }
+    const FlashSpoolHeader* h = (const FlashSpoolHeader*)flashPointer(slotOffset(slot));
+    return (h->magic == FlashSpoolHeader::Magic && h->size <= MaxImageSize) ? h : nullptr;
+  }
+
+  static const uint8_t* data(int slot)
+  {
+    return flashPointer(slotOffset(slot) + DataOffset);
+  }
+
+  // Read the image data for slot
+  static MemoryByteSource source(int slot)
+  {
+    const FlashSpoolHeader* h = header(slot);
+    return MemoryByteSource(data(slot), h ? h->size : 0);
+  }
+
+  // Copy the rest of src into slot
+  static bool spool(int slot, ByteSource& src, uint16_t width, uint16_t height, uint8_t format)
+  {
+    uint32_t size = src.remaining();
+    if (slot < 0 || slot >= FlashSpoolSlots || size == 0 || size > MaxImageSize)
+    {
+      PINKY_LOG(SpoolTooBig, size, slot);
+      return false;
+    }
+
+    // Only what prepareNext() hasn't already erased
+    uint32_t offset = slotOffset(slot);
+    uint32_t erased = slot == preparedSlot_ ? preparedBytes_ : 0;
+    uint32_t needed = roundUpToSector(DataOffset + size);
+    if (needed > erased)
+    {
+      flashErase(offset + erased, needed - erased);
+    }
+    if (slot == preparedSlot_)
+    {
+      preparedSlot_ = -1;
+      preparedBytes_ = 0;
+    }
+
+    FlashWriter writer(offset + DataOffset, MaxImageSize);
+    bool ok = writer.write(src, size);
+    writer.finish();
+    if (!ok)
+    {
+      PINKY_LOG(SpoolEndedEarly, writer.written(), size);
+      return false;
+    }
+
+    // Header page last
+    std::array<uint8_t, FLASH_PAGE_SIZE> page;
+    page.fill(0xFF);
+    FlashSpoolHeader h {FlashSpoolHeader::Magic, size, nextSequence(), width, height, format};
+    memcpy(page.data(), &h, sizeof(h));
+    flashProgram(offset, page.data(), FLASH_PAGE_SIZE);
+    return true;
+  }
+
+  // An empty slot if there is one, otherwise the one spooled longest ago
+  static int oldestSlot()
+  {
+    int oldest = 0;
+    for (int slot=0; slot < FlashSpoolSlots; ++slot)
+    {
+      const FlashSpoolHeader* h = header(slot);
+      if (!h)
+      {
+        return slot;
+      }
+      if (h->sequence < header(oldest)->sequence)
+      {
+        oldest = slot;
+      }
+    }
+    return oldest;
+  }
+
+  // The slot the next capture should go to: the one being erased ahead of
+  // time, otherwise the oldest
+  static int nextSlot()
+  {
+    return preparedSlot_ >= 0 ? preparedSlot_ : oldestSlot();
+  }
+
+  // Erase one more block of nextSlot(), true once all of it is erased.
+  // Meant to be called when idle, a block at a time so commands still get
+  // a turn in between.
+  static bool prepareNext()
+  {
+    if (preparedSlot_ < 0)
+    {
+      preparedSlot_ = oldestSlot();
+      preparedBytes_ = 0;
+    }
+    if (preparedBytes_ == FlashSpoolSlotSize)
+    {
+      return true;
+    }
+    flashErase(slotOffset(preparedSlot_) + preparedBytes_, FLASH_BLOCK_SIZE);
+    preparedBytes_ += FLASH_BLOCK_SIZE;
+    return preparedBytes_ == FlashSpoolSlotSize;
+  }
+
+private:
+  static uint32_t nextSequence()
+  {
+    uint32_t sequence = 0;
+    for (int slot=0; slot < FlashSpoolSlots; ++slot)
+    {
+      const FlashSpoolHeader* h = header(slot);
+      if (h)
+      {
+        sequence = std::max(sequence, h->sequence + 1);
+      }
+    }
+    return sequence;
+  }
+
+  static inline int preparedSlot_ = -1;
+  static inline uint32_t preparedBytes_ = 0;
+};
+
+// Describes a gallery frame, programmed last like FlashSpoolHeader
+struct FlashFrameHeader
+{
+  static constexpr uint32_t Magic = 0x454D5246; // "FRME"
+
+  uint32_t magic;
+  uint32_t size;      // as stored
+  uint32_t sequence;
+  uint16_t width;
+  uint16_t height;
+  uint8_t layout;     // FrameLayout
+  uint8_t effect;
+  uint8_t encoding;   // FrameEncoding
+};
+
+// Finished frames kept in flash in the layout the panel takes them in (see
+// Inky::framePlanes), so showing one again is only the SPI transfer and
+// the refresh. Frames are compressed with FrameEncoder when that makes
+// them smaller, and otherwise stored as is, to go to the panel straight
+// out of XIP.
+class FlashGallery
+{
+public:
+  static constexpr uint32_t DataOffset = FLASH_PAGE_SIZE;
+  static constexpr uint32_t MaxFrameSize = FlashFrameSlotSize - DataOffset;
+
+  static uint32_t slotOffset(int slot)
+  {
+    return FlashFrameOffset + slot * FlashFrameSlotSize;
+  }
+
+  // The frame in slot, or null if it doesn't hold one
+  static const FlashFrameHeader* header(int slot)
+  {
+    if (slot < 0 || slot >= FlashFrameSlots)
+    {
+      return nullptr;
+    }
+    const FlashFrameHeader* h = (const FlashFrameHeader*)flashPointer(slotOffset(slot));
+    return (h->magic == FlashFrameHeader::Magic && h->size <= MaxFrameSize) ? h : nullptr;
+  }
+
+  static const uint8_t* data(int slot)
+  {
+    return flashPointer(slotOffset(slot) + DataOffset);
+  }
+
+  // Bytes in one row of a frame, which is where FrameEncoder looks for
+  // repeats
+  static uint32_t stride(FrameLayout layout, int width)
+  {
+    return layout == FrameLayout::Packed4Bit ? (width + 1) / 2 : (width + 7) / 8;
+  }
+
+  // Store planes back to back in slot
+  static bool save(int slot, const std::vector<FramePlane>& planes, uint16_t width, uint16_t height, FrameLayout layout, uint8_t effect)
+  {
+    uint32_t size = 0;
+    for (const FramePlane& plane : planes)
+    {
+      size += plane.size;
+    }
+    if (slot < 0 || slot >= FlashFrameSlots)
+    {
+      return false;
+    }
+
+    FlashFrameHeader h {FlashFrameHeader::Magic, 0, 0, width, height, (uint8_t)layout, effect, (uint8_t)FrameEncoding::Compressed};
+    {
+      erase(slot, MaxFrameSize);
+      FlashWriter writer(slotOffset(slot) + DataOffset, std::min(size, MaxFrameSize));
+      FrameEncoder<FlashWriter> encoder(writer, size, stride(layout, width));
+      bool ok = true;
+      for (const FramePlane& plane : planes)
+      {
+        ok = encoder.write(plane.data, plane.size) && ok;
+      }
+      ok = encoder.finish() && ok;
+      writer.finish();
+      if (ok)
+      {
+        PINKY_LOG(FrameCompressed, size, writer.written());
+        h.size = writer.written();
+        writeHeader(slot, h);
+        return true;
+      }
+    }
+
+    // Didn't get any smaller
+    if (size > MaxFrameSize)
+    {
+      PINKY_LOG(FrameTooBig, size, slot);
+      return false;
+    }
+    erase(slot, size);
+    FlashWriter writer(slotOffset(slot) + DataOffset, MaxFrameSize);
+    for (const FramePlane& plane : planes)
+    {
+      writer.write(plane.data, plane.size);
+    }
+    writer.finish();
+    h.size = size;
+    h.encoding = (uint8_t)FrameEncoding::Raw;
+    writeHeader(slot, h);
+    return true;
+  }
+
+  // Unpack a Packed4Bit frame into view, which must be the same size
+  static bool load(int slot, ImageView<IndexedColor>& view)
+  {
+    const FlashFrameHeader* h = header(slot);
+    if (!h || (FrameLayout)h->layout != FrameLayout::Packed4Bit || h->width != view.width || h->height != view.height)
+    {
+      return false;
+    }
+    MemoryByteSource stored(data(slot), h->size);
+    if ((FrameEncoding)h->encoding == FrameEncoding::Raw)
+    {
+      return unpack(stored, view);
+    }
+    FrameDecodeSource decoded(stored);
+    return unpack(decoded, view);
+  }
+
+  // An empty slot if there is one, otherwise the one saved longest ago
+  static int oldestSlot()
+  {
+    int oldest = 0;
+    for (int slot=0; slot < FlashFrameSlots; ++slot)
+    {
+      const FlashFrameHeader* h = header(slot);
+      if (!h)
+      {
+        return slot;
+      }
+      if (h->sequence < header(oldest)->sequence)
+      {
+        oldest = slot;
+      }
+    }
+    return oldest;
+  }
+
+  // count slots to write new frames into: the empty ones first, then the
+  // ones saved longest ago, so frames kept since are the last to go
+  static std::vector<int> oldestSlots(int count)
+  {
+    std::vector<int> slots;
+    for (int slot=0; slot < FlashFrameSlots; ++slot)
+    {
+      slots.push_back(slot);
+    }
+    std::stable_sort(slots.begin(), slots.end(), [](int a, int b)
+    {
+      const FlashFrameHeader* ha = header(a);
+      const FlashFrameHeader* hb = header(b);
+      return hb && (!ha || ha->sequence < hb->sequence);
+    });
+    slots.resize(std::clamp(count, 0, FlashFrameSlots));
+    return slots;
+  }
+
+  static void erase(int slot, uint32_t size)
+  {
+    flashErase(slotOffset(slot), roundUpToSector(DataOffset + size));
+  }
+
+  // Make the frame in slot valid. The sequence number is filled in here.
+  static void writeHeader(int slot, FlashFrameHeader h)
+  {
+    h.sequence = nextSequence();
+    std::array<uint8_t, FLASH_PAGE_SIZE> page;
+    page.fill(0xFF);
+    memcpy(page.data(), &h, sizeof(h));
+    flashProgram(slotOffset(slot), page.data(), FLASH_PAGE_SIZE);
+  }
+
+private:
+  static bool unpack(ByteSource& src, ImageView<IndexedColor>& view)
+  {
+    uint8_t chunk[64];
+    int pixels = view.width * view.height;
+    for (int i=0; i < pixels; i += 2 * sizeof(chunk))
+    {
+      uint32_t count = std::min((uint32_t)sizeof(chunk), (uint32_t)(pixels - i + 1) / 2);
+      if (!readFully(src, chunk, count))
+      {
+        return false;
+      }
+      for (int p = i; p < std::min(pixels, i + 2 * (int)count); ++p)
+      {
+        uint8_t packed = chunk[(p - i) / 2];
+        view.setPixel(p % view.width, p / view.width, (p & 1) ? (packed & 0x0F) : (packed >> 4));
+      }
+    }
+    return true;
+  }
+
+  static uint32_t nextSequence()
+  {
+    uint32_t sequence = 0;
+    for (int slot=0; slot < FlashFrameSlots; ++slot)
+    {
+      const FlashFrameHeader* h = header(slot);
+      if (h)
+      {
+        sequence = std::max(sequence, h->sequence + 1);
+      }
+    }
+    return sequence;
+  }
+};
+
+// A dithered frame compressed straight into a gallery slot as it is
+// written, in the Packed4Bit layout. Rows are kept in RAM only until the
+// writer moves on to the next one, so a frame costs a row, a sector and the
+// encoder's window instead of a whole framebuffer. Rows must be written top
+// to bottom; anything never written is left as background.
+class FlashFrameView : public ImageView<IndexedColor>
+{
+public:
+  // Erases slot up front, so the frame can be written while decoding
+  FlashFrameView(int slot, int width, int height, IndexedColor background, uint8_t effect)
+    : ImageView{width, height}
+    , slot_{slot}
+    , background_{background}
+    , effect_{effect}
+    , row_((width + 1) / 2 + 1)
+    , writer_{FlashGallery::slotOffset(slot) + FlashGallery::DataOffset, FlashGallery::MaxFrameSize}
+    , encoder_{writer_, ((uint32_t)width * height + 1) / 2, FlashGallery::stride(FrameLayout::Packed4Bit, width)}
+  {
+    FlashGallery::erase(slot, FlashGallery::MaxFrameSize);
+    clearRow();
+  }
+
+  virtual ~FlashFrameView() = default;
+
+  // Only the row being written can be read back
+  virtual IndexedColor getPixel(int x, int y) const override
+  {
+    if (y != y_ || x < 0 || x >= width) return background_;
+    int i = x + rowPhase();
+    return (i & 1) ? (row_[i / 2] & 0x0F) : (row_[i / 2] >> 4);
+  }
+
+  virtual void setPixel(int x, int y, const IndexedColor& color) override
+  {
+    if (x < 0 || x >= width || y < y_ || y >= height) return;
+    while (y_ < y)
+    {
+      nextRow();
+    }
+    int i = x + rowPhase();
+    uint8_t& packed = row_[i / 2];
+    packed = (i & 1) ? ((packed & 0xF0) | (color & 0x0F)) : ((packed & 0x0F) | (color << 4));
+  }
+
+  // Write out the remaining rows and the header. The frame isn't valid
+  // until this is called.
+  bool finish()
+  {
+    while (y_ < height)
+    {
+      nextRow();
+    }
+    if (carry_)
+    {
+      ok_ = encoder_.write(row_.data(), 1) && ok_;
+    }
+    ok_ = encoder_.finish() && ok_;
+    writer_.finish();
+    if (!ok_)
+    {
+      PINKY_LOG(FrameOverflowed, slot_);
+      return false;
+    }
+    FlashGallery::writeHeader(slot_, FlashFrameHeader{FlashFrameHeader::Magic, writer_.written(), 0,
+      (uint16_t)width, (uint16_t)height, (uint8_t)FrameLayout::Packed4Bit, effect_, (uint8_t)FrameEncoding::Compressed});
+    return true;
+  }
+
+private:
+  // Rows of an odd width image start on the low nibble every other row
+  int rowPhase() const
+  {
+    return carry_ ? 1 : 0;
+  }
+
+  void clearRow()
+  {
+    std::fill(row_.begin(), row_.end(), (uint8_t)((background_ << 4) | (background_ & 0x0F)));
+  }
+
+  void nextRow()
+  {
+    // Whole bytes go out, a trailing half byte starts the next row
+    int nibbles = width + rowPhase();
+    ok_ = encoder_.write(row_.data(), nibbles / 2) && ok_;
+    uint8_t last = row_[nibbles / 2];
+    clearRow();
+    carry_ = (nibbles & 1) != 0;
+    if (carry_)
+    {
+      row_[0] = (last & 0xF0) | (background_ & 0x0F);
+    }
+    ++y_;
+  }
+
+  int slot_;
+  IndexedColor background_;
+  uint8_t effect_;
+  int y_ = 0;
+  bool carry_ = false;
+  bool ok_ = true;
+  std::vector<uint8_t> row_;
+  FlashWriter writer_;
+  FrameEncoder<FlashWriter> encoder_;
+};
@@ -0,0 +1,448 @@
+#pragma once
+
+#include "ByteSource.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+// Compression for packed frame buffers (Packed4BitIndexedImage data and
+// PackedTwoPlaneBinaryImage planes). Dithered frames have few colors,
+// long flat areas and patterns that repeat from one row to the next, so a
+// byte oriented RLE plus LZ77 with a small window does well and decodes
+// with nothing more than a window sized ring buffer.
+//
+// A compressed frame is its decoded size (uint32, little endian) followed
+// by tokens:
+//
+//   0LLLLLLL              literal, L+1 bytes follow
+//   10LLLLLL V            run of byte V (a run of a pixel pair in 4 bit
+//                         frames, 8 pixels in binary planes)
+//   11LLLLLL OOOO         copy from O (uint16, little endian) bytes back
+//
+// Runs and copies are L+3 bytes long. L of 63 is followed by one more byte
+// that is added to the length.
+constexpr uint32_t FrameCodecWindow = 4096;
+constexpr int FrameCodecMinMatch = 3;
+constexpr int FrameCodecMaxMatch = FrameCodecMinMatch + 63 + 255;
+constexpr int FrameCodecMaxLiteral = 128;
+
+// The most a frame of size bytes can take compressed. The encoder only
+// emits a run or copy that saves at least the byte a literal token costs,
+// so full length literals are the only thing that can add to the size.
+constexpr uint32_t frameCodecMaxSize(uint32_t size)
+{
+  return 4 + size + (size + FrameCodecMaxLiteral - 1) / FrameCodecMaxLiteral;
+}
+
+enum class FrameEncoding : uint8_t
+{
+  Raw,
+  Compressed
+};
+
+// Compresses a frame as it is written, a piece at a time, into sink
+// (anything with bool write(const uint8_t* data, uint32_t size), like
+// FlashWriter). stride is the length of an image row in bytes, since the
+// row above is the best place to look for a match in a dithered image.
+template <typename SinkT>
+class FrameEncoder
+{
+public:
+  FrameEncoder(SinkT& sink, uint32_t size, uint32_t stride)
+    : sink_{sink}
+    , stride_{stride}
+    , buffer_(FrameCodecWindow + FrameCodecWindow / 2 + 2 * FrameCodecMaxMatch)
+    , hash_(1 << HashBits, NoPosition)
+  {
+    uint8_t header[4] = {(uint8_t)size, (uint8_t)(size >> 8), (uint8_t)(size >> 16), (uint8_t)(size >> 24)};
+    emit(header, 4);
+  }
+
+  bool write(const uint8_t* data, uint32_t size)
+  {
+    while (size > 0)
+    {
+      if (end_ - base_ == buffer_.size())
+      {
+        slide();
+      }
+      uint32_t count = std::min(size, (uint32_t)buffer_.size() - (end_ - base_));
+      memcpy(&buffer_[end_ - base_], data, count);
+      end_ += count;
+      data += count;
+      size -= count;
+
+      // Hold back enough to find a full length match
+      while (end_ - pos_ >= (uint32_t)FrameCodecMaxMatch)
+      {
+        encodeNext();
+      }
+    }
+    return ok_;
+  }
+
+  // Encode whatever is still held back and hand it to the sink
+  bool finish()
+  {
+    while (pos_ < end_)
+    {
+      encodeNext();
+    }
+    flushLiterals();
+    flushOut();
+    return ok_;
+  }
+
+  // Bytes handed to the sink so far
+  uint32_t written() const
+  {
+    return written_ + outFill_;
+  }
+
+private:
+  static constexpr int HashBits = 10;
+  static constexpr uint32_t NoPosition = 0xFFFFFFFF;
+
+  uint8_t at(uint32_t position) const
+  {
+    return buffer_[position - base_];
+  }
+
+  uint32_t hashAt(uint32_t position) const
+  {
+    const uint8_t* p = &buffer_[position - base_];
+    uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16);
+    return (v * 2654435761u) >> (32 - HashBits);
+  }
+
+  // Drop everything but the window behind pos_
+  void slide()
+  {
+    uint32_t keep = std::max(pos_ - std::min(pos_, FrameCodecWindow), base_);
+    uint32_t literalStart = pos_ - literals_;
+    keep = std::min(keep, literalStart);
+    memmove(buffer_.data(), &buffer_[keep - base_], end_ - keep);
+    base_ = keep;
+  }
+
+  uint32_t matchLength(uint32_t candidate, uint32_t limit) const
+  {
+    const uint8_t* a = &buffer_[candidate - base_];
+    const uint8_t* b = &buffer_[pos_ - base_];
+    uint32_t length = 0;
+    while (length < limit && a[length] == b[length])
+    {
+      ++length;
+    }
+    return length;
+  }
+
+  void encodeNext()
+  {
+    uint32_t limit = std::min(end_ - pos_, (uint32_t)FrameCodecMaxMatch);
+    uint32_t bestLength = 0;
+    uint32_t bestOffset = 0;
+
+    // A run of the current byte
+    uint32_t runLength = 1;
+    while (runLength < limit && at(pos_ + runLength) == at(pos_))
+    {
+      ++runLength;
+    }
+
+    if (limit >= (uint32_t)FrameCodecMinMatch)
+    {
+      // The rows above, then whatever last hashed the same
+      uint32_t h = hashAt(pos_);
+      uint32_t candidates[3] = {pos_ - stride_, pos_ - 2 * stride_, hash_[h]};
+      for (uint32_t candidate : candidates)
+      {
+        if (candidate == NoPosition || candidate >= pos_ || candidate < base_ || pos_ - candidate > FrameCodecWindow)
+        {
+          continue;
+        }
+        uint32_t length = matchLength(candidate, limit);
+        if (length > bestLength)
+        {
+          bestLength = length;
+          bestOffset = pos_ - candidate;
+        }
+      }
+    }
+
+    // Runs are a byte shorter to encode, so they win ties. A copy no shorter
+    // than its own encoding is only worth it when it doesn't cut literals
+    // short, which would cost another literal token.
+    if (runLength >= (uint32_t)FrameCodecMinMatch && runLength >= bestLength)
+    {
+      flushLiterals();
+      emitLength(0x80, runLength);
+      emit(&buffer_[pos_ - base_], 1);
+      advance(runLength);
+    }
+    else if (bestLength > (uint32_t)FrameCodecMinMatch || (bestLength == (uint32_t)FrameCodecMinMatch && literals_ == 0))
+    {
+      flushLiterals();
+      emitLength(0xC0, bestLength);
+      uint8_t offset[2] = {(uint8_t)bestOffset, (uint8_t)(bestOffset >> 8)};
+      emit(offset, 2);
+      advance(bestLength);
+    }
+    else
+    {
+      advance(1);
+      if (++literals_ == FrameCodecMaxLiteral)
+      {
+        flushLiterals();
+      }
+    }
+  }
+
+  void advance(uint32_t count)
+  {
+    for (uint32_t i=0; i < count; ++i)
+    {
+      if (end_ - pos_ >= (uint32_t)FrameCodecMinMatch)
+      {
+        hash_[hashAt(pos_)] = pos_;
+      }
+      ++pos_;
+    }
+  }
+
+  void flushLiterals()
+  {
+    if (literals_ > 0)
+    {
+      uint8_t token = (uint8_t)(literals_ - 1);
+      emit(&token, 1);
+      emit(&buffer_[pos_ - literals_ - base_], literals_);
+      literals_ = 0;
+    }
+  }
+
+  void emitLength(uint8_t kind, uint32_t length)
+  {
+    uint32_t l = length - FrameCodecMinMatch;
+    uint8_t token[2] = {(uint8_t)(kind | std::min(l, 63u)), (uint8_t)(l - 63)};
+    emit(token, l >= 63 ? 2 : 1);
+  }
+
+  void emit(const uint8_t* data, uint32_t size)
+  {
+    while (size > 0)
+    {
+      uint32_t count = std::min(size, (uint32_t)sizeof(out_) - outFill_);
+      memcpy(out_ + outFill_, data, count);
+      outFill_ += count;
+      data += count;
+      size -= count;
+      if (outFill_ == sizeof(out_))
+      {
+        flushOut();
+      }
+    }
+  }
+
+  void flushOut()
+  {
+    if (outFill_ > 0)
+    {
+      ok_ = sink_.write(out_, outFill_) && ok_;
+      written_ += outFill_;
+      outFill_ = 0;
+    }
+  }
+
+  SinkT& sink_;
+  uint32_t stride_;
+  bool ok_ = true;
+
+  // buffer_ holds input from position base_ up to end_. pos_ is the next
+  // byte to encode, with literals_ bytes before it not yet emitted.
+  std::vector<uint8_t> buffer_;
+  uint32_t base_ = 0;
+  uint32_t pos_ = 0;
+  uint32_t end_ = 0;
+  uint32_t literals_ = 0;
+  std::vector<uint32_t> hash_;
+
+  uint8_t out_[64];
+  uint32_t outFill_ = 0;
+  uint32_t written_ = 0;
+};
+
+// Only counts encoder output, to see how well something compresses
+struct CountingSink
+{
+  uint32_t count = 0;
+
+  bool write(const uint8_t*, uint32_t size)
+  {
+    count += size;
+    return true;
+  }
+};
+
+// Collects encoder output in memory
+struct VectorSink
+{
+  std::vector<uint8_t>& out;
+
+  bool write(const uint8_t* data, uint32_t size)
+  {
+    out.insert(out.end(), data, data + size);
+    return true;
+  }
+};
+
+// Compress a whole frame in one go
+inline std::vector<uint8_t> compressFrame(const uint8_t* data, uint32_t size, uint32_t stride)
+{
+  std::vector<uint8_t> out;
+  VectorSink sink{out};
+  FrameEncoder<VectorSink> encoder(sink, size, stride);
+  encoder.write(data, size);
+  encoder.finish();
+  return out;
+}
+
+// Decompresses a frame as it is read, keeping only the window of output
+// that copies can refer back to. Reads come up short if the compressed
+// data is cut off or corrupt.
+class FrameDecodeSource : public ByteSource
+{
+public:
+  FrameDecodeSource(ByteSource& src)
+    : src_{src}
+    , window_(FrameCodecWindow)
+  {
+    uint8_t header[4];
+    if (readFully(src_, header, 4))
+    {
+      size_ = header[0] | (header[1] << 8) | (header[2] << 16) | ((uint32_t)header[3] << 24);
+    }
+  }
+
+  virtual uint32_t remaining() const override
+  {
+    return failed_ ? 0 : size_ - produced_;
+  }
+
+  virtual uint32_t read(uint8_t* dest, uint32_t len) override
+  {
+    uint32_t done = 0;
+    len = std::min(len, remaining());
+    while (done < len && !failed_)
+    {
+      if (count_ == 0 && !nextToken())
+      {
+        failed_ = true;
+        break;
+      }
+
+      uint32_t n = std::min(count_, len - done);
+      uint8_t* out = dest + done;
+      switch (kind_)
+      {
+        case Kind::Literal:
+          if (!readFully(src_, out, n))
+          {
+            failed_ = true;
+            return done;
+          }
+          break;
+        case Kind::Run:
+          memset(out, value_, n);
+          break;
+        case Kind::Copy:
+          for (uint32_t i=0; i < n; ++i)
+          {
+            // Through the window, since the copy can overlap what it writes
+            out[i] = window_[(produced_ + i - offset_) & (FrameCodecWindow - 1)];
+            window_[(produced_ + i) & (FrameCodecWindow - 1)] = out[i];
+          }
+          break;
+      }
+      if (kind_ != Kind::Copy)
+      {
+        remember(out, n);
+      }
+      produced_ += n;
+      count_ -= n;
+      done += n;
+    }
+    return done;
+  }
+
+  virtual void discard() override
+  {
+    src_.discard();
+  }
+
+private:
+  enum class Kind
+  {
+    Literal,
+    Run,
+    Copy
+  };
+
+  bool nextToken()
+  {
+    uint8_t token;
+    if (!readFully(src_, &token, 1))
+    {
+      return false;
+    }
+    if ((token & 0x80) == 0)
+    {
+      kind_ = Kind::Literal;
+      count_ = (token & 0x7F) + 1;
+      return true;
+    }
+
+    kind_ = (token & 0x40) ? Kind::Copy : Kind::Run;
+    count_ = (token & 0x3F) + FrameCodecMinMatch;
+    uint8_t extension = 0;
+    if ((token & 0x3F) == 63 && !readFully(src_, &extension, 1))
+    {
+      return false;
+    }
+    count_ += extension;
+
+    if (kind_ == Kind::Run)
+    {
+      return readFully(src_, &value_, 1);
+    }
+    uint8_t offset[2];
+    if (!readFully(src_, offset, 2))
+    {
+      return false;
+    }
+    offset_ = offset[0] | (offset[1] << 8);
+    return offset_ > 0 && offset_ <= FrameCodecWindow && offset_ <= produced_;
+  }
+
+  void remember(const uint8_t* data, uint32_t n)
+  {
+    uint32_t at = produced_ & (FrameCodecWindow - 1);
+    uint32_t first = std::min(n, FrameCodecWindow - at);
+    memcpy(&window_[at], data, first);
+    memcpy(&window_[0], data + first, n - first);
+  }
+
+  ByteSource& src_;
+  std::vector<uint8_t> window_;
+  uint32_t size_ = 0;
+  uint32_t produced_ = 0;
+  bool failed_ = false;
+
+  // The token being expanded
+  Kind kind_ = Kind::Literal;
+  uint32_t count_ = 0;
+  uint32_t offset_ = 0;
+  uint8_t value_ = 0;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+// The little bit of hardware the display drivers and the photo pipeline
+// touch: SPI, GPIO, I2C, the USB serial port, time, free heap, clock speed
+// and which core is running. On the device these are the pico-sdk and pi-pico-cpp types and
+// calls themselves, with nothing in between. Host builds get a simulated
+// board instead (HalSim.hpp) that runs on a virtual clock.
+#if PICO_ON_DEVICE
+
+#include <cpp/DiscreteIn.hpp>
+#include <cpp/DiscreteOut.hpp>
+#include <cpp/I2CInterface.hpp>
+#include <cpp/Memory.hpp>
+#include <cpp/SPIDevice.hpp>
+
+#include <hardware/clocks.h>
+#include <hardware/i2c.h>
+#include <hardware/spi.h>
+#include <hardware/sync.h>
+#include <pico/stdio.h>
+#include <pico/stdlib.h>
+
+#include <stdint.h>
+
+using HalSpiDevice = SPIDevice;
+using HalInputPin = DiscreteIn;
+using HalOutputPin = DiscreteOut;
+using HalI2C = I2CInterface;
+template <typename T>
+using HalI2CRegister = I2CRegister<T>;
+
+inline void halSleepMs(uint32_t ms)
+{
+  sleep_ms(ms);
+}
+
+// Waits in WFE, so the core sleeps until an interrupt or the deadline
+inline void halSleepUntilUs(uint64_t us)
+{
+  sleep_until(from_us_since_boot(us));
+}
+
+inline uint64_t halTimeUs()
+{
+  return time_us_64();
+}
+
+// The next byte from the USB serial port, or -1 if none comes in timeoutUs
+inline int halSerialReadByte(uint32_t timeoutUs)
+{
+  int c = getchar_timeout_us(timeoutUs);
+  return c == PICO_ERROR_TIMEOUT ? -1 : c;
+}
+
+// Raw, so nothing gets CRLF translated
+inline void halSerialWrite(const uint8_t* data, uint32_t length)
+{
+  stdio_put_string((const char*)data, (int)length, false, false);
+}
+
+inline uint32_t halFreeHeap()
+{
+  return (uint32_t)(getTotalHeap() - getUsedHeap());
+}
+
+inline uint halCoreNum()
+{
+  return get_core_num();
+}
+
+inline uint32_t halCpuHz()
+{
+  return clock_get_hz(clk_sys);
+}
+
+#else
+
+#include "HalSim.hpp"
+
+#endif
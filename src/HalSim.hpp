@@ -0,0 +1,420 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Host backend of Hal.hpp: a simulated board. Peripherals (SimInky.hpp,
+// say) attach to it and see every pin change, SPI write and I2C transfer
+// the code under test makes. Time is virtual. Sleeping and bus transfers
+// move the clock on straight away, by as long as they would take on the
+// device, so a refresh that takes 30 seconds on the glass costs nothing.
+// Both simulated cores (threads) share the board, so its clock and counters
+// are behind locks.
+
+// Stand-ins for the pico-sdk's peripheral instances
+struct spi_inst_t
+{
+  int index;
+};
+
+struct i2c_inst_t
+{
+  int index;
+};
+
+inline spi_inst_t simSpiInstances[2] = {{0}, {1}};
+inline i2c_inst_t simI2CInstances[2] = {{0}, {1}};
+
+#define spi0 (&simSpiInstances[0])
+#define spi1 (&simSpiInstances[1])
+#define i2c0 (&simI2CInstances[0])
+#define i2c1 (&simI2CInstances[1])
+
+class VirtualClock
+{
+public:
+  // Host time spent computing is added too, multiplied by this (how many
+  // times slower the device is at the same work). 0 leaves computation out,
+  // so only I/O and waiting are modeled.
+  double cpuScale = 0.0;
+
+  uint64_t nowUs()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sync();
+    return nowUs_;
+  }
+
+  void advanceUs(uint64_t us)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sync();
+    nowUs_ += us;
+  }
+
+private:
+  using HostClock = std::chrono::steady_clock;
+
+  void sync()
+  {
+    HostClock::time_point host = HostClock::now();
+    if (cpuScale > 0.0)
+    {
+      cpuUs_ += std::chrono::duration<double, std::micro>(host - lastHost_).count() * cpuScale;
+      nowUs_ += (uint64_t)cpuUs_;
+      cpuUs_ -= (uint64_t)cpuUs_;
+    }
+    lastHost_ = host;
+  }
+
+  std::mutex mutex_;
+  uint64_t nowUs_ = 0;
+  double cpuUs_ = 0.0;
+  HostClock::time_point lastHost_ = HostClock::now();
+};
+
+// Where the modeled time went
+struct SimBoardStats
+{
+  uint64_t sleptUs = 0;
+  uint64_t spiUs = 0;
+  uint64_t i2cUs = 0;
+  uint64_t spiBytes = 0;
+};
+
+// Something on the simulated board. Every peripheral sees all the traffic
+// and picks out its own.
+class SimPeripheral
+{
+public:
+  virtual ~SimPeripheral() = default;
+
+  // The level this peripheral drives pin to, if it drives it at all
+  virtual bool drivesPin(uint /*pin*/, bool& /*level*/)
+  {
+    return false;
+  }
+
+  virtual void pinChanged(uint /*pin*/, bool /*level*/) { }
+
+  // Bytes written while chip select csPin is held low
+  virtual void spiWrite(uint /*csPin*/, const uint8_t* /*data*/, size_t /*len*/) { }
+
+  // Transfers to an I2C address. False is a NAK (nothing there).
+  virtual bool i2cWrite(uint8_t /*address*/, const uint8_t* /*data*/, size_t /*len*/)
+  {
+    return false;
+  }
+
+  virtual bool i2cRead(uint8_t /*address*/, uint8_t* /*data*/, size_t /*len*/)
+  {
+    return false;
+  }
+};
+
+class SimBoard
+{
+public:
+  static SimBoard& instance()
+  {
+    static SimBoard board;
+    return board;
+  }
+
+  VirtualClock clock;
+
+  // What the firmware sees as free heap: the RP2350's 520KB less the
+  // firmware's own static use, roughly. Decides the same buffering choices
+  // the device would make.
+  uint32_t freeHeap = 400 * 1024;
+
+  // The RP2350's clock, to turn modeled time into cycles. Only means
+  // anything for computation with clock.cpuScale set.
+  uint32_t cpuHz = 150000000;
+
+  // A snapshot of the counters, to take the difference of
+  SimBoardStats stats()
+  {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
+  }
+
+  void attach(SimPeripheral& peripheral)
+  {
+    peripherals_.push_back(&peripheral);
+  }
+
+  void detach(SimPeripheral& peripheral)
+  {
+    peripherals_.erase(std::remove(peripherals_.begin(), peripherals_.end(), &peripheral), peripherals_.end());
+  }
+
+  void sleepUs(uint64_t us)
+  {
+    count(&SimBoardStats::sleptUs, us);
+    clock.advanceUs(us);
+  }
+
+  void setPin(uint pin, bool level)
+  {
+    if (pin >= pins_.size())
+    {
+      pins_.resize(pin + 1, true);
+    }
+    pins_[pin] = level;
+    for (SimPeripheral* peripheral : peripherals_)
+    {
+      peripheral->pinChanged(pin, level);
+    }
+  }
+
+  // Inputs nothing drives read high, as if pulled up
+  bool getPin(uint pin)
+  {
+    bool level;
+    for (SimPeripheral* peripheral : peripherals_)
+    {
+      if (peripheral->drivesPin(pin, level))
+      {
+        return level;
+      }
+    }
+    return pin < pins_.size() ? pins_[pin] : true;
+  }
+
+  void spiWrite(uint csPin, uint32_t speedHz, const uint8_t* data, size_t len)
+  {
+    uint64_t us = (uint64_t)len * 8 * 1000000 / std::max<uint32_t>(speedHz, 1);
+    count(&SimBoardStats::spiUs, us);
+    count(&SimBoardStats::spiBytes, len);
+    clock.advanceUs(us);
+    for (SimPeripheral* peripheral : peripherals_)
+    {
+      peripheral->spiWrite(csPin, data, len);
+    }
+  }
+
+  bool i2cWrite(uint32_t speedHz, uint8_t address, const uint8_t* data, size_t len)
+  {
+    i2cTransfer(speedHz, len);
+    bool ack = false;
+    for (SimPeripheral* peripheral : peripherals_)
+    {
+      ack = peripheral->i2cWrite(address, data, len) || ack;
+    }
+    return ack;
+  }
+
+  bool i2cRead(uint32_t speedHz, uint8_t address, uint8_t* data, size_t len)
+  {
+    i2cTransfer(speedHz, len);
+    for (SimPeripheral* peripheral : peripherals_)
+    {
+      if (peripheral->i2cRead(address, data, len))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  // Address byte plus data, 9 clocks a byte with the ACK
+  void i2cTransfer(uint32_t speedHz, size_t len)
+  {
+    uint64_t us = (uint64_t)(len + 1) * 9 * 1000000 / std::max<uint32_t>(speedHz, 1);
+    count(&SimBoardStats::i2cUs, us);
+    clock.advanceUs(us);
+  }
+
+  void count(uint64_t SimBoardStats::* counter, uint64_t amount)
+  {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.*counter += amount;
+  }
+
+  std::mutex statsMutex_;
+  SimBoardStats stats_;
+
+  std::vector<SimPeripheral*> peripherals_;
+  std::vector<bool> pins_;
+};
+
+// The HAL types, with the same constructors and calls as the pi-pico-cpp
+// ones they stand in for
+
+class HalSpiDevice
+{
+public:
+  HalSpiDevice(spi_inst_t* /*spi*/, uint /*misoPin*/, uint /*mosiPin*/, uint /*clockPin*/, uint csPin, uint32_t speedHz, uint32_t /*transferSize*/)
+    : csPin_{csPin}
+    , speedHz_{speedHz}
+  { }
+
+  int write(const uint8_t* data, size_t len)
+  {
+    SimBoard::instance().spiWrite(csPin_, speedHz_, data, len);
+    return (int)len;
+  }
+
+private:
+  uint csPin_;
+  uint32_t speedHz_;
+};
+
+class HalInputPin
+{
+public:
+  HalInputPin(uint pin)
+    : pin_{pin}
+  { }
+
+  bool get() const
+  {
+    return SimBoard::instance().getPin(pin_);
+  }
+
+private:
+  uint pin_;
+};
+
+class HalOutputPin
+{
+public:
+  HalOutputPin(uint pin)
+    : pin_{pin}
+  { }
+
+  void set(bool level)
+  {
+    SimBoard::instance().setPin(pin_, level);
+  }
+
+private:
+  uint pin_;
+};
+
+class HalI2C
+{
+public:
+  HalI2C(i2c_inst_t* /*i2c*/, uint /*sdaPin*/, uint /*sclPin*/, uint32_t speedHz)
+    : speedHz_{speedHz}
+  { }
+
+  bool write(uint8_t address, const uint8_t* data, size_t len)
+  {
+    return SimBoard::instance().i2cWrite(speedHz_, address, data, len);
+  }
+
+  bool read(uint8_t address, uint8_t* data, size_t len)
+  {
+    return SimBoard::instance().i2cRead(speedHz_, address, data, len);
+  }
+
+private:
+  uint32_t speedHz_;
+};
+
+// A register of sizeof(T) bytes at reg on the device at address
+template <typename T>
+class HalI2CRegister
+{
+public:
+  HalI2CRegister(HalI2C& i2c, uint8_t address, uint8_t reg)
+    : i2c_{i2c}
+    , address_{address}
+    , reg_{reg}
+  { }
+
+  bool set(const T& value)
+  {
+    uint8_t data[1 + sizeof(T)];
+    data[0] = reg_;
+    memcpy(data + 1, &value, sizeof(T));
+    return i2c_.write(address_, data, sizeof(data));
+  }
+
+  bool get(T& value)
+  {
+    return i2c_.write(address_, &reg_, 1) && i2c_.read(address_, (uint8_t*)&value, sizeof(T));
+  }
+
+private:
+  HalI2C& i2c_;
+  uint8_t address_;
+  uint8_t reg_;
+};
+
+inline void halSleepMs(uint32_t ms)
+{
+  SimBoard::instance().sleepUs((uint64_t)ms * 1000);
+}
+
+inline void halSleepUntilUs(uint64_t us)
+{
+  uint64_t now = SimBoard::instance().clock.nowUs();
+  if (us > now)
+  {
+    SimBoard::instance().sleepUs(us - now);
+  }
+}
+
+inline uint64_t halTimeUs()
+{
+  return SimBoard::instance().clock.nowUs();
+}
+
+// The board's USB serial port is the process's stdin and stdout, in real
+// time rather than virtual, since whatever is on the other end (a pty, say)
+// runs on the host's clock
+inline int halSerialReadByte(uint32_t timeoutUs)
+{
+  pollfd in {STDIN_FILENO, POLLIN, 0};
+  uint8_t c;
+  if (poll(&in, 1, (int)((timeoutUs + 999) / 1000)) <= 0 || read(STDIN_FILENO, &c, 1) != 1)
+  {
+    return -1;
+  }
+  return c;
+}
+
+inline void halSerialWrite(const uint8_t* data, uint32_t length)
+{
+  while (length > 0)
+  {
+    ssize_t written = write(STDOUT_FILENO, data, length);
+    if (written <= 0)
+    {
+      return;
+    }
+    data += written;
+    length -= (uint32_t)written;
+  }
+}
+
+inline uint32_t halFreeHeap()
+{
+  return SimBoard::instance().freeHeap;
+}
+
+inline uint32_t halCpuHz()
+{
+  return SimBoard::instance().cpuHz;
+}
+
+// The thread that asks first is core0, any other (SecondCore's worker) is
+// core1
+inline uint halCoreNum()
+{
+  static const std::thread::id core0 = std::this_thread::get_id();
+  return std::this_thread::get_id() == core0 ? 0 : 1;
+}
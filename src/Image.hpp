@@ -6,6 +6,20 @@
 #include <vector>
 #include <tuple>
 
+// How a panel takes its frame buffer over SPI
+enum class FrameLayout : uint8_t
+{
+  Packed4Bit,     // Packed4BitIndexedImage data
+  TwoPlaneBinary  // PackedTwoPlaneBinaryImage black plane, then color plane
+};
+
+// A run of frame buffer bytes in the panel's own layout
+struct FramePlane
+{
+  const uint8_t* data;
+  uint32_t size;
+};
+
 template <typename PixelTypeT>
 // Image type that stores image data serially in a std::vector
 class Image : public ImageView<PixelTypeT>
@@ -111,6 +125,11 @@ public:
     return data_;
   }
 
+  const std::vector<uint8_t>& getData() const
+  {
+    return data_;
+  }
+
 private:
   std::vector<uint8_t> data_;
 };
@@ -228,6 +247,14 @@ public:
       return cPlane_;
   }
 
+  const std::vector<uint8_t>& getPlane(Plane p) const
+  {
+    if (p == Plane::Black)
+      return bPlane_;
+    else
+      return cPlane_;
+  }
+
 private:
   IndexedColor colorNone_;
   IndexedColor colorB_;
@@ -3,9 +3,17 @@
 #include "ImageView.hpp"
 #include "Image.hpp"
 #include "IndexedColor.hpp"
+#include "Stats.hpp"
+#include "Trace.hpp"
 
 #include <cpp/Color.hpp>
 
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
 class RGBToIndexedImageView : public ImageView<RGBColor>
 {
 public:
@@ -32,7 +40,114 @@ protected:
   const IndexedColorMap& colorMap_;
 };
 
-class LabDitherView : public ImageView<RGBColor>
+// Floyd-Steinberg error storage for one image row, in saturating int16 with
+// 4 fractional bits. A single row of slots is shared by the current and the
+// next row: slots left of the pixel being dithered already hold error for
+// the next row, slots right of it still hold error for this row. That means
+// nothing has to be swapped or zeroed when a new row starts.
+template <int Channels>
+class RollingDiffusionBuffer
+{
+public:
+  // Working error values, fixed point with FractionBits fractional bits
+  using Error = std::array<int, Channels>;
+  static constexpr int FractionBits = 4;
+  static constexpr int One = 1 << FractionBits;
+
+  explicit RollingDiffusionBuffer(int width)
+    : slots_((size_t)(width + 2))
+  { }
+
+  // Widest row this has room for
+  int width() const
+  {
+    return (int)slots_.size() - 2;
+  }
+
+  // Zero all stored error (only needed when diffusion restarts)
+  void clear()
+  {
+    std::fill(slots_.begin(), slots_.end(), Slot{});
+    beginRow();
+  }
+
+  // Drop error carried within the previous row
+  void beginRow()
+  {
+    right_ = {};
+    belowRight_ = {};
+    lastX_ = -2;
+  }
+
+  // Get the error accumulated for pixel x of the current row
+  Error take(int x)
+  {
+    // Carried error only applies if x directly follows the last pixel
+    if (x != lastX_ + 1)
+    {
+      right_ = {};
+      belowRight_ = {};
+    }
+
+    const Slot& slot = slots_[x + 1];
+    Error e;
+    for (int c=0; c < Channels; ++c)
+    {
+      e[c] = slot[c] + right_[c];
+    }
+    return e;
+  }
+
+  // Distribute the quantization error of pixel x
+  void diffuse(int x, const Error& e)
+  {
+    Slot& belowLeft = slots_[x];
+    Slot& below = slots_[x + 1];
+    for (int c=0; c < Channels; ++c)
+    {
+      belowLeft[c] = saturate(belowLeft[c] + ((e[c] * 3 + 8) >> 4));
+      below[c] = saturate(((e[c] * 5 + 8) >> 4) + belowRight_[c]);
+      belowRight_[c] = (e[c] + 8) >> 4;
+      right_[c] = (e[c] * 7 + 8) >> 4;
+    }
+    lastX_ = x;
+  }
+
+private:
+  using Slot = std::array<int16_t, Channels>;
+
+  static int16_t saturate(int value)
+  {
+    return (int16_t)std::clamp(value, (int)INT16_MIN, (int)INT16_MAX);
+  }
+
+  // slots_[x+1] belongs to pixel x, slot 0 absorbs error left of the image
+  std::vector<Slot> slots_;
+  Error right_ {};
+  Error belowRight_ {};
+  int lastX_ = -2;
+};
+
+inline LabColor toLabColor(const RGBColor& color)
+{
+  return color.toLab();
+}
+
+inline LabColor toLabColor(const LabColor& color)
+{
+  return color;
+}
+
+using LabDiffusionBuffer = RollingDiffusionBuffer<3>;
+using LumaDiffusionBuffer = RollingDiffusionBuffer<1>;
+
+// Error diffusion dither to the palette of a color map, working in Lab.
+// InputT is the pixel type written to the view: RGBColor is converted to
+// Lab per pixel, LabColor input (from decoders that produce Lab directly)
+// is used as is. The error rows can be lent by the caller, so a view can be
+// made without allocating.
+template <typename InputT>
+class BasicLabDitherView : public ImageView<InputT>
 {
 public:
   // Determines how accurate we try to make colors when doing diffusion.
@@ -40,88 +155,231 @@ public:
   // Sane values: 0.5 - 1.0
   float ditherAccuracy;
 
-  LabDitherView(ImageView<IndexedColor>& indexed, const IndexedColorMap& colorMap)
-    : ImageView(indexed.width, indexed.height)
+  BasicLabDitherView(ImageView<IndexedColor>& indexed, const IndexedColorMap& colorMap, LabDiffusionBuffer* error = nullptr)
+    : ImageView<InputT>(indexed.width, indexed.height)
+    , ditherAccuracy{0.7f}
     , indexed_{indexed}
     , colorMap_{colorMap}
-    , ditherAccuracy{0.7f}
+    , palette_{colorMap.packedPalette()}
+    , nearest_{colorMap.nearestColorKernel()}
     , currentDiffusionRow_{-1}
-    , thisRowError_((size_t)width)
-    , nextRowError_((size_t)width)
-  { }
+  {
+    if (!error || error->width() < indexed.width)
+    {
+      error = &ownError_.emplace(indexed.width);
+    }
+    error_ = error;
+  }
 
-  virtual RGBColor getPixel(int x, int y) const override
+  virtual InputT getPixel(int x, int y) const override
   {
-    return colorMap_.toRGBColor(indexed_.getPixel(x,y));
+    if constexpr (std::is_same<InputT, LabColor>::value)
+    {
+      return colorMap_.toLabColor(indexed_.getPixel(x,y));
+    }
+    else
+    {
+      return colorMap_.toRGBColor(indexed_.getPixel(x,y));
+    }
   }
 
-  virtual void setPixel(int x, int y, const RGBColor& color) override
+  virtual void setPixel(int x, int y, const InputT& color) override
   {
     // Because we cache error data here we should protect against bad
     // coordinates at this layer.
-    if (x < 0 || x >= width || y < 0 || y >= height) return;
-    
+    if (x < 0 || x >= this->width || y < 0 || y >= this->height) return;
+    beginPixels(y);
+    ditherPixel(x, y, toLabColor(color));
+  }
+
+  virtual void setPixels(int x, int y, const InputT* colors, int count) override
+  {
+    // Clip the run once, then dither it without per pixel virtual calls
+    if (y < 0 || y >= this->height) return;
+    int begin = std::max(x, 0);
+    int end = std::min(x + count, this->width);
+    if (begin >= end) return;
+
+    uint32_t traceStart = ditherTrace_.begin();
+    StatScope stat(StatCounter::DitherUs);
+    Stats::add(StatCounter::PixelsDithered, end - begin);
+    beginPixels(y);
+    for (int i=begin; i < end; ++i)
+    {
+      ditherPixel(i, y, toLabColor(colors[i - x]));
+    }
+    ditherTrace_.end(y, traceStart);
+  }
+
+  // Reset the accumulated diffusion error to 0
+  void resetDiffusion()
+  {
+    // This is sufficient to mark diffusion error data as invalid
+    currentDiffusionRow_ = -1;
+  }
+
+private:
+  using ErrorBuffer = LabDiffusionBuffer;
+
+  void beginPixels(int y)
+  {
     // If diffusion is currently off or y has jumped in a weird way
-    // clear both error buffers and set the current y to be the diffusion error row
+    // clear the error buffer and set the current y to be the diffusion error row
     if (currentDiffusionRow_ == -1 || y > (currentDiffusionRow_+1) || y < currentDiffusionRow_)
     {
-      for (int i=0; i < width; ++i)
-      {
-        nextRowError_[i] = {0,0,0};
-        thisRowError_[i] = {0,0,0};
-      }
+      error_->clear();
       currentDiffusionRow_ = y;
+      errorScale_ = ditherAccuracy / (float)ErrorBuffer::One;
     }
-    // If y has advanced by one, then swap next and current buffers 
-    // and clear the next buffer.
+    // If y has advanced by one, start a new row
     else if (currentDiffusionRow_+1 == y)
     {
-      auto swap = std::move(nextRowError_);
-      nextRowError_ = std::move(thisRowError_);
-      thisRowError_ = std::move(swap);
-      for (int i=0; i < width; ++i)
-      {
-        nextRowError_[i] = {0,0,0};
-      }
+      error_->beginRow();
       currentDiffusionRow_ = y;
     }
+  }
 
-    // Convert the current color to LAB and add the current error,
-    // attenuating error slightly as we do so (to ensure error doesn't grow unbounded)
-    LabColor current = color.toLab() + (thisRowError_[x] * ditherAccuracy);
+  void ditherPixel(int x, int y, const LabColor& color)
+  {
+    // Add the current error, attenuating error slightly as we do so
+    // (to ensure error doesn't grow unbounded)
+    typename ErrorBuffer::Error incoming = error_->take(x);
+    LabColor current = color + LabColor{
+      (float)incoming[0] * errorScale_,
+      (float)incoming[1] * errorScale_,
+      (float)incoming[2] * errorScale_
+    };
 
     // Convert to nearest indexed color, saving error
     LabColor error;
-    IndexedColor nearestIndexed = colorMap_.toIndexedColor(current, error);
+    IndexedColor nearestIndexed = nearest_(palette_, current, error);
     indexed_.setPixel(x,y,nearestIndexed);
 
-    // Diffuse the error into the error buffers
-    if (x < width-1)
-    {
-      thisRowError_[x+1] += error *   (7.0f / 16.0f);
-      nextRowError_[x+1] += error * (1.0f / 16.0f);
-    }
-    if (x > 0)
+    // Diffuse the error into the error buffer
+    error_->diffuse(x, {
+      (int)(error.L * (float)ErrorBuffer::One),
+      (int)(error.a * (float)ErrorBuffer::One),
+      (int)(error.b * (float)ErrorBuffer::One)
+    });
+  }
+
+  ImageView<IndexedColor>& indexed_;
+  const IndexedColorMap& colorMap_;
+  // Nearest color kernel for this palette, picked once at construction
+  const PackedLabPalette& palette_;
+  NearestColorFunc nearest_;
+  int currentDiffusionRow_;
+  float errorScale_ = 0.0f;
+  // The error rows, lent or ownError_
+  ErrorBuffer* error_;
+  std::optional<ErrorBuffer> ownError_;
+  TraceRowTimer ditherTrace_{TraceSpan::Dither};
+};
+
+// Dithers RGB input
+using LabDitherView = BasicLabDitherView<RGBColor>;
+
+// Dithers input that is already in Lab
+using LabInputDitherView = BasicLabDitherView<LabColor>;
+
+// Dithers luma-only input for monochrome color maps. Quantization runs
+// through the color map's 256 entry lightness tables and diffuses a single
+// scalar error channel, so no Lab conversion happens per pixel.
+class LumaDitherView : public ImageView<LumaColor>
+{
+public:
+  // Determines how accurate we try to make colors when doing diffusion.
+  // Lower values provide more clarity on more limited displays.
+  // Sane values: 0.5 - 1.0
+  float ditherAccuracy;
+
+  LumaDitherView(ImageView<IndexedColor>& indexed, const IndexedColorMap& colorMap, LumaDiffusionBuffer* error = nullptr)
+    : ImageView(indexed.width, indexed.height)
+    , ditherAccuracy{0.7f}
+    , indexed_{indexed}
+    , colorMap_{colorMap}
+    , currentDiffusionRow_{-1}
+  {
+    if (!error || error->width() < width)
     {
-      nextRowError_[x-1] += error * (3.0f / 16.0f);
+      error = &ownError_.emplace(width);
     }
-    if (y < height-1)
+    error_ = error;
+  }
+
+  virtual LumaColor getPixel(int x, int y) const override
+  {
+    return LumaColor{colorMap_.toRGBColor(indexed_.getPixel(x,y)).G};
+  }
+
+  virtual void setPixel(int x, int y, const LumaColor& color) override
+  {
+    // Because we cache error data here we should protect against bad
+    // coordinates at this layer.
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    beginPixels(y);
+    ditherPixel(x, y, color);
+  }
+
+  virtual void setPixels(int x, int y, const LumaColor* colors, int count) override
+  {
+    if (y < 0 || y >= height) return;
+    int begin = std::max(x, 0);
+    int end = std::min(x + count, width);
+    if (begin >= end) return;
+
+    uint32_t traceStart = ditherTrace_.begin();
+    StatScope stat(StatCounter::DitherUs);
+    Stats::add(StatCounter::PixelsDithered, end - begin);
+    beginPixels(y);
+    for (int i=begin; i < end; ++i)
     {
-      nextRowError_[x] += error *   (5.0f / 16.0f);
+      ditherPixel(i, y, colors[i - x]);
     }
+    ditherTrace_.end(y, traceStart);
   }
 
   // Reset the accumulated diffusion error to 0
   void resetDiffusion()
   {
-    // This is sufficient to mark diffusion error data as invalid
     currentDiffusionRow_ = -1;
   }
 
 private:
+  using ErrorBuffer = LumaDiffusionBuffer;
+
+  void beginPixels(int y)
+  {
+    // Same row tracking as BasicLabDitherView
+    if (currentDiffusionRow_ == -1 || y > (currentDiffusionRow_+1) || y < currentDiffusionRow_)
+    {
+      error_->clear();
+      currentDiffusionRow_ = y;
+      accuracy_ = (int)(ditherAccuracy * 256.0f);
+    }
+    else if (currentDiffusionRow_+1 == y)
+    {
+      error_->beginRow();
+      currentDiffusionRow_ = y;
+    }
+  }
+
+  void ditherPixel(int x, int y, const LumaColor& color)
+  {
+    // Add the attenuated error (accuracy has 8 fractional bits)
+    constexpr int Shift = 8 + ErrorBuffer::FractionBits;
+    int current = (int)colorMap_.lumaToLightness(color.Y) + ((error_->take(x)[0] * accuracy_) >> Shift);
+
+    int error;
+    indexed_.setPixel(x, y, colorMap_.quantizeLightness(current, error));
+    error_->diffuse(x, {error * ErrorBuffer::One});
+  }
+
   ImageView<IndexedColor>& indexed_;
   const IndexedColorMap& colorMap_;
   int currentDiffusionRow_;
-  std::vector<LabColor> thisRowError_;
-  std::vector<LabColor> nextRowError_;
+  int accuracy_ = 0;
+  ErrorBuffer* error_;
+  std::optional<ErrorBuffer> ownError_;
+  TraceRowTimer ditherTrace_{TraceSpan::Dither};
 };
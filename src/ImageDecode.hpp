@@ -0,0 +1,746 @@
+#pragma once
+
+#include "ByteSource.hpp"
+#include "DeferredLog.hpp"
+#include "ImageView.hpp"
+#include "IndexedColor.hpp"
+#include "ScratchArena.hpp"
+#include "Stats.hpp"
+#include "Trace.hpp"
+#include "YUVToLab.hpp"
+
+#include <cpp/Color.hpp>
+
+#include <picojpeg.h>
+
+#include <type_traits>
+#include <vector>
+
+// Update the rest of the app on progress using a float, 0.0f - 1.0f.
+// Refers to a callable owned by the caller, which must outlive it, so
+// handing one around never allocates the way std::function can.
+class ProgressUpdateCallback
+{
+public:
+  ProgressUpdateCallback(std::nullptr_t = nullptr)
+  { }
+
+  template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, ProgressUpdateCallback>::value>>
+  ProgressUpdateCallback(F& callable)
+    : callable_{(void*)&callable}
+    , call_{[](void* callable, float progress) { (*(F*)callable)(progress); }}
+  { }
+
+  explicit operator bool() const
+  {
+    return call_ != nullptr;
+  }
+
+  void operator()(float progress) const
+  {
+    call_(callable_, progress);
+  }
+
+private:
+  void* callable_ = nullptr;
+  void (*call_)(void*, float) = nullptr;
+};
+
+using McuCopyFunc = void(*)(unsigned char* r, unsigned char* g, unsigned char* b, RGBColor* dest, int stride);
+
+inline uint8_t blendUint8(uint8_t a, uint8_t b)
+{
+  return (uint8_t)std::clamp(((int)a + (int)b) / 2, 0, 255);
+}
+
+inline uint8_t blendUint8(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+{
+  return (uint8_t)std::clamp(((int)a + (int)b + (int)c + (int)d) / 4, 0, 255);
+}
+
+// Decoders are templated on the output pixel type. RGBColor is plain full
+// color output, LabColor feeds the Lab dither directly (converted through
+// YUVToLabTable, YUV without an RGB round trip) and LumaColor is the
+// monochrome fast path.
+template <typename PixelT>
+constexpr bool IsLumaPixel = std::is_same<PixelT, LumaColor>::value;
+
+// Decoders convert and hand off pixels in runs of this many
+constexpr int DecodeChunkSize = 32;
+
+inline bool readFailed()
+{
+  PINKY_LOG(ImageEndedEarly);
+  return false;
+}
+
+inline void pixelFromRGB(uint8_t r, uint8_t g, uint8_t b, RGBColor& out)
+{
+  out = RGBColor{r, g, b};
+}
+
+inline void pixelFromRGB(uint8_t r, uint8_t g, uint8_t b, LabColor& out)
+{
+  out = YUVToLabTable::instance().toLab(RGBColor{r, g, b});
+}
+
+inline void pixelFromRGB(uint8_t r, uint8_t g, uint8_t b, LumaColor& out)
+{
+  // BT.601 luma, weights sum to 256
+  out = LumaColor{(uint8_t)((77 * r + 150 * g + 29 * b) >> 8)};
+}
+
+inline void pixelFromYUV(uint8_t y, uint8_t u, uint8_t v, RGBColor& out)
+{
+  out = YUVColor{y, u, v}.toRGB();
+}
+
+inline void pixelFromYUV(uint8_t y, uint8_t u, uint8_t v, LabColor& out)
+{
+  out = YUVToLabTable::instance().toLab(y, u, v);
+}
+
+inline void pixelFromYUV(uint8_t y, uint8_t /*u*/, uint8_t /*v*/, LumaColor& out)
+{
+  out = LumaColor{y};
+}
+
+// Convert a run of pixels (at most DecodeChunkSize). Lab output converts
+// the whole run at once through the row kernels.
+template <typename PixelT>
+void pixelsFromRGB(const RGBColor* rgb, PixelT* out, int count)
+{
+  for (int i=0; i < count; ++i)
+  {
+    pixelFromRGB(rgb[i].R, rgb[i].G, rgb[i].B, out[i]);
+  }
+}
+
+inline void pixelsFromRGB(const RGBColor* rgb, LabColor* out, int count)
+{
+  YUVToLabTable::instance().toLab(rgb, out, count);
+}
+
+template <typename PixelT>
+void pixelsFromYUV(const uint8_t* y, const uint8_t* u, const uint8_t* v, PixelT* out, int count)
+{
+  for (int i=0; i < count; ++i)
+  {
+    pixelFromYUV(y[i], u[i], v[i], out[i]);
+  }
+}
+
+inline void pixelsFromYUV(const uint8_t* y, const uint8_t* u, const uint8_t* v, LabColor* out, int count)
+{
+  YUVToLabTable::instance().toLab(y, u, v, out, count);
+}
+
+// Get the chroma of pixel x in a YUYV line, interpolating the missing
+// channel horizontally. The first and last pixels are not interpolated.
+inline void yuyvChroma(const uint8_t* yuyv, int x, int lastX, uint8_t& u, uint8_t& v)
+{
+  if (x == 0)
+  {
+    u = yuyv[1];
+    v = yuyv[3];
+  }
+  else if (x == lastX)
+  {
+    u = (x%2==0) ? yuyv[x*2+1] : yuyv[x*2-1];
+    v = (x%2==0) ? yuyv[x*2-1] : yuyv[x*2+1];
+  }
+  else if (x%2==0)
+  {
+    u = yuyv[x*2+1];
+    v = blendUint8(yuyv[x*2-1], yuyv[x*2+3]);
+  }
+  else
+  {
+    u = blendUint8(yuyv[x*2-1], yuyv[x*2+3]);
+    v = yuyv[x*2+1];
+  }
+}
+
+// The part of a decoded image of the given size that is visible through
+// buffer. Decoders only convert pixels inside it and stop reading source
+// data after its last row.
+template <typename PixelT>
+ImageRegion visibleDecodeRegion(const ImageView<PixelT>& buffer, int width, int height)
+{
+  return buffer.visibleRegion().intersect(ImageRegion{0, 0, width, height});
+}
+
+template <typename PixelT>
+bool decodeImageRGB565(int width, int height, ByteSource& src, ImageView<PixelT>& buffer, ProgressUpdateCallback progressCb = nullptr)
+{
+  if (src.remaining() != (uint32_t)(width * height * 2))
+  {
+    PINKY_LOG(BadImageSize, src.remaining(), width * height * 2);
+    return false;
+  }
+
+  ImageRegion visible = visibleDecodeRegion(buffer, width, height);
+  uint16_t rgb565[width];
+  for (int y=0; y < visible.bottom(); ++y)
+  {
+    TraceScope trace(TraceSpan::DecodeRow, y);
+
+    // Collect one line of the image
+    if (!readFully(src, (uint8_t*)rgb565, width * 2))
+    {
+      return readFailed();
+    }
+
+    // Write the line to the eInk display (rows above the
+    // visible region only need to be read past)
+    if (y >= visible.y)
+    {
+      PixelT chunk[DecodeChunkSize];
+      RGBColor rgb[DecodeChunkSize];
+      for (int x0=visible.x; x0 < visible.right(); x0 += DecodeChunkSize)
+      {
+        int count = std::min(DecodeChunkSize, visible.right() - x0);
+        for (int i=0; i < count; ++i)
+        {
+          rgb[i] = RGBColor::fromRGB565(rgb565[x0+i]);
+        }
+        pixelsFromRGB(rgb, chunk, count);
+        buffer.setPixels(x0, y, chunk, count);
+      }
+      Stats::add(StatCounter::PixelsDecoded, visible.width);
+      if (progressCb)
+      {
+        progressCb((float)(y - visible.y) / (float)visible.height);
+      }
+    }
+  }
+
+  return true;
+}
+
+template <typename PixelT>
+bool decodeImageYUYV(int width, int height, ByteSource& src, ImageView<PixelT>& buffer, ProgressUpdateCallback progressCb = nullptr)
+{
+  if (src.remaining() != (uint32_t)(width * height * 2))
+  {
+    PINKY_LOG(BadImageSize, src.remaining(), width * height * 2);
+    return false;
+  }
+
+  int widthBytes = width * 2;
+  int writeWidth = std::min(width, buffer.width);
+  ImageRegion visible = visibleDecodeRegion(buffer, writeWidth, height);
+  uint8_t yuyv[widthBytes];
+  
+  for (int y=0; y < visible.bottom(); ++y)
+  {
+    TraceScope trace(TraceSpan::DecodeRow, y);
+
+    // Collect one line of the image into line0
+    if (!readFully(src, yuyv, widthBytes))
+    {
+      return readFailed();
+    }
+
+    // Rows above the visible region only need to be read past
+    if (y < visible.y)
+    {
+      continue;
+    }
+
+    if constexpr (IsLumaPixel<PixelT>)
+    {
+      // Luma only, the chroma bytes are never touched
+      LumaColor chunk[DecodeChunkSize];
+      for (int x0=visible.x; x0 < visible.right(); x0 += DecodeChunkSize)
+      {
+        int count = std::min(DecodeChunkSize, visible.right() - x0);
+        for (int i=0; i < count; ++i)
+        {
+          chunk[i] = LumaColor{yuyv[(x0+i)*2]};
+        }
+        buffer.setPixels(x0, y, chunk, count);
+      }
+    }
+    else if (writeWidth > 1)
+    {
+      PixelT chunk[DecodeChunkSize];
+      uint8_t lumas[DecodeChunkSize], us[DecodeChunkSize], vs[DecodeChunkSize];
+      for (int x0=visible.x; x0 < visible.right(); x0 += DecodeChunkSize)
+      {
+        int count = std::min(DecodeChunkSize, visible.right() - x0);
+        for (int i=0; i < count; ++i)
+        {
+          int x = x0 + i;
+          lumas[i] = yuyv[x*2];
+          yuyvChroma(yuyv, x, writeWidth-1, us[i], vs[i]);
+        }
+        pixelsFromYUV(lumas, us, vs, chunk, count);
+        buffer.setPixels(x0, y, chunk, count);
+      }
+    }
+    Stats::add(StatCounter::PixelsDecoded, visible.width);
+
+    // Give a progress update
+    if (progressCb)
+    {
+      progressCb((float)(y - visible.y) / (float)visible.height);
+    }
+  }
+
+  return true;
+}
+
+template <typename PixelT>
+bool decodeImageYUYVHalf(int width, int height, ByteSource& src, ImageView<PixelT>& buffer, ProgressUpdateCallback progressCb = nullptr)
+{
+  if (src.remaining() != (uint32_t)(width * height * 2))
+  {
+    PINKY_LOG(BadImageSize, src.remaining(), width * height * 2);
+    return false;
+  }
+
+  if (width %2 !=0 || height % 2 != 0)
+  {
+    PINKY_LOG(OddImageSize);
+    return false;
+  }
+
+  ImageRegion visible = visibleDecodeRegion(buffer, width / 2, height / 2);
+  int strideBytes = width * 2;
+  int bytesToRead = strideBytes * 2;
+  uint8_t yuyv[bytesToRead];
+  
+  for (int y=0; y / 2 < visible.bottom(); y+=2)
+  {
+    TraceScope trace(TraceSpan::DecodeRow, y);
+
+    // Collect 2 lines of the image
+    if (!readFully(src, yuyv, bytesToRead))
+    {
+      return readFailed();
+    }
+
+    int blitY = y / 2;
+    if (blitY >= visible.y)
+    {
+      PixelT chunk[DecodeChunkSize];
+      uint8_t lumas[DecodeChunkSize], us[DecodeChunkSize], vs[DecodeChunkSize];
+      for (int x0=visible.x; x0 < visible.right(); x0 += DecodeChunkSize)
+      {
+        int count = std::min(DecodeChunkSize, visible.right() - x0);
+        for (int j=0; j < count; ++j)
+        {
+          int i = (x0 + j) * 4;
+          uint8_t luma = blendUint8(yuyv[i], yuyv[i + 2], yuyv[i + strideBytes], yuyv[i + strideBytes + 2]);
+          if constexpr (IsLumaPixel<PixelT>)
+          {
+            // Luma only, the chroma bytes are never touched
+            chunk[j] = LumaColor{luma};
+          }
+          else
+          {
+            lumas[j] = luma;
+            us[j] = blendUint8(yuyv[i + 1], yuyv[i + strideBytes + 1]);
+            vs[j] = blendUint8(yuyv[i + 3], yuyv[i + strideBytes + 3]);
+          }
+        }
+        if constexpr (!IsLumaPixel<PixelT>)
+        {
+          pixelsFromYUV(lumas, us, vs, chunk, count);
+        }
+        buffer.setPixels(x0, blitY, chunk, count);
+      }
+      Stats::add(StatCounter::PixelsDecoded, visible.width);
+
+      // Give a progress update
+      if (progressCb)
+      {
+        progressCb((float)(blitY - visible.y) / (float)visible.height);
+      }
+    }
+  }
+
+  return true;
+}
+
+// Write one output line of the line-interleaved YUV format. The U and V
+// values are the average of two source lines (pass the same line twice to
+// use it as is).
+template <typename PixelT>
+void writeYUVLine(ImageView<PixelT>& buffer, int y, int beginX, int endX, const uint8_t* lumaLine,
+                  const uint8_t* uLineA, const uint8_t* uLineB, const uint8_t* vLineA, const uint8_t* vLineB)
+{
+  PixelT chunk[DecodeChunkSize];
+  uint8_t lumas[DecodeChunkSize], us[DecodeChunkSize], vs[DecodeChunkSize];
+  for (int x0=beginX; x0 < endX; x0 += DecodeChunkSize)
+  {
+    int count = std::min(DecodeChunkSize, endX - x0);
+    for (int i=0; i < count; ++i)
+    {
+      int x = x0 + i;
+      lumas[i] = lumaLine[x*2];
+      us[i] = blendUint8(uLineA[x*2+1], uLineB[x*2+1]);
+      vs[i] = blendUint8(vLineA[x*2+1], vLineB[x*2+1]);
+    }
+    pixelsFromYUV(lumas, us, vs, chunk, count);
+    buffer.setPixels(x0, y, chunk, count);
+  }
+  Stats::add(StatCounter::PixelsDecoded, std::max(endX - beginX, 0));
+}
+
+// Without chroma, the line-interleaved YUV layout is identical to YUYV
+bool decodeImageYUV(int width, int height, ByteSource& src, ImageView<LumaColor>& buffer, ProgressUpdateCallback progressCb = nullptr)
+{
+  return decodeImageYUYV(width, height, src, buffer, progressCb);
+}
+
+template <typename PixelT>
+bool decodeImageYUV(int width, int height, ByteSource& src, ImageView<PixelT>& buffer, ProgressUpdateCallback progressCb = nullptr)
+{
+  if (src.remaining() != (uint32_t)(width * height * 2))
+  {
+    PINKY_LOG(BadImageSize, src.remaining(), width * height * 2);
+    return false;
+  }
+
+  int widthBytes = width * 2;
+  ImageRegion visible = visibleDecodeRegion(buffer, width, height);
+  int x0 = visible.x;
+  int x1 = visible.right();
+  uint8_t yuv16a[widthBytes];
+  uint8_t yuv16b[widthBytes];
+  uint8_t yuv16c[widthBytes];
+  uint8_t* line2 = yuv16c;
+  uint8_t* line1 = yuv16b;
+  uint8_t* line0 = yuv16a;
+  bool uLine = true;
+
+  // Each line is written once the line after it has been read
+  int lastLine = std::min(visible.bottom(), height-1);
+  
+  for (int y=0; y <= lastLine; ++y)
+  {
+    TraceScope trace(TraceSpan::DecodeRow, y);
+
+    // Collect one line of the image into line0
+    if (!readFully(src, line0, widthBytes))
+    {
+      return readFailed();
+    }
+
+    // If this is the second line, write out line1,
+    // interpolating only with line0
+    bool prevVisible = (y-1) >= visible.y && (y-1) < visible.bottom();
+    if (y == 1 && prevVisible)
+    {
+      writeYUVLine(buffer, y-1, x0, x1, line1, line1, line1, line0, line0);
+    }
+    // If this is the third or greater line, write out line1
+    // interpolating it with lines 0 and 2
+    else if (y > 1 && prevVisible)
+    {
+      if (uLine)
+      {
+        writeYUVLine(buffer, y-1, x0, x1, line1, line0, line2, line1, line1);
+      }
+      else
+      {
+        writeYUVLine(buffer, y-1, x0, x1, line1, line1, line1, line0, line2);
+      }
+    }
+    
+    // If this was the last line, write out line0,
+    // interpolating only with line1
+    if (y == height-1 && y >= visible.y && y < visible.bottom())
+    {
+      if (uLine)
+      {
+        writeYUVLine(buffer, y, x0, x1, line0, line0, line0, line1, line1);
+      }
+      else
+      {
+        writeYUVLine(buffer, y, x0, x1, line0, line1, line1, line0, line0);
+      }
+    }
+
+    // Give a progress update
+    if (progressCb && y > visible.y)
+    {
+      progressCb((float)(y - visible.y) / (float)visible.height);
+    }
+
+    // mark the next line as a V line
+    uLine = !uLine;
+
+    // shuffle the line buffers
+    std::swap(line0, line2);
+    std::swap(line1, line2);
+  }
+
+  return true;
+}
+
+void copyMcuDataGreyscale(unsigned char* r, unsigned char* /*g*/, unsigned char* /*b*/, RGBColor* dest, int stride)
+{
+  for (int j=0; j < 8; ++j)
+  {
+    for (int i=0; i < 8; ++i)
+    {
+      dest[i] = RGBColor{*r, *r, *r};
+      r+=1;
+    }
+    dest += stride;
+  }
+}
+
+void copyMcuDataH1V1(unsigned char* r, unsigned char* g, unsigned char* b, RGBColor* dest, int stride)
+{
+  for (int j=0; j < 8; ++j)
+  {
+    for (int i=0; i < 8; ++i)
+    {
+      dest[i] = RGBColor{*r, *g, *b};
+      r+=1; g+=1; b+=1;
+    }
+    dest += stride;
+  }
+}
+
+void copyMcuDataH2V1(unsigned char* r, unsigned char* g, unsigned char* b, RGBColor* dest, int stride)
+{
+  copyMcuDataH1V1(r, g, b, dest, stride);
+  copyMcuDataH1V1(r+64, g+64, b+64, dest+8, stride);
+}
+
+void copyMcuDataH1V2(unsigned char* r, unsigned char* g, unsigned char* b, RGBColor* dest, int stride)
+{
+  copyMcuDataH1V1(r, g, b, dest, stride);
+  copyMcuDataH1V1(r+128, g+128, b+128, dest+(8*stride), stride);
+}
+
+void copyMcuDataH2V2(unsigned char* r, unsigned char* g, unsigned char* b, RGBColor* dest, int stride)
+{
+  copyMcuDataH1V1(r, g, b, dest, stride);
+  copyMcuDataH1V1(r+64, g+64, b+64, dest+8, stride);
+  copyMcuDataH1V1(r+128, g+128, b+128, dest+(8*stride), stride);
+  copyMcuDataH1V1(r+192, g+192, b+192, dest+(8*stride)+8, stride);
+}
+
+McuCopyFunc selectMcuCopyFunc(pjpeg_scan_type_t scanType)
+{
+  switch (scanType)
+  {
+    case pjpeg_scan_type_t::PJPG_GRAYSCALE: return copyMcuDataGreyscale;
+    case pjpeg_scan_type_t::PJPG_YH1V1: return copyMcuDataH1V1;
+    case pjpeg_scan_type_t::PJPG_YH2V1: return copyMcuDataH2V1;
+    case pjpeg_scan_type_t::PJPG_YH1V2: return copyMcuDataH1V2;
+    case pjpeg_scan_type_t::PJPG_YH2V2: return copyMcuDataH2V2;
+    default: return nullptr;
+  }
+}
+
+// picojpeg keeps all of its state in statics, so each copy of it compiled
+// into the firmware is one decoder. This picks which one to drive.
+struct PicoJpegDecoder
+{
+  decltype(&pjpeg_decode_init) init;
+  decltype(&pjpeg_decode_mcu) decodeMcu;
+};
+
+constexpr PicoJpegDecoder DefaultJpegDecoder {pjpeg_decode_init, pjpeg_decode_mcu};
+
+// picojpeg need-bytes callback reading from a ByteSource
+unsigned char readJpegBytes(unsigned char* pBuf, unsigned char buf_size, unsigned char *pBytes_actually_read, void* srcPtr)
+{
+  ByteSource& src = *(ByteSource*)srcPtr;
+  uint32_t bytesRead = src.read(pBuf, buf_size);
+  *pBytes_actually_read = (unsigned char)bytesRead;
+  return (unsigned char)(bytesRead > 0 ? 0 : 1);
+}
+
+// Which MCUs of a JPEG need copying out to fill the visible part of a
+// buffer. picojpeg can't skip MCUs, so every MCU up to mcuYEnd is still
+// fully decoded (entropy decode, IDCT and color conversion); only rows
+// below mcuYEnd are never decoded at all. Decoded lines only span the
+// visible MCU columns.
+struct JpegDecodeWindow
+{
+  ImageRegion visible;
+  int mcuXBegin;
+  int mcuXEnd;
+  int mcuYBegin;
+  int mcuYEnd;
+  int decodeX;
+  int decodeWidth;
+};
+
+template <typename PixelT>
+JpegDecodeWindow jpegDecodeWindow(const ImageView<PixelT>& buffer, int mcuWidth, int mcuHeight, int mcusPerRow, int mcusPerCol)
+{
+  JpegDecodeWindow w;
+  w.visible = visibleDecodeRegion(buffer, mcuWidth*mcusPerRow, mcuHeight*mcusPerCol);
+  w.mcuXBegin = w.visible.x / mcuWidth;
+  w.mcuXEnd = (w.visible.right() + mcuWidth - 1) / mcuWidth;
+  w.mcuYBegin = w.visible.y / mcuHeight;
+  w.mcuYEnd = (w.visible.bottom() + mcuHeight - 1) / mcuHeight;
+  w.decodeX = w.mcuXBegin*mcuWidth;
+  w.decodeWidth = std::max(w.mcuXEnd - w.mcuXBegin, 1)*mcuWidth;
+  return w;
+}
+
+template <typename PixelT>
+JpegDecodeWindow jpegDecodeWindow(const ImageView<PixelT>& buffer, const pjpeg_image_info_t& info)
+{
+  return jpegDecodeWindow(buffer, info.m_MCUWidth, info.m_MCUHeight, info.m_MCUSPerRow, info.m_MCUSPerCol);
+}
+
+// Decode a full row of MCUs, copying the visible ones into [MCUHeight]
+// lines of window.decodeWidth pixels. Pass null lines to decode past a row.
+// Invisible MCUs cost the full decode all the same, just not the copy.
+inline unsigned char decodeMcuRow(const PicoJpegDecoder& decoder, const pjpeg_image_info_t& info,
+                                  const JpegDecodeWindow& window, McuCopyFunc copyFunc, RGBColor* lines)
+{
+  for (int mcuX = 0; mcuX < info.m_MCUSPerRow; ++mcuX)
+  {
+    unsigned char res = decoder.decodeMcu();
+    if (res != 0)
+    {
+      return res;
+    }
+
+    // Invisible MCUs are decoded but not copied
+    if (lines && mcuX >= window.mcuXBegin && mcuX < window.mcuXEnd)
+    {
+      copyFunc(info.m_pMCUBufR, info.m_pMCUBufG, info.m_pMCUBufB, lines+((mcuX-window.mcuXBegin)*info.m_MCUWidth), window.decodeWidth);
+    }
+  }
+  return 0;
+}
+
+// Write decoded lines starting at image line y, skipping lines and
+// columns outside the visible region
+template <typename PixelT>
+void writeDecodedLines(ImageView<PixelT>& buffer, const JpegDecodeWindow& window, const RGBColor* lines, int y, int lineCount)
+{
+  const ImageRegion& visible = window.visible;
+  for (int i=0; i < lineCount; ++i, ++y, lines += window.decodeWidth)
+  {
+    if (y < visible.y || y >= visible.bottom())
+    {
+      continue;
+    }
+
+    const RGBColor* line = lines + (visible.x - window.decodeX);
+    Stats::add(StatCounter::PixelsDecoded, visible.width);
+    if constexpr (std::is_same<PixelT, RGBColor>::value)
+    {
+      buffer.setPixels(visible.x, y, line, visible.width);
+    }
+    else
+    {
+      PixelT chunk[DecodeChunkSize];
+      for (int x0=0; x0 < visible.width; x0 += DecodeChunkSize)
+      {
+        int count = std::min(DecodeChunkSize, visible.width - x0);
+        pixelsFromRGB(line + x0, chunk, count);
+        buffer.setPixels(visible.x + x0, y, chunk, count);
+      }
+    }
+  }
+}
+
+// Read the JPEG header, returning how to copy out its MCUs (or null if
+// it can't be decoded)
+inline McuCopyFunc beginJpegDecode(const PicoJpegDecoder& decoder, ByteSource& src, pjpeg_image_info_t& info)
+{
+  PINKY_LOG(JpegDecoding, src.remaining());
+  unsigned char status = decoder.init(&info, readJpegBytes, &src, 0);
+  if (status != 0)
+  {
+    PINKY_LOG(JpegHeaderError, status);
+    return nullptr;
+  }
+
+  McuCopyFunc copyFunc = selectMcuCopyFunc(info.m_scanType);
+  if (copyFunc)
+  {
+    PINKY_LOG(JpegScanType, info.m_scanType);
+  }
+  else
+  {
+    PINKY_LOG(JpegBadScanType, info.m_scanType);
+  }
+  return copyFunc;
+}
+
+// Width and height from a JPEG's start of frame marker
+inline bool jpegDimensions(const uint8_t* jpeg, size_t size, int& width, int& height)
+{
+  size_t pos = 2;
+  while (pos + 9 < size && jpeg[pos] == 0xFF)
+  {
+    uint8_t marker = jpeg[pos + 1];
+    size_t length = (jpeg[pos + 2] << 8) | jpeg[pos + 3];
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+    {
+      height = (jpeg[pos + 5] << 8) | jpeg[pos + 6];
+      width = (jpeg[pos + 7] << 8) | jpeg[pos + 8];
+      return true;
+    }
+    pos += 2 + length;
+  }
+  return false;
+}
+
+// The size is taken from the JPEG header, the one passed in is only there
+// to match the other decoders
+template <typename PixelT>
+bool decodeImageJPG(int /*width*/, int /*height*/, ByteSource& src, ImageView<PixelT>& buffer, ProgressUpdateCallback progressCb = nullptr)
+{
+  pjpeg_image_info_t info;
+  McuCopyFunc copyFunc = beginJpegDecode(DefaultJpegDecoder, src, info);
+  if (!copyFunc)
+  {
+    return false;
+  }
+
+  // Only MCUs that touch the visible region get copied out, and decoding
+  // stops after the last MCU row that has visible pixels in it
+  JpegDecodeWindow window = jpegDecodeWindow(buffer, info);
+
+  // We will need buffer [MCUHeight] lines of decoded pixels covering the
+  // visible MCU columns so that the dither code can operate line-wise,
+  // the way it likes
+  ScratchBuffer<RGBColor> decodeBuffer((size_t)window.decodeWidth*info.m_MCUHeight);
+  for (int mcuY = 0; mcuY < window.mcuYEnd; ++mcuY)
+  {
+    TraceScope trace(TraceSpan::DecodeRow, mcuY);
+
+    // If something has gone wrong in the loop where we are pretty sure we
+    // should have data to decode, bail with a failure flag.
+    bool visibleRow = mcuY >= window.mcuYBegin;
+    unsigned char res = decodeMcuRow(DefaultJpegDecoder, info, window, copyFunc, visibleRow ? decodeBuffer.data() : nullptr);
+    if (res != 0)
+    {
+      PINKY_LOG(JpegDecodeError, res);
+      return false;
+    }
+
+    if (!visibleRow)
+    {
+      continue;
+    }
+
+    // Now that we have [MCUHeight] full lines, iterate over them
+    writeDecodedLines(buffer, window, decodeBuffer.data(), mcuY * info.m_MCUHeight, info.m_MCUHeight);
+
+    // Report progress
+    if (progressCb)
+    {
+      progressCb((float)(mcuY - window.mcuYBegin) / (float)(window.mcuYEnd - window.mcuYBegin));
+    }
+  }
+
+  return true;
+}
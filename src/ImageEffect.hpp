@@ -2,6 +2,9 @@
 
 #include "ImageView.hpp"
 
+#include <stdint.h>
+#include <vector>
+
 template <typename ImageViewT>
 // Centers a source image over a destination
 class AlignCenterView : public ImageView<typename ImageViewT::PixelType>
@@ -25,8 +28,116 @@ public:
   {
     destination_.setPixel(x+dx_, y+dy_, color);
   }
+
+  virtual void setPixels(int x, int y, const typename ImageViewT::PixelType* colors, int count) override
+  {
+    destination_.setPixels(x+dx_, y+dy_, colors, count);
+  }
+
+  virtual ImageRegion visibleRegion() const override
+  {
+    // Whatever part of the destination's visible region we cover
+    ImageRegion dest = destination_.visibleRegion();
+    dest.x -= dx_;
+    dest.y -= dy_;
+    return dest.intersect(ImageRegion{0, 0, this->width, this->height});
+  }
 private:
   ImageViewT& destination_;
   int dx_;
   int dy_;
-};
\ No newline at end of file
+};
+
+template <typename PixelT>
+// Writes every pixel into several views at once, so one decode can feed
+// any number of dither stages in lockstep
+class FanOutView : public ImageView<PixelT>
+{
+public:
+  using Clock = uint64_t(*)();
+
+  // Outputs all share the size given here. With a clock (in microseconds)
+  // the time spent inside each output is added up, see busyTime().
+  FanOutView(int width, int height, Clock clock = nullptr)
+        : ImageView<PixelT>{width, height}
+        , clock_{clock}
+    {}
+
+  virtual ~FanOutView() = default;
+
+  void add(ImageView<PixelT>& output)
+  {
+    outputs_.push_back(&output);
+    busy_.push_back(0);
+  }
+
+  int outputCount() const
+  {
+    return (int)outputs_.size();
+  }
+
+  uint64_t busyTime(int output) const
+  {
+    return busy_[output];
+  }
+
+  virtual PixelT getPixel(int x, int y) const override
+  {
+    return outputs_.empty() ? PixelT{} : outputs_.front()->getPixel(x, y);
+  }
+
+  virtual void setPixel(int x, int y, const PixelT& color) override
+  {
+    setPixels(x, y, &color, 1);
+  }
+
+  virtual void setPixels(int x, int y, const PixelT* colors, int count) override
+  {
+    for (size_t i=0; i < outputs_.size(); ++i)
+    {
+      uint64_t start = clock_ ? clock_() : 0;
+      outputs_[i]->setPixels(x, y, colors, count);
+      if (clock_)
+      {
+        busy_[i] += clock_() - start;
+      }
+    }
+  }
+
+  virtual ImageRegion visibleRegion() const override
+  {
+    // Anything any of the outputs can see
+    ImageRegion region;
+    for (const ImageView<PixelT>* output : outputs_)
+    {
+      ImageRegion r = output->visibleRegion();
+      if (r.empty())
+      {
+        continue;
+      }
+      if (region.empty())
+      {
+        region = r;
+        continue;
+      }
+      int x0 = std::min(region.x, r.x);
+      int y0 = std::min(region.y, r.y);
+      int x1 = std::max(region.right(), r.right());
+      int y1 = std::max(region.bottom(), r.bottom());
+      region = ImageRegion{x0, y0, x1 - x0, y1 - y0};
+    }
+    return region;
+  }
+
+  virtual void flush() override
+  {
+    for (ImageView<PixelT>* output : outputs_)
+    {
+      output->flush();
+    }
+  }
+private:
+  Clock clock_;
+  std::vector<ImageView<PixelT>*> outputs_;
+  std::vector<uint64_t> busy_;
+};
@@ -1,5 +1,29 @@
 #pragma once
 
+#include <algorithm>
+
+// A rectangle of pixels within an image
+struct ImageRegion
+{
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+
+  int right() const { return x + width; }
+  int bottom() const { return y + height; }
+  bool empty() const { return width <= 0 || height <= 0; }
+
+  ImageRegion intersect(const ImageRegion& other) const
+  {
+    int x0 = std::max(x, other.x);
+    int y0 = std::max(y, other.y);
+    int x1 = std::min(right(), other.right());
+    int y1 = std::min(bottom(), other.bottom());
+    return ImageRegion{x0, y0, std::max(x1 - x0, 0), std::max(y1 - y0, 0)};
+  }
+};
+
 // An abstract class for interacting with images. Reading and writing
 // pixel data is allowed, though writes may be cached.
 template <typename PixelTypeT>
@@ -23,6 +47,24 @@ public:
   // perform operations more efficiently.
   virtual void setPixel(int x, int y, const PixelType& color) = 0;
 
+  // Write count consecutive pixels of row y, starting at x.
+  // Views that can take a run of pixels at once override this
+  // to avoid a virtual call per pixel.
+  virtual void setPixels(int x, int y, const PixelType* colors, int count)
+  {
+    for (int i=0; i < count; ++i)
+    {
+      setPixel(x+i, y, colors[i]);
+    }
+  }
+
+  // The part of this view, in its own coordinates, where written pixels
+  // actually end up somewhere. Writers can skip work outside of it.
+  virtual ImageRegion visibleRegion() const
+  {
+    return ImageRegion{0, 0, width, height};
+  }
+
   // Ensure all pixels set are flushed to underlying storage
   // and any internal memory buffers are cleared.
   virtual void flush() {}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "NearestColor.hpp"
+#include "LabKernels.hpp"
+
 #include "cpp/Color.hpp"
 #include "cpp/Logging.hpp"
 
@@ -8,6 +11,7 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <array>
 #include <random>
 
 // When adding colors here, be sure to also add them to the function
@@ -45,6 +49,14 @@ RGBColor ColorNameToSaturatedRGBColor(ColorName name)
 }
 
 typedef uint8_t IndexedColor;
+
+// A single 8 bit luma sample (0 = black, 255 = white), used by the
+// monochrome pipeline so chroma never has to be decoded or converted
+struct LumaColor
+{
+  uint8_t Y = 0;
+};
+
 using ColorMapArgList = std::vector<std::tuple<ColorName,IndexedColor,RGBColor>>;
 
 struct IndexedColorMap
@@ -67,7 +79,36 @@ struct IndexedColorMap
   {
     return nameToIndex.count(color) > 0;
   }
+  bool isMonochrome() const
+  {
+    return monochrome_;
+  }
+  // Convert an 8 bit luma value to Lab lightness, scaled to 0-255
+  uint8_t lumaToLightness(uint8_t luma) const
+  {
+    return lumaToL_[luma];
+  }
+  // Quantize a lightness value (Lab L scaled to 0-255) to the nearest color
+  // in the palette by L alone, returning the lightness error in the same scale
+  IndexedColor quantizeLightness(int lightness, int& error) const
+  {
+    uint8_t l = (uint8_t)std::clamp(lightness, 0, 255);
+    error = lightness - lToPaletteL_[l];
+    return lToIndex_[l];
+  }
+  // Palette packed for the nearest color kernels
+  const PackedLabPalette& packedPalette() const
+  {
+    return packed_;
+  }
+  // Nearest color kernel specialized for this palette's size and mode
+  NearestColorFunc nearestColorKernel() const
+  {
+    return nearest_;
+  }
 private:
+  void buildLookupTables();
+
   bool monochrome_ = false;
   std::vector<IndexedColor> indexedColors_;
   std::vector<ColorName> namedColors_;
@@ -77,6 +118,14 @@ private:
   std::unordered_map<ColorName,IndexedColor> nameToIndex;
   std::unordered_map<ColorName,RGBColor> nameToRgb;
   std::unordered_map<ColorName,LabColor> nameToLab;
+
+  // 256 entry tables for the luminance-only (monochrome) pipeline
+  std::array<uint8_t, 256> lumaToL_ {};
+  std::array<IndexedColor, 256> lToIndex_ {};
+  std::array<uint8_t, 256> lToPaletteL_ {};
+
+  PackedLabPalette packed_;
+  NearestColorFunc nearest_ = selectNearestColorKernel(0, false);
 };
 
 
@@ -112,6 +161,47 @@ IndexedColorMap::IndexedColorMap(ColorMapArgList mapping, bool monochrome) :
     nameToRgb[name] = indexToRgb[index];
     nameToLab[name] = indexToLab[index];
   }
+
+  buildLookupTables();
+}
+
+void IndexedColorMap::buildLookupTables()
+{
+  // Packed palette, in mapping order, and the matching kernel
+  packed_.clear();
+  for (auto index : indexedColors_)
+  {
+    packed_.push_back(index, indexToLab[index]);
+  }
+  nearest_ = selectNearestColorKernel(packed_.size(), monochrome_);
+  // The unrolled scalar kernels are as fast for the two and three color panels
+  if (!monochrome_ && packed_.size() > 4 && labKernels().nearestColor)
+  {
+    nearest_ = labKernels().nearestColor;
+  }
+
+  // Lab lightness of every grey level
+  for (int i=0; i < 256; ++i)
+  {
+    uint8_t v = (uint8_t)i;
+    lumaToL_[i] = (uint8_t)std::lround(remapClamp(RGBColor{v, v, v}.toLab().L, 0.0f, 100.0f, 0.0f, 255.0f));
+  }
+
+  // Nearest palette entry (by lightness only) for every lightness value
+  for (int l=0; l < 256; ++l)
+  {
+    int minDelta = std::numeric_limits<int>::max();
+    for (const auto& [indexedColor, refColor] : indexToLab)
+    {
+      int refL = (int)std::lround(remapClamp(refColor.L, 0.0f, 100.0f, 0.0f, 255.0f));
+      if (std::abs(refL - l) < minDelta)
+      {
+        minDelta = std::abs(refL - l);
+        lToIndex_[l] = indexedColor;
+        lToPaletteL_[l] = (uint8_t)refL;
+      }
+    }
+  }
 }
 
 void IndexedColorMap::normalizePaletteByRgb(bool pinBlack, bool pinWhite)
@@ -135,6 +225,8 @@ void IndexedColorMap::normalizePaletteByRgb(bool pinBlack, bool pinWhite)
     indexToLab[index] = colorLab;
     nameToLab[name] = colorLab;
   }
+
+  buildLookupTables();
 }
 
 void IndexedColorMap::normalizePaletteByLab(bool pinBlack, bool pinWhite)
@@ -156,6 +248,8 @@ void IndexedColorMap::normalizePaletteByLab(bool pinBlack, bool pinWhite)
     indexToLab[index] = colorLab;
     nameToLab[name] = colorLab;
   }
+
+  buildLookupTables();
 }
 
 const std::vector<IndexedColor>& IndexedColorMap::indexedColors() const 
@@ -171,23 +265,7 @@ const std::vector<ColorName>& IndexedColorMap::namedColors() const
 IndexedColor IndexedColorMap::toIndexedColor(const LabColor& color, LabColor& error) const
 {
   // Find the indexed color with the minimum deltaE from the specified color
-  float minDeltaE = std::numeric_limits<float>::infinity();
-  IndexedColor minIndexColor = 0;
-  LabColor minLabColor;
-
-  for (const auto& [indexedColor, refColor] : indexToLab)
-  {
-    float dE = monochrome_? std::abs(refColor.L-color.L) : refColor.deltaE(color);
-    if (dE < minDeltaE)
-    {
-      minDeltaE = dE;
-      minIndexColor = indexedColor;
-      minLabColor = refColor;
-    }
-  }
-
-  error = monochrome_ ? LabColor{color.L-minLabColor.L,0,0} : (color - minLabColor);
-  return minIndexColor;
+  return nearest_(packed_, color, error);
 }
 
 IndexedColor IndexedColorMap::toIndexedColor(const RGBColor& color) const
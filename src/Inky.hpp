@@ -7,10 +7,8 @@
 #include "InkyE673.hpp"
 
 #include <cpp/Logging.hpp>
-#include <cpp/I2CInterface.hpp>
-
-#include "hardware/spi.h"
 
+#include <string.h>
 #include <vector>
 
 
@@ -25,12 +23,13 @@ InkyEeprom readEeprom(const InkyConfig& config)
     .colorCapability = ColorCapability::BlackWhite,
     .pcbVariant = 0,
     .displayVariant = DisplayVariant::InvalidDisplayType,
+    .writeTime = {},
   };
   strcpy(eeprom.writeTime, "invalid");
   
-  I2CInterface i2c(config.I2CInstance, config.I2C_SDA_PIN, config.I2C_SCL_PIN, 100000);
-  I2CRegister<uint8_t> eepromRegisterReset(i2c, config.I2CDeviceId, 0);
-  I2CRegister<InkyEeprom> eepromRegister(i2c, config.I2CDeviceId, 0);
+  HalI2C i2c(config.I2CInstance, config.I2C_SDA_PIN, config.I2C_SCL_PIN, 100000);
+  HalI2CRegister<uint8_t> eepromRegisterReset(i2c, config.I2CDeviceId, 0);
+  HalI2CRegister<InkyEeprom> eepromRegister(i2c, config.I2CDeviceId, 0);
   eepromRegisterReset.set(0);
   eepromRegister.get(eeprom);
 
@@ -1,15 +1,21 @@
 #pragma once
 
+#include "ByteSource.hpp"
+#include "DeferredLog.hpp"
+#include "Hal.hpp"
+#include "Image.hpp"
 #include "ImageView.hpp"
 #include "IndexedColor.hpp"
 #include "InkyConfig.hpp"
+#include "Scheduler.hpp"
+#include "Stats.hpp"
+#include "Trace.hpp"
 
-#include <cpp/DiscreteIn.hpp>
-#include <cpp/DiscreteOut.hpp>
 #include <cpp/Logging.hpp>
-#include <cpp/SPIDevice.hpp>
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 class Inky
 {
@@ -31,6 +37,20 @@ public:
   virtual void clean() = 0;
   // Push the buffer contents to the display
   virtual void show() = 0;
+  // Layout of the frames taken by show(frame)
+  virtual FrameLayout frameLayout() const = 0;
+  // The buffer as the panel takes it. show(frame) expects these planes
+  // back to back.
+  virtual std::vector<FramePlane> framePlanes() const = 0;
+  // Push a frame that is already in the panel's layout to the display.
+  // It is sent from wherever it is, XIP flash included, without a copy.
+  virtual void show(const uint8_t* frame) = 0;
+  // Same, streaming the frame out of src (a decompressor, say) as it goes
+  virtual void show(ByteSource& frame) = 0;
+  // Send the buffer over the panel's SPI bus at the panel's speed, but with
+  // chip select on csPin, where nothing is listening. Times the link on its
+  // own (the bench command) without touching the panel.
+  virtual void uploadToDummy(uint csPin) = 0;
 };
 
 Inky::~Inky() {}
@@ -39,14 +59,21 @@ class InkyBase : public Inky
 {
 protected:
   InkyEeprom eeprom_;
-  SPIDevice spi_;
-  DiscreteIn busy_;
-  DiscreteOut reset_;
-  DiscreteOut dc_;
+  HalSpiDevice spi_;
+  HalInputPin busy_;
+  HalOutputPin reset_;
+  HalOutputPin dc_;
 
   std::shared_ptr<IndexedColorMap> colorMap_;
   IndexedColor border_;
   uint32_t sendCommandDelay_;
+  // The last command sent, which waitForBusy is waiting on
+  uint8_t lastCommand_ = 0;
+  // What spi_ was made with, for uploadToDummy
+  InkyConfig config_;
+  uint32_t spiSpeedHz_;
+  uint32_t spiTransferSizeBytes_;
+  std::optional<HalSpiDevice> dummySpi_;
 
   InkyBase(const InkyConfig& config, InkyEeprom InkyEeprom, uint32_t spiSpeedHz, uint32_t spiTransferSizeBytes, uint32_t sendCommandDelay) : 
     eeprom_{InkyEeprom},
@@ -63,7 +90,10 @@ protected:
     busy_{config.BUSY_PIN},
     reset_{config.RESET_PIN},
     dc_{config.DC_PIN},
-    sendCommandDelay_{sendCommandDelay}
+    sendCommandDelay_{sendCommandDelay},
+    config_{config},
+    spiSpeedHz_{spiSpeedHz},
+    spiTransferSizeBytes_{spiTransferSizeBytes}
   { }
 
   virtual void setBorder(IndexedColor color) override
@@ -81,15 +111,44 @@ protected:
     return *colorMap_;
   }
 
+  virtual void uploadToDummy(uint csPin) override
+  {
+    if (!dummySpi_)
+    {
+      dummySpi_.emplace(config_.SPIInstance, config_.SPI_MISO_PIN, config_.SPI_MOSI_PIN, config_.SPI_CLOCK_PIN,
+                        csPin, spiSpeedHz_, spiTransferSizeBytes_);
+    }
+    for (const FramePlane& plane : framePlanes())
+    {
+      dummySpi_->write(plane.data, plane.size);
+    }
+  }
+
+  // Sleeps and SPI writes go through these to be counted. Sleeping lets
+  // the scheduler's waiting tasks run.
+  void sleepMs(uint32_t ms)
+  {
+    Stats::add(StatCounter::SleepUs, (uint64_t)ms * 1000);
+    Scheduler::sleepMs(ms);
+  }
+
+  int writeSpi(const uint8_t* data, size_t len)
+  {
+    StatScope stat(StatCounter::SpiUs);
+    Stats::add(StatCounter::SpiBytes, len);
+    return spi_.write(data, len);
+  }
+
   template <typename C>
   void sendCommand(C command)
   {
+    lastCommand_ = (uint8_t)command;
     dc_.set(false);
-    sleep_ms(sendCommandDelay_);
+    sleepMs(sendCommandDelay_);
     #ifdef DEBUG_SPI
     std::cout << "Command " << (int)command << " ret: " << 
     #endif
-    spi_.write((uint8_t*)(&command), 1);
+    writeSpi((uint8_t*)(&command), 1);
     #ifdef DEBUG_SPI
     std::cout << std::endl;
     #endif
@@ -98,8 +157,6 @@ protected:
   template <typename C, typename T>
   void sendCommand(C command, const T& data)
   {
-    sendCommand(command);
-
     size_t len = 0;
     const uint8_t* dataPtr = nullptr;
 
@@ -128,14 +185,56 @@ protected:
       static_assert(std::is_trivial<T>() && std::is_standard_layout<T>(), "Unsupported data type!");
     }
 
+    sendCommand(command, dataPtr, len);
+  }
+
+  // Send len bytes straight out of dataPtr, which may be frame buffer
+  // sized and live in flash, yielding between chunks
+  template <typename C>
+  void sendCommand(C command, const uint8_t* dataPtr, size_t len)
+  {
+    sendCommand(command);
+
     dc_.set(true);
-    sleep_ms(sendCommandDelay_);
+    sleepMs(sendCommandDelay_);
+    TraceScope trace(TraceSpan::SpiUpload, lastCommand_);
     #ifdef DEBUG_SPI
-    std::cout << "Sent buffer len " << len << " ret: " << 
-    #endif
-    spi_.write(dataPtr, len);
-    #ifdef DEBUG_SPI
-    std::cout << std::endl;
+    std::cout << "Sent buffer len " << len << std::endl;
     #endif
+    while (len > 0)
+    {
+      size_t count = std::min(len, (size_t)StreamChunkSize);
+      writeSpi(dataPtr, count);
+      dataPtr += count;
+      len -= count;
+      Scheduler::yield();
+    }
+  }
+
+  // Send len bytes read from src, a chunk at a time
+  template <typename C>
+  bool sendCommand(C command, ByteSource& src, size_t len)
+  {
+    sendCommand(command);
+
+    dc_.set(true);
+    sleepMs(sendCommandDelay_);
+    TraceScope trace(TraceSpan::SpiUpload, lastCommand_);
+    std::vector<uint8_t> chunk(std::min(len, (size_t)StreamChunkSize));
+    while (len > 0)
+    {
+      uint32_t count = src.read(chunk.data(), std::min(len, chunk.size()));
+      if (count == 0)
+      {
+        PINKY_LOG(FrameEndedEarly, len);
+        return false;
+      }
+      writeSpi(chunk.data(), count);
+      len -= count;
+      Scheduler::yield();
+    }
+    return true;
   }
+
+  static constexpr uint32_t StreamChunkSize = 1024;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "InkyBase.hpp"
+#include "InkyPalettes.hpp"
 
 class InkyE673 final : public InkyBase
 {
@@ -37,23 +38,26 @@ class InkyE673 final : public InkyBase
 
   void waitForBusy(int timeoutMs = 40000)
   {
+    TraceScope trace(TraceSpan::WaitBusy, lastCommand_);
+    StatScope stat(StatCounter::BusyWaitUs);
+
     // If the busy_pin is *high* (pulled up by host)
     // then assume we're not getting a signal from inky
     // and wait the timeout period to be safe.
     if (busy_.get())
     {
-      sleep_ms(timeoutMs);
+      sleepMs(timeoutMs);
       return;
     }
 
     int i = 0;
     while (!busy_.get())
     {
-      sleep_ms(10);
+      sleepMs(10);
       ++i;
       if (i*10 > timeoutMs)
       {
-        DEBUG_LOG("Display operation is running long.");
+        PINKY_LOG(DisplayRunningLong);
         i = 0;
       }
     }
@@ -62,9 +66,9 @@ class InkyE673 final : public InkyBase
   void reset()
   {
     reset_.set(false);
-    sleep_ms(30);
+    sleepMs(30);
     reset_.set(true);
-    sleep_ms(30);
+    sleepMs(30);
 
     waitForBusy(300);
 
@@ -85,6 +89,22 @@ class InkyE673 final : public InkyBase
     sendCommand(InkyCommand::EL673_VDCS, (uint8_t)0x01);
   }
   
+  // Power up, refresh the panel from its RAM, and power down again
+  void refresh()
+  {
+    sendCommand(InkyCommand::EL673_PON);
+    sleepMs(300);
+
+    // second setting of the BTST2 register
+    sendCommand(InkyCommand::EL673_BTST2, (uint8_t[]){0x6F, 0x1F, 0x17, 0x49});
+
+    sendCommand(InkyCommand::EL673_DRF, (uint8_t)0x00);
+    waitForBusy(320000);
+
+    sendCommand(InkyCommand::EL673_POF, (uint8_t)0x00);
+    waitForBusy(300);
+  }
+
   std::shared_ptr<Packed4BitIndexedImage> buf_;
 
 public:
@@ -93,25 +113,7 @@ public:
     // Give a little warning if the display type is wrong
     DEBUG_LOG_IF(info.displayVariant != DisplayVariant::Spectra_6_7_3_800x480_E673, "Unsupported Inky display type!!");
 
-    colorMap_ = std::make_shared<IndexedColorMap>(ColorMapArgList{
-
-        // Emperically measured colors
-        // {ColorName::Black, 0, {30, 25, 40}},
-        // {ColorName::White, 1, {225, 215, 200}},
-        // {ColorName::Yellow, 2, {250, 200, 100}},
-        // {ColorName::Red, 3, {160, 28, 0}},
-        // {ColorName::Blue, 5, {21, 62, 150}},
-        // {ColorName::Green, 6, {70, 96, 70}}
-
-        // Tweaked colors
-        {ColorName::Black, 0, {0, 0, 0}},
-        {ColorName::White, 1, {190, 190, 190}},
-        {ColorName::Yellow, 2, {250, 200, 100}},
-        {ColorName::Red, 3, {160, 28, 0}},
-        {ColorName::Blue, 5, {20, 80, 150}},
-        {ColorName::Green, 6, {50, 130, 60}}
-
-    });
+    colorMap_ = inkyE673ColorMap();
     border_ = colorMap_->toIndexedColor(ColorName::Black);
 
     buf_ = std::make_shared<Packed4BitIndexedImage>(eeprom_.width, eeprom_.height);
@@ -130,20 +132,33 @@ public:
 
   virtual void show() override
   {
-    reset();
+    show(buf_->getData().data());
+  }
 
-    sendCommand(InkyCommand::EL673_DTM1, buf_->getData());
-    sendCommand(InkyCommand::EL673_PON);
-    sleep_ms(300);
+  virtual FrameLayout frameLayout() const override
+  {
+    return FrameLayout::Packed4Bit;
+  }
 
-    // second setting of the BTST2 register
-    sendCommand(InkyCommand::EL673_BTST2, (uint8_t[]){0x6F, 0x1F, 0x17, 0x49});
+  virtual std::vector<FramePlane> framePlanes() const override
+  {
+    return {{buf_->getData().data(), (uint32_t)buf_->getData().size()}};
+  }
 
-    sendCommand(InkyCommand::EL673_DRF, (uint8_t)0x00);
-    waitForBusy(320000);
+  virtual void show(const uint8_t* frame) override
+  {
+    reset();
+    sendCommand(InkyCommand::EL673_DTM1, frame, buf_->getData().size());
+    refresh();
+  }
 
-    sendCommand(InkyCommand::EL673_POF, (uint8_t)0x00);
-    waitForBusy(300);
+  virtual void show(ByteSource& frame) override
+  {
+    reset();
+    if (sendCommand(InkyCommand::EL673_DTM1, frame, buf_->getData().size()))
+    {
+      refresh();
+    }
   }
 
   virtual void clear() override
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Image.hpp"
+#include "IndexedColor.hpp"
+#include "InkyEeprom.hpp"
+
+#include <memory>
+
+// The color maps and frame buffers of each Inky driver, kept apart from the
+// drivers so host tools render exactly what the device would
+
+// Seven colour UC8159 panels (Impression 5.7")
+inline std::shared_ptr<IndexedColorMap> inkyUC8159ColorMap()
+{
+  return std::make_shared<IndexedColorMap>(ColorMapArgList{
+      // Emperically measured colors
+      {ColorName::Black, 0, {36, 39, 63}},
+      //{ColorName::Black, 0, {0, 0, 0}},
+      //{ColorName::White, 1, {195, 185, 184}},
+      {ColorName::White, 1, {240, 230, 230}},
+      //{ColorName::White, 1, {255, 255, 255}},
+      {ColorName::Green, 2, {56, 76, 46}},
+      {ColorName::Blue, 3, {59, 54, 86}},
+      {ColorName::Red, 4, {133, 55, 46}},
+      {ColorName::Yellow, 5, {195, 158, 56}},
+      {ColorName::Orange, 6, {159, 83, 57}}
+  });
+}
+
+// Spectra 6 E673 panels (Impression Spectra 7.3")
+inline std::shared_ptr<IndexedColorMap> inkyE673ColorMap()
+{
+  return std::make_shared<IndexedColorMap>(ColorMapArgList{
+
+      // Emperically measured colors
+      // {ColorName::Black, 0, {30, 25, 40}},
+      // {ColorName::White, 1, {225, 215, 200}},
+      // {ColorName::Yellow, 2, {250, 200, 100}},
+      // {ColorName::Red, 3, {160, 28, 0}},
+      // {ColorName::Blue, 5, {21, 62, 150}},
+      // {ColorName::Green, 6, {70, 96, 70}}
+
+      // Tweaked colors
+      {ColorName::Black, 0, {0, 0, 0}},
+      {ColorName::White, 1, {190, 190, 190}},
+      {ColorName::Yellow, 2, {250, 200, 100}},
+      {ColorName::Red, 3, {160, 28, 0}},
+      {ColorName::Blue, 5, {20, 80, 150}},
+      {ColorName::Green, 6, {50, 130, 60}}
+
+  });
+}
+
+// SSD1683 panels (wHAT 4.2"), null for a capability they don't come in
+inline std::shared_ptr<IndexedColorMap> inkySSD1683ColorMap(ColorCapability capability)
+{
+  if (capability == ColorCapability::BlackWhite)
+  {
+    return std::make_shared<IndexedColorMap>(ColorMapArgList{
+      {ColorName::White, 0, ColorNameToSaturatedRGBColor(ColorName::White)},
+      {ColorName::Black, 1, ColorNameToSaturatedRGBColor(ColorName::Black)}
+    });
+  }
+  else if (capability == ColorCapability::BlackWhiteRed)
+  {
+    return std::make_shared<IndexedColorMap>(ColorMapArgList{
+      {ColorName::White, 0, ColorNameToSaturatedRGBColor(ColorName::White)},
+      {ColorName::Black, 1, ColorNameToSaturatedRGBColor(ColorName::Black)},
+      {ColorName::Red, 2, ColorNameToSaturatedRGBColor(ColorName::Red)}
+    });
+  }
+  else if (capability == ColorCapability::BlackWhiteYellow)
+  {
+    return std::make_shared<IndexedColorMap>(ColorMapArgList{
+      {ColorName::White, 0, ColorNameToSaturatedRGBColor(ColorName::White)},
+      {ColorName::Black, 1, ColorNameToSaturatedRGBColor(ColorName::Black)},
+      {ColorName::Yellow, 2, ColorNameToSaturatedRGBColor(ColorName::Yellow)}
+    });
+  }
+  return nullptr;
+}
+
+// The black and color RAM planes of an SSD1683 panel, from a map made by
+// inkySSD1683ColorMap
+inline std::shared_ptr<PackedTwoPlaneBinaryImage> inkySSD1683Frame(int width, int height, const IndexedColorMap& colorMap, ColorCapability capability)
+{
+  IndexedColor color = colorMap.toIndexedColor(ColorName::Red);
+  if (capability == ColorCapability::BlackWhiteYellow)
+  {
+    color = colorMap.toIndexedColor(ColorName::Yellow);
+  }
+
+  return std::make_shared<PackedTwoPlaneBinaryImage>(
+    width,
+    height,
+    colorMap.toIndexedColor(ColorName::Black),
+    colorMap.toIndexedColor(ColorName::White),
+    color,
+    color
+  );
+}
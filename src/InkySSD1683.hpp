@@ -3,6 +3,7 @@
 #include "InkyBase.hpp"
 #include "Image.hpp"
 #include "ImageConvert.hpp"
+#include "InkyPalettes.hpp"
 
 class InkySSD1683 final : public InkyBase
 {
@@ -51,14 +52,17 @@ class InkySSD1683 final : public InkyBase
 
   void waitForBusy(int timeoutMs = 5000)
   {
+    TraceScope trace(TraceSpan::WaitBusy, lastCommand_);
+    StatScope stat(StatCounter::BusyWaitUs);
+
     int i = 0;
     while (busy_.get())
     {
-      sleep_ms(10);
+      sleepMs(10);
       ++i;
       if (i*10 > timeoutMs)
       {
-        DEBUG_LOG("Display operation is running long.");
+        PINKY_LOG(DisplayRunningLong);
         i = 0;
       }
     }
@@ -68,78 +72,16 @@ class InkySSD1683 final : public InkyBase
   {
     // Perform a hardware reset
     reset_.set(false);
-    sleep_ms(500);
+    sleepMs(500);
     reset_.set(true);
-    sleep_ms(500);
+    sleepMs(500);
     sendCommand(InkyCommand::SSD1683_SW_RESET);
-    sleep_ms(1000);
+    sleepMs(1000);
     waitForBusy();
   }
 
-  std::shared_ptr<PackedTwoPlaneBinaryImage> buf_;
-
-public:
-  InkySSD1683(const InkyConfig& config, InkyEeprom info) : InkyBase(config, info, SPIDeviceSpeedHz, SPITransferSize, SendCommandDelay)
-  {
-    if (info.displayVariant != DisplayVariant::Black_wHAT_SSD1683 &&
-        info.displayVariant != DisplayVariant::Red_wHAT_SSD1683 &&
-        info.displayVariant != DisplayVariant::Yellow_wHAT_SSD1683)
-    {
-      DEBUG_LOG("WARNING: Unsupported display type for InkySSD1683!");
-    }
-
-    if (info.colorCapability == ColorCapability::BlackWhite)
-    {
-      colorMap_ = std::make_shared<IndexedColorMap>(ColorMapArgList{
-        {ColorName::White, 0, ColorNameToSaturatedRGBColor(ColorName::White)},
-        {ColorName::Black, 1, ColorNameToSaturatedRGBColor(ColorName::Black)}
-      });
-    }
-    else if (info.colorCapability == ColorCapability::BlackWhiteRed)
-    {
-      colorMap_ = std::make_shared<IndexedColorMap>(ColorMapArgList{
-        {ColorName::White, 0, ColorNameToSaturatedRGBColor(ColorName::White)},
-        {ColorName::Black, 1, ColorNameToSaturatedRGBColor(ColorName::Black)},
-        {ColorName::Red, 2, ColorNameToSaturatedRGBColor(ColorName::Red)}
-      });
-    }
-    else if (info.colorCapability == ColorCapability::BlackWhiteYellow)
-    {
-      colorMap_ = std::make_shared<IndexedColorMap>(ColorMapArgList{
-        {ColorName::White, 0, ColorNameToSaturatedRGBColor(ColorName::White)},
-        {ColorName::Black, 1, ColorNameToSaturatedRGBColor(ColorName::Black)},
-        {ColorName::Yellow, 2, ColorNameToSaturatedRGBColor(ColorName::Yellow)}
-      });
-    }
-
-    border_ = colorMap_->toIndexedColor(ColorName::Black);
-
-    // Setup the GPIO pins
-    dc_.set(false);
-    reset_.set(true);
-
-    IndexedColor color = colorMap_->toIndexedColor(ColorName::Red);
-    if (eeprom_.colorCapability == ColorCapability::BlackWhiteYellow)
-    {
-      color = colorMap_->toIndexedColor(ColorName::Yellow);
-    }
-
-    buf_ = std::make_shared<PackedTwoPlaneBinaryImage>(
-      eeprom_.width,
-      eeprom_.height,
-      colorMap_->toIndexedColor(ColorName::Black),
-      colorMap_->toIndexedColor(ColorName::White), 
-      color,
-      color
-    );
-  }
-
-  virtual ImageView<IndexedColor>& bufferIndexed() override
-  {
-    return *buf_;
-  }
-
-  virtual void show() override
+  // Reset and set the panel up to take a new frame
+  void beginFrame()
   {
     reset();
 
@@ -183,16 +125,104 @@ public:
     // Set RAM address to 0, 0
     sendCommand(InkyCommand::SSD1683_SET_RAMXCOUNT, uint8_t{0x00});
     sendCommand(InkyCommand::SSD1683_SET_RAMYCOUNT, (uint8_t[2]){0x00, 0x00});
-    
-    sendCommand(InkyCommand::SSD1683_WRITE_RAM, buf_->getPlane(PackedTwoPlaneBinaryImage::Plane::Black));
+  }
+
+  // Refresh the panel from its RAM
+  void activate()
+  {
+    waitForBusy();
+    sendCommand(InkyCommand::SSD1683_MASTER_ACTIVATE);
+  }
+
+  bool hasColorPlane() const
+  {
+    return eeprom_.colorCapability != ColorCapability::BlackWhite;
+  }
+
+  size_t planeSize() const
+  {
+    return buf_->getPlane(PackedTwoPlaneBinaryImage::Plane::Black).size();
+  }
 
-    if (eeprom_.colorCapability != ColorCapability::BlackWhite)
+  std::shared_ptr<PackedTwoPlaneBinaryImage> buf_;
+
+public:
+  InkySSD1683(const InkyConfig& config, InkyEeprom info) : InkyBase(config, info, SPIDeviceSpeedHz, SPITransferSize, SendCommandDelay)
+  {
+    if (info.displayVariant != DisplayVariant::Black_wHAT_SSD1683 &&
+        info.displayVariant != DisplayVariant::Red_wHAT_SSD1683 &&
+        info.displayVariant != DisplayVariant::Yellow_wHAT_SSD1683)
+    {
+      DEBUG_LOG("WARNING: Unsupported display type for InkySSD1683!");
+    }
+
+    colorMap_ = inkySSD1683ColorMap(info.colorCapability);
+
+    border_ = colorMap_->toIndexedColor(ColorName::Black);
+
+    // Setup the GPIO pins
+    dc_.set(false);
+    reset_.set(true);
+
+    buf_ = inkySSD1683Frame(eeprom_.width, eeprom_.height, *colorMap_, eeprom_.colorCapability);
+  }
+
+  virtual ImageView<IndexedColor>& bufferIndexed() override
+  {
+    return *buf_;
+  }
+
+  virtual void show() override
+  {
+    beginFrame();
+    sendCommand(InkyCommand::SSD1683_WRITE_RAM, buf_->getPlane(PackedTwoPlaneBinaryImage::Plane::Black));
+    if (hasColorPlane())
     {
       sendCommand(InkyCommand::SSD1683_WRITE_ALTRAM, buf_->getPlane(PackedTwoPlaneBinaryImage::Plane::Color));
     }
+    activate();
+  }
 
-    waitForBusy();
-    sendCommand(InkyCommand::SSD1683_MASTER_ACTIVATE);
+  virtual FrameLayout frameLayout() const override
+  {
+    return FrameLayout::TwoPlaneBinary;
+  }
+
+  // Black and white panels never look at the color plane
+  virtual std::vector<FramePlane> framePlanes() const override
+  {
+    const auto& black = buf_->getPlane(PackedTwoPlaneBinaryImage::Plane::Black);
+    const auto& color = buf_->getPlane(PackedTwoPlaneBinaryImage::Plane::Color);
+    if (eeprom_.colorCapability == ColorCapability::BlackWhite)
+    {
+      return {{black.data(), (uint32_t)black.size()}};
+    }
+    return {{black.data(), (uint32_t)black.size()}, {color.data(), (uint32_t)color.size()}};
+  }
+
+  virtual void show(const uint8_t* frame) override
+  {
+    beginFrame();
+    sendCommand(InkyCommand::SSD1683_WRITE_RAM, frame, planeSize());
+    if (hasColorPlane())
+    {
+      sendCommand(InkyCommand::SSD1683_WRITE_ALTRAM, frame + planeSize(), planeSize());
+    }
+    activate();
+  }
+
+  virtual void show(ByteSource& frame) override
+  {
+    beginFrame();
+    bool ok = sendCommand(InkyCommand::SSD1683_WRITE_RAM, frame, planeSize());
+    if (ok && hasColorPlane())
+    {
+      ok = sendCommand(InkyCommand::SSD1683_WRITE_ALTRAM, frame, planeSize());
+    }
+    if (ok)
+    {
+      activate();
+    }
   }
 
   virtual void clear() override
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "InkyBase.hpp"
+#include "InkyPalettes.hpp"
 
 class InkyUC8159 final : public InkyBase
 {
@@ -55,6 +56,7 @@ class InkyUC8159 final : public InkyBase
   CorrectionData correctionData;
   void reset();
   void waitForBusy(int timeoutMs = 40000);
+  void refresh();
 
   std::shared_ptr<Packed4BitIndexedImage> buf_;
 
@@ -86,19 +88,7 @@ public:
         break;
     }
 
-    colorMap_ = std::make_shared<IndexedColorMap>(ColorMapArgList{
-        // Emperically measured colors
-        {ColorName::Black, 0, {36, 39, 63}},
-        //{ColorName::Black, 0, {0, 0, 0}},
-        //{ColorName::White, 1, {195, 185, 184}},
-        {ColorName::White, 1, {240, 230, 230}},
-        //{ColorName::White, 1, {255, 255, 255}},
-        {ColorName::Green, 2, {56, 76, 46}},
-        {ColorName::Blue, 3, {59, 54, 86}},
-        {ColorName::Red, 4, {133, 55, 46}},
-        {ColorName::Yellow, 5, {195, 158, 56}},
-        {ColorName::Orange, 6, {159, 83, 57}}
-    });
+    colorMap_ = inkyUC8159ColorMap();
     border_ = colorMap_->toIndexedColor(ColorName::Black);
 
     // Correct the eeprom and buffer sizes
@@ -117,7 +107,36 @@ public:
     return *buf_;
   }
 
-  virtual void show() override;
+  virtual void show() override
+  {
+    show(buf_->getData().data());
+  }
+
+  virtual FrameLayout frameLayout() const override
+  {
+    return FrameLayout::Packed4Bit;
+  }
+
+  virtual std::vector<FramePlane> framePlanes() const override
+  {
+    return {{buf_->getData().data(), (uint32_t)buf_->getData().size()}};
+  }
+
+  virtual void show(const uint8_t* frame) override
+  {
+    reset();
+    sendCommand(InkyCommand::UC8159_DTM1, frame, buf_->getData().size());
+    refresh();
+  }
+
+  virtual void show(ByteSource& frame) override
+  {
+    reset();
+    if (sendCommand(InkyCommand::UC8159_DTM1, frame, buf_->getData().size()))
+    {
+      refresh();
+    }
+  }
 
   virtual void clear() override
   {
@@ -148,7 +167,7 @@ public:
 void InkyUC8159::reset()
 {
     reset_.set(false);
-    sleep_ms(100);
+    sleepMs(100);
     reset_.set(true);
 
     waitForBusy(1000);
@@ -222,34 +241,34 @@ void InkyUC8159::reset()
 
 void InkyUC8159::waitForBusy(int timeoutMs)
 {
+  TraceScope trace(TraceSpan::WaitBusy, lastCommand_);
+  StatScope stat(StatCounter::BusyWaitUs);
+
   // If the busy_pin is *high* (pulled up by host)
   // then assume we're not getting a signal from inky
   // and wait the timeout period to be safe.
   if (busy_.get())
   {
-    sleep_ms(timeoutMs);
+    sleepMs(timeoutMs);
     return;
   }
 
   int i = 0;
   while (!busy_.get())
   {
-    sleep_ms(10);
+    sleepMs(10);
     ++i;
     if (i*10 > timeoutMs)
     {
-      DEBUG_LOG("Display operation is running long.");
+      PINKY_LOG(DisplayRunningLong);
       i = 0;
     }
   }
 }
 
-void InkyUC8159::show()
+// Power up, refresh the panel from its RAM, and power down again
+void InkyUC8159::refresh()
 {
-  reset();
-
-  sendCommand(InkyCommand::UC8159_DTM1, buf_->getData());
-
   sendCommand(InkyCommand::UC8159_PON);
   waitForBusy(200);
 
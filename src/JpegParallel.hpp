@@ -0,0 +1,679 @@
+#pragma once
+
+#include "ByteSource.hpp"
+#include "DeferredLog.hpp"
+#include "ImageDecode.hpp"
+#include "ScratchArena.hpp"
+#include "SecondCore.hpp"
+#include "SpscRing.hpp"
+#include "Trace.hpp"
+
+
+#include <picojpeg.h>
+
+#include <atomic>
+#include <numeric>
+#include <optional>
+#include <string.h>
+
+// JPEGs without usable restart intervals can be pipelined across the cores
+// (decodeImageJPGPipelined), but that has yet to beat decoding on core0
+// alone on the device, so they only are with PINKY_JPEG_PIPELINE=1. bench's
+// decode/jpeg-pipelined stage against decode/jpeg is the figure to check.
+#ifndef PINKY_JPEG_PIPELINE
+#define PINKY_JPEG_PIPELINE 0
+#endif
+
+// The second picojpeg instance, built from picojpeg_core1.c
+extern "C"
+{
+  unsigned char pjpeg_core1_decode_init(pjpeg_image_info_t *pInfo, pjpeg_need_bytes_callback_t pNeed_bytes_callback, void *pCallback_data, unsigned char reduce);
+  unsigned char pjpeg_core1_decode_mcu(void);
+}
+
+constexpr PicoJpegDecoder Core1JpegDecoder {pjpeg_core1_decode_init, pjpeg_core1_decode_mcu};
+
+// One picojpeg instance per worker, so this is also the number of workers
+constexpr int JpegDecodeWorkers = 2;
+
+// Strips are the smallest run of whole restart intervals that also covers
+// whole MCU rows. Larger strips need too much RAM to be worth it.
+constexpr int MaxStripMcuRows = 2;
+
+// Scratch for decoding a JPEG in parallel into a buffer this wide: both
+// workers' strip buffers, with room for partly visible MCUs at either side
+constexpr size_t jpegParallelScratchBytes(int width)
+{
+  return (size_t)JpegDecodeWorkers * MaxStripMcuRows * 16 * (width + 32) * sizeof(RGBColor);
+}
+
+// Where the pieces of a baseline JPEG are
+struct JpegLayout
+{
+  int width = 0;
+  int height = 0;
+  int mcuWidth = 0;
+  int mcuHeight = 0;
+  int restartInterval = 0;
+
+  // Everything up to the start of the entropy coded data
+  uint32_t headerSize = 0;
+
+  // Entropy coded segments, split at the restart markers. The markers
+  // themselves are not included. They live in scratch, with room for as
+  // many as the restart interval makes.
+  uint32_t* segmentBegin = nullptr;
+  uint32_t* segmentEnd = nullptr;
+  int segmentsFound = 0;
+  std::optional<ScratchBuffer<uint32_t>> segmentStorage;
+
+  int mcusPerRow() const { return (width + mcuWidth - 1) / mcuWidth; }
+  int mcusPerCol() const { return (height + mcuHeight - 1) / mcuHeight; }
+  int segmentCount() const { return segmentsFound; }
+
+  int maxSegments() const
+  {
+    int totalMcus = mcusPerRow() * mcusPerCol();
+    return restartInterval > 0 ? (totalMcus + restartInterval - 1) / restartInterval : 1;
+  }
+
+  bool addSegment(uint32_t begin, uint32_t end)
+  {
+    if (segmentsFound == maxSegments())
+    {
+      return false;
+    }
+    segmentBegin[segmentsFound] = begin;
+    segmentEnd[segmentsFound] = end;
+    ++segmentsFound;
+    return true;
+  }
+};
+
+inline uint16_t readBigEndian16(const uint8_t* p)
+{
+  return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+// Find the frame size, restart interval and restart segments of a JPEG.
+// Returns false for anything that is not a single scan baseline JPEG.
+inline bool scanJpegLayout(const uint8_t* data, uint32_t size, JpegLayout& layout)
+{
+  if (size < 4 || data[0] != 0xFF || data[1] != 0xD8)
+  {
+    return false;
+  }
+
+  // Walk the marker segments up to the start of scan
+  uint32_t pos = 2;
+  while (layout.headerSize == 0)
+  {
+    while (pos < size && data[pos] == 0xFF)
+    {
+      ++pos;
+    }
+    if (pos + 2 >= size)
+    {
+      return false;
+    }
+    uint8_t marker = data[pos++];
+    uint16_t length = readBigEndian16(data + pos);
+    if (length < 2 || pos + length > size)
+    {
+      return false;
+    }
+    const uint8_t* segment = data + pos + 2;
+
+    switch (marker)
+    {
+      case 0xC0: // Baseline
+      case 0xC1: // Extended sequential
+      {
+        if (length < 8)
+        {
+          return false;
+        }
+        layout.height = readBigEndian16(segment + 1);
+        layout.width = readBigEndian16(segment + 3);
+        int comps = segment[5];
+        if (comps < 1 || length < 8 + 3 * comps)
+        {
+          return false;
+        }
+        int maxH = 1;
+        int maxV = 1;
+        if (comps > 1)
+        {
+          for (int i=0; i < comps; ++i)
+          {
+            maxH = std::max(maxH, segment[7 + i*3] >> 4);
+            maxV = std::max(maxV, segment[7 + i*3] & 0x0F);
+          }
+        }
+        layout.mcuWidth = 8 * maxH;
+        layout.mcuHeight = 8 * maxV;
+        break;
+      }
+      case 0xDD: // Define restart interval
+        layout.restartInterval = readBigEndian16(segment);
+        break;
+      case 0xDA: // Start of scan
+        layout.headerSize = pos + length;
+        break;
+      default:
+        // Progressive, lossless and arithmetic coded frames are out
+        if (marker >= 0xC2 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+        {
+          return false;
+        }
+        break;
+    }
+    pos += length;
+  }
+
+  if (layout.width == 0 || layout.height == 0)
+  {
+    return false;
+  }
+  int maxSegments = layout.maxSegments();
+  ScratchBuffer<uint32_t>& segments = layout.segmentStorage.emplace(2 * maxSegments);
+  layout.segmentBegin = segments.data();
+  layout.segmentEnd = segments.data() + maxSegments;
+
+  // Split the entropy coded data at restart markers, stopping at the
+  // first other marker (normally EOI)
+  uint32_t begin = layout.headerSize;
+  pos = begin;
+  while (pos + 1 < size)
+  {
+    const uint8_t* ff = (const uint8_t*)memchr(data + pos, 0xFF, size - pos - 1);
+    if (!ff)
+    {
+      break;
+    }
+    pos = (uint32_t)(ff - data);
+    uint8_t next = data[pos + 1];
+    if (next == 0x00 || next == 0xFF)
+    {
+      // Stuffed byte or fill byte
+      pos += 1 + (next == 0x00);
+      continue;
+    }
+
+    // More segments than the restart interval allows can't be split
+    if (!layout.addSegment(begin, pos))
+    {
+      return false;
+    }
+    if (next < 0xD0 || next > 0xD7)
+    {
+      return true;
+    }
+    begin = pos + 2;
+    pos = begin;
+  }
+
+  // No end marker, the last segment runs to the end of the data
+  return layout.addSegment(begin, size);
+}
+
+// The JPEG as seen by one worker: the original header followed by only the
+// restart segments of the strips assigned to it. The restart markers
+// between them are renumbered so the worker's decoder sees an ordinary,
+// if shorter, image.
+class RestartStripStream : public ByteSource
+{
+public:
+  RestartStripStream(const uint8_t* jpeg, const JpegLayout& layout, int segmentsPerStrip,
+                     int firstStrip, int stripStride, int endStrip)
+    : jpeg_{jpeg}
+    , layout_{layout}
+    , segmentsPerStrip_{segmentsPerStrip}
+    , strip_{firstStrip}
+    , stripStride_{stripStride}
+    , endStrip_{endStrip}
+    , segment_{firstStrip * segmentsPerStrip}
+  {
+    // Total up the output so remaining() is exact
+    remaining_ = layout.headerSize + 2;
+    for (int s = firstStrip; s < endStrip; s += stripStride)
+    {
+      for (int i = s * segmentsPerStrip; i < stripSegmentEnd(s); ++i)
+      {
+        remaining_ += layout.segmentEnd[i] - layout.segmentBegin[i] + 2;
+      }
+    }
+    remaining_ -= 2;
+  }
+
+  virtual uint32_t remaining() const override
+  {
+    return remaining_;
+  }
+
+  virtual uint32_t read(uint8_t* dest, uint32_t len) override
+  {
+    uint32_t total = 0;
+    while (total < len)
+    {
+      if (pieceLeft_ == 0 && !nextPiece())
+      {
+        break;
+      }
+      uint32_t count = std::min(len - total, pieceLeft_);
+      memcpy(dest + total, piece_, count);
+      piece_ += count;
+      pieceLeft_ -= count;
+      total += count;
+    }
+    remaining_ -= total;
+    return total;
+  }
+
+  virtual void discard() override
+  {
+    next_ = Piece::Done;
+    pieceLeft_ = 0;
+    remaining_ = 0;
+  }
+
+private:
+  enum class Piece { Header, Segment, Restart, End, Done };
+
+  int stripSegmentEnd(int strip) const
+  {
+    return std::min((strip + 1) * segmentsPerStrip_, layout_.segmentCount());
+  }
+
+  bool nextPiece()
+  {
+    switch (next_)
+    {
+      case Piece::Header:
+        setPiece(jpeg_, layout_.headerSize);
+        next_ = Piece::Segment;
+        return true;
+
+      case Piece::Segment:
+        setPiece(jpeg_ + layout_.segmentBegin[segment_], layout_.segmentEnd[segment_] - layout_.segmentBegin[segment_]);
+        if (++segment_ == stripSegmentEnd(strip_))
+        {
+          strip_ += stripStride_;
+          segment_ = strip_ * segmentsPerStrip_;
+        }
+        next_ = (strip_ < endStrip_) ? Piece::Restart : Piece::End;
+        return true;
+
+      case Piece::Restart:
+        marker_[0] = 0xFF;
+        marker_[1] = 0xD0 + (restartCount_++ % 8);
+        setPiece(marker_, 2);
+        next_ = Piece::Segment;
+        return true;
+
+      case Piece::End:
+        marker_[0] = 0xFF;
+        marker_[1] = 0xD9;
+        setPiece(marker_, 2);
+        next_ = Piece::Done;
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  void setPiece(const uint8_t* data, uint32_t size)
+  {
+    piece_ = data;
+    pieceLeft_ = size;
+  }
+
+  const uint8_t* jpeg_;
+  const JpegLayout& layout_;
+  int segmentsPerStrip_;
+  int strip_;
+  int stripStride_;
+  int endStrip_;
+  int segment_;
+  int restartCount_ = 0;
+  Piece next_ = Piece::Header;
+  const uint8_t* piece_ = nullptr;
+  uint32_t pieceLeft_ = 0;
+  uint32_t remaining_ = 0;
+  uint8_t marker_[2];
+};
+
+// One decoder working through every JpegDecodeWorkers'th strip into its
+// own strip buffer, which the reader hands on before the next one starts
+struct JpegStripWorker
+{
+  JpegStripWorker(const PicoJpegDecoder& decoder, const uint8_t* jpeg, const JpegLayout& layout,
+                  int segmentsPerStrip, int rowsPerStrip, int firstStrip, int endStrip)
+    : decoder{decoder}
+    , stream{jpeg, layout, segmentsPerStrip, firstStrip, JpegDecodeWorkers, endStrip}
+    , rowsPerStrip{rowsPerStrip}
+    , firstStrip{firstStrip}
+    , endStrip{endStrip}
+  { }
+
+  bool init(const JpegLayout& layout)
+  {
+    if (decoder.init(&info, readJpegBytes, &stream, 0) != 0)
+    {
+      return false;
+    }
+    copyFunc = selectMcuCopyFunc(info.m_scanType);
+    return copyFunc && info.m_MCUWidth == layout.mcuWidth && info.m_MCUHeight == layout.mcuHeight &&
+           info.m_MCUSPerRow == layout.mcusPerRow() && info.m_MCUSPerCol == layout.mcusPerCol();
+  }
+
+  int stripRowEnd(int strip) const
+  {
+    return std::min((strip + 1) * rowsPerStrip, info.m_MCUSPerCol);
+  }
+
+  bool decodeStrip(int strip)
+  {
+    RGBColor* line = lines;
+    for (int mcuY = strip * rowsPerStrip; mcuY < stripRowEnd(strip); ++mcuY)
+    {
+      TraceScope trace(TraceSpan::DecodeRow, mcuY);
+      if (decodeMcuRow(decoder, info, *window, copyFunc, line) != 0)
+      {
+        return false;
+      }
+      line += window->decodeWidth * info.m_MCUHeight;
+    }
+    return true;
+  }
+
+  // Worker loop for the second core
+  static void run(void* arg)
+  {
+    JpegStripWorker& w = *(JpegStripWorker*)arg;
+    for (int strip = w.firstStrip; strip < w.endStrip; strip += JpegDecodeWorkers)
+    {
+      // Wait for the reader to be done with the previous strip
+      while (w.readyStrip.load(std::memory_order_acquire) >= 0)
+      {
+        if (w.abort.load(std::memory_order_relaxed))
+        {
+          return;
+        }
+        SecondCore::relax();
+      }
+
+      if (!w.decodeStrip(strip))
+      {
+        w.failed.store(true, std::memory_order_release);
+        return;
+      }
+      w.readyStrip.store(strip, std::memory_order_release);
+    }
+  }
+
+  PicoJpegDecoder decoder;
+  RestartStripStream stream;
+  pjpeg_image_info_t info;
+  McuCopyFunc copyFunc = nullptr;
+  const JpegDecodeWindow* window = nullptr;
+  int rowsPerStrip;
+  int firstStrip;
+  int endStrip;
+  // Strip buffer, in scratch
+  RGBColor* lines = nullptr;
+
+  // Strip waiting in lines for the reader, or -1 when lines is free
+  std::atomic<int> readyStrip {-1};
+  std::atomic<bool> failed {false};
+  std::atomic<bool> abort {false};
+};
+
+// Decoded MCU rows waiting to be handed on. Two lets core1 decode the next
+// row while core0 converts the last one.
+constexpr uint32_t JpegPipelineDepth = 2;
+
+// One row of MCUs passed from the decoding core to the converting core
+struct McuRowBlock
+{
+  int mcuY = 0;
+  unsigned char status = 0;
+  RGBColor* lines = nullptr;
+};
+
+// Runs picojpeg on the second core, feeding decoded MCU rows to core0
+struct JpegPipelineProducer
+{
+  const pjpeg_image_info_t& info;
+  const JpegDecodeWindow& window;
+  McuCopyFunc copyFunc;
+  SpscRing<McuRowBlock>& ring;
+
+  static void run(void* arg)
+  {
+    JpegPipelineProducer& p = *(JpegPipelineProducer*)arg;
+    for (int mcuY = 0; mcuY < p.window.mcuYEnd; ++mcuY)
+    {
+      // Rows above the visible region only need decoding past, unless
+      // there is an error to report
+      unsigned char status = 0;
+      bool visibleRow = mcuY >= p.window.mcuYBegin;
+      if (!visibleRow)
+      {
+        TraceScope trace(TraceSpan::DecodeRow, mcuY);
+        status = decodeMcuRow(DefaultJpegDecoder, p.info, p.window, p.copyFunc, nullptr);
+        if (status == 0)
+        {
+          continue;
+        }
+      }
+
+      McuRowBlock* block;
+      while (!(block = p.ring.writeSlot()))
+      {
+        SecondCore::relax();
+      }
+      TraceScope trace(TraceSpan::DecodeRow, mcuY);
+      block->mcuY = mcuY;
+      block->status = visibleRow ? decodeMcuRow(DefaultJpegDecoder, p.info, p.window, p.copyFunc, block->lines) : status;
+      bool failed = block->status != 0;
+      p.ring.commitWrite();
+      if (failed)
+      {
+        return;
+      }
+    }
+  }
+};
+
+// Decode a JPEG as a row-level producer/consumer pipeline, for frames
+// without restart markers, which can't be split into strips. core1 does
+// all of picojpeg's work (source reads, Huffman decoding, IDCT and color
+// conversion, which all happen inside pjpeg_decode_mcu) a row of MCUs at a
+// time, while core0 copies the finished rows into buffer, where they get
+// converted and dithered. The stages aren't split inside picojpeg, so this
+// only gains as much as the dither on core0 overlaps with decoding on
+// core1, never more than 2x.
+template <typename PixelT>
+bool decodeImageJPGPipelined(int width, int height, ByteSource& src, ImageView<PixelT>& buffer, ProgressUpdateCallback progressCb = nullptr)
+{
+  if (!SecondCore::available())
+  {
+    return decodeImageJPG(width, height, src, buffer, progressCb);
+  }
+
+  // The header is read here, the entropy coded data on core1
+  pjpeg_image_info_t info;
+  McuCopyFunc copyFunc = beginJpegDecode(DefaultJpegDecoder, src, info);
+  if (!copyFunc)
+  {
+    return false;
+  }
+
+  JpegDecodeWindow window = jpegDecodeWindow(buffer, info);
+  size_t blockPixels = (size_t)window.decodeWidth * info.m_MCUHeight;
+  ScratchBuffer<RGBColor> lines(JpegPipelineDepth * blockPixels);
+  McuRowBlock blocks[JpegPipelineDepth];
+  for (uint32_t i=0; i < JpegPipelineDepth; ++i)
+  {
+    blocks[i].lines = lines.data() + i * blockPixels;
+  }
+  SpscRing<McuRowBlock> ring(blocks, JpegPipelineDepth);
+  JpegPipelineProducer producer {info, window, copyFunc, ring};
+  SecondCore::launch(JpegPipelineProducer::run, &producer);
+
+  bool ok = true;
+  for (int mcuY = window.mcuYBegin; mcuY < window.mcuYEnd; ++mcuY)
+  {
+    McuRowBlock* block;
+    while (!(block = ring.readSlot()))
+    {
+      SecondCore::relax();
+    }
+
+    // The producer stops after the first error
+    if (block->status != 0)
+    {
+      PINKY_LOG(JpegDecodeError, block->status);
+      ok = false;
+      break;
+    }
+
+    writeDecodedLines(buffer, window, block->lines, block->mcuY * info.m_MCUHeight, info.m_MCUHeight);
+    ring.commitRead();
+
+    if (progressCb)
+    {
+      progressCb((float)(mcuY - window.mcuYBegin) / (float)(window.mcuYEnd - window.mcuYBegin));
+    }
+  }
+
+  SecondCore::join();
+  return ok;
+}
+
+// Decode a JPEG that can't be split into strips, as it is read: on core0,
+// or pipelined across the cores with PINKY_JPEG_PIPELINE
+template <typename PixelT>
+bool decodeImageJPGUnsplit(int width, int height, ByteSource& src, ImageView<PixelT>& buffer, ProgressUpdateCallback progressCb = nullptr)
+{
+#if PINKY_JPEG_PIPELINE
+  return decodeImageJPGPipelined(width, height, src, buffer, progressCb);
+#else
+  return decodeImageJPG(width, height, src, buffer, progressCb);
+#endif
+}
+
+// Decode a JPEG held in memory, splitting it into strips at its restart
+// markers. Strips alternate between core0 and core1, each running its own
+// picojpeg instance, and are handed to buffer in order on core0. Frames
+// without usable restart intervals go to decodeImageJPGUnsplit instead.
+template <typename PixelT>
+bool decodeImageJPGParallel(int width, int height, const uint8_t* jpeg, uint32_t size, ImageView<PixelT>& buffer, ProgressUpdateCallback progressCb = nullptr)
+{
+  auto decodeUnsplit = [&]()
+  {
+    MemoryByteSource src(jpeg, size);
+    return decodeImageJPGUnsplit(width, height, src, buffer, progressCb);
+  };
+
+  JpegLayout layout;
+  if (!SecondCore::available() || !scanJpegLayout(jpeg, size, layout) || layout.restartInterval == 0)
+  {
+    PINKY_LOG(JpegNoRestarts);
+    return decodeUnsplit();
+  }
+
+  // Work out the strips, and check the restart segments really line up
+  // with them before trusting the layout
+  int mcusPerRow = layout.mcusPerRow();
+  int mcusPerStrip = std::lcm(layout.restartInterval, mcusPerRow);
+  int rowsPerStrip = mcusPerStrip / mcusPerRow;
+  int segmentsPerStrip = mcusPerStrip / layout.restartInterval;
+  int totalMcus = mcusPerRow * layout.mcusPerCol();
+  int expectedSegments = (totalMcus + layout.restartInterval - 1) / layout.restartInterval;
+  if (rowsPerStrip > MaxStripMcuRows || layout.segmentCount() != expectedSegments)
+  {
+    PINKY_LOG(JpegRestartsUnsplit, layout.restartInterval);
+    return decodeUnsplit();
+  }
+
+  // Strips entirely outside the visible region are never decoded at all
+  JpegDecodeWindow window = jpegDecodeWindow(buffer, layout.mcuWidth, layout.mcuHeight, mcusPerRow, layout.mcusPerCol());
+  int stripBegin = window.mcuYBegin / rowsPerStrip;
+  int stripEnd = (window.mcuYEnd + rowsPerStrip - 1) / rowsPerStrip;
+  if (stripEnd - stripBegin < JpegDecodeWorkers)
+  {
+    return decodeUnsplit();
+  }
+
+  // Now set up both workers for real, starting at the first visible strip
+  JpegStripWorker workers[JpegDecodeWorkers] =
+  {
+    {DefaultJpegDecoder, jpeg, layout, segmentsPerStrip, rowsPerStrip, stripBegin, stripEnd},
+    {Core1JpegDecoder, jpeg, layout, segmentsPerStrip, rowsPerStrip, stripBegin + 1, stripEnd}
+  };
+  size_t stripPixels = (size_t)window.decodeWidth * rowsPerStrip * layout.mcuHeight;
+  ScratchBuffer<RGBColor> strips(JpegDecodeWorkers * stripPixels);
+  for (int i=0; i < JpegDecodeWorkers; ++i)
+  {
+    JpegStripWorker& w = workers[i];
+    if (!w.init(layout))
+    {
+      PINKY_LOG(JpegStripHeaderError);
+      return false;
+    }
+    w.window = &window;
+    w.lines = strips.data() + i * stripPixels;
+  }
+  PINKY_LOG(JpegStrips, JpegDecodeWorkers, stripEnd - stripBegin, rowsPerStrip);
+
+  JpegStripWorker& local = workers[0];
+  JpegStripWorker& remote = workers[1];
+  SecondCore::launch(JpegStripWorker::run, &remote);
+
+  bool ok = true;
+  for (int strip = stripBegin; ok && strip < stripEnd; ++strip)
+  {
+    bool isLocal = ((strip - stripBegin) % JpegDecodeWorkers) == 0;
+    if (isLocal)
+    {
+      ok = local.decodeStrip(strip);
+    }
+    else
+    {
+      while (remote.readyStrip.load(std::memory_order_acquire) != strip && !remote.failed.load(std::memory_order_acquire))
+      {
+        SecondCore::relax();
+      }
+      ok = !remote.failed.load(std::memory_order_acquire);
+    }
+
+    if (ok)
+    {
+      JpegStripWorker& w = isLocal ? local : remote;
+      int firstRow = strip * rowsPerStrip;
+      writeDecodedLines(buffer, window, w.lines, firstRow * layout.mcuHeight, (w.stripRowEnd(strip) - firstRow) * layout.mcuHeight);
+    }
+
+    if (!isLocal)
+    {
+      // Hand the strip buffer back to the other core
+      remote.readyStrip.store(-1, std::memory_order_release);
+    }
+
+    if (progressCb)
+    {
+      progressCb((float)(strip + 1 - stripBegin) / (float)(stripEnd - stripBegin));
+    }
+  }
+
+  if (!ok)
+  {
+    PINKY_LOG(JpegStripError);
+    remote.abort.store(true, std::memory_order_relaxed);
+  }
+  SecondCore::join();
+  return ok;
+}
@@ -0,0 +1,387 @@
+#pragma once
+
+#include "NearestColor.hpp"
+
+#include <cpp/Color.hpp>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Vector versions of the per pixel Lab work in the decode and dither
+// pipeline: the companding step of converting to Lab, and the nearest
+// palette color search. Host builds pick the widest instruction set the
+// CPU has at run time (AVX2 or SSE2 on x86-64, NEON on arm64). The device
+// has no vector unit and always runs the scalar code.
+//
+// Every kernel does the same float operations in the same order as the
+// scalar code, so they all give the same results bit for bit, as long as
+// the compiler isn't allowed to fuse multiplies and adds (-ffp-contract=off).
+#if defined(__x86_64__) && defined(__GNUC__)
+#define LAB_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define LAB_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// sRGB to CIE Lab (D65) through tables: each 8 bit channel maps to its
+// linearized contribution to X, Y and Z (already divided by the white
+// point), and the companding function is a cube root table with
+// interpolation.
+class LabTables
+{
+public:
+  static constexpr int CompandingSteps = 1024;
+
+  static const LabTables& instance()
+  {
+    static LabTables tables;
+    return tables;
+  }
+
+  void xyz(int r, int g, int b, float& x, float& y, float& z) const
+  {
+    x = xFromR_[r] + xFromG_[g] + xFromB_[b];
+    y = yFromR_[r] + yFromG_[g] + yFromB_[b];
+    z = zFromR_[r] + zFromG_[g] + zFromB_[b];
+  }
+
+  float companding(float t) const
+  {
+    float pos = std::clamp(t, 0.0f, 1.0f) * (float)CompandingSteps;
+    int i = std::min((int)pos, CompandingSteps - 1);
+    float frac = pos - (float)i;
+    return companding_[i] + (companding_[i+1] - companding_[i]) * frac;
+  }
+
+  LabColor toLab(float x, float y, float z) const
+  {
+    float fx = companding(x);
+    float fy = companding(y);
+    float fz = companding(z);
+
+    return LabColor{
+      116.0f * fy - 16.0f,
+      500.0f * (fx - fy),
+      200.0f * (fy - fz)
+    };
+  }
+
+  const float* compandingTable() const
+  {
+    return companding_.data();
+  }
+
+private:
+  LabTables()
+  {
+    for (int i=0; i < 256; ++i)
+    {
+      // sRGB to linear
+      float s = (float)i / 255.0f;
+      float lin = (s <= 0.04045f) ? (s / 12.92f) : std::pow((s + 0.055f) / 1.055f, 2.4f);
+
+      // Linear sRGB to XYZ (D65), normalized by the reference white
+      xFromR_[i] = lin * 0.4124564f / 0.95047f;
+      xFromG_[i] = lin * 0.3575761f / 0.95047f;
+      xFromB_[i] = lin * 0.1804375f / 0.95047f;
+      yFromR_[i] = lin * 0.2126729f;
+      yFromG_[i] = lin * 0.7151522f;
+      yFromB_[i] = lin * 0.0721750f;
+      zFromR_[i] = lin * 0.0193339f / 1.08883f;
+      zFromG_[i] = lin * 0.1191920f / 1.08883f;
+      zFromB_[i] = lin * 0.9503041f / 1.08883f;
+    }
+
+    for (int i=0; i <= CompandingSteps; ++i)
+    {
+      float t = (float)i / (float)CompandingSteps;
+      companding_[i] = (t > 0.008856f) ? std::cbrt(t) : (7.787f * t + 16.0f / 116.0f);
+    }
+  }
+
+  std::array<float, 256> xFromR_;
+  std::array<float, 256> xFromG_;
+  std::array<float, 256> xFromB_;
+  std::array<float, 256> yFromR_;
+  std::array<float, 256> yFromG_;
+  std::array<float, 256> yFromB_;
+  std::array<float, 256> zFromR_;
+  std::array<float, 256> zFromG_;
+  std::array<float, 256> zFromB_;
+
+  std::array<float, CompandingSteps + 1> companding_;
+};
+
+// Lab for count pixels from their X, Y and Z
+using XyzToLabFunc = void(*)(const float* x, const float* y, const float* z, LabColor* out, int count);
+
+struct LabKernels
+{
+  const char* name;
+  XyzToLabFunc xyzToLab;
+  // For palettes that aren't monochrome, of any size. Null to use the
+  // scalar kernels specialized on palette size.
+  NearestColorFunc nearestColor;
+};
+
+inline void xyzToLabScalar(const float* x, const float* y, const float* z, LabColor* out, int count)
+{
+  const LabTables& tables = LabTables::instance();
+  for (int i=0; i < count; ++i)
+  {
+    out[i] = tables.toLab(x[i], y[i], z[i]);
+  }
+}
+
+#if LAB_KERNELS_X86
+
+inline __m128 compandingSse2(const float* table, __m128 t)
+{
+  // min(pos, Steps - 1) before truncating is the same as min((int)pos, Steps - 1)
+  __m128 pos = _mm_mul_ps(_mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(1.0f)), _mm_set1_ps((float)LabTables::CompandingSteps));
+  __m128i i = _mm_cvttps_epi32(_mm_min_ps(pos, _mm_set1_ps((float)(LabTables::CompandingSteps - 1))));
+  __m128 frac = _mm_sub_ps(pos, _mm_cvtepi32_ps(i));
+
+  alignas(16) int32_t index[4];
+  _mm_store_si128((__m128i*)index, i);
+  __m128 c0 = _mm_setr_ps(table[index[0]], table[index[1]], table[index[2]], table[index[3]]);
+  __m128 c1 = _mm_setr_ps(table[index[0]+1], table[index[1]+1], table[index[2]+1], table[index[3]+1]);
+  return _mm_add_ps(c0, _mm_mul_ps(_mm_sub_ps(c1, c0), frac));
+}
+
+inline void xyzToLabSse2(const float* x, const float* y, const float* z, LabColor* out, int count)
+{
+  const LabTables& tables = LabTables::instance();
+  const float* table = tables.compandingTable();
+  int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 fx = compandingSse2(table, _mm_loadu_ps(x + i));
+    __m128 fy = compandingSse2(table, _mm_loadu_ps(y + i));
+    __m128 fz = compandingSse2(table, _mm_loadu_ps(z + i));
+
+    alignas(16) float L[4];
+    alignas(16) float a[4];
+    alignas(16) float b[4];
+    _mm_store_ps(L, _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(116.0f), fy), _mm_set1_ps(16.0f)));
+    _mm_store_ps(a, _mm_mul_ps(_mm_set1_ps(500.0f), _mm_sub_ps(fx, fy)));
+    _mm_store_ps(b, _mm_mul_ps(_mm_set1_ps(200.0f), _mm_sub_ps(fy, fz)));
+    for (int j=0; j < 4; ++j)
+    {
+      out[i+j] = LabColor{L[j], a[j], b[j]};
+    }
+  }
+  xyzToLabScalar(x + i, y + i, z + i, out + i, count - i);
+}
+
+inline uint8_t nearestColorSse2(const PackedLabPalette& p, const LabColor& c, LabColor& error)
+{
+  __m128 cL = _mm_set1_ps(c.L);
+  __m128 ca = _mm_set1_ps(c.a);
+  __m128 cb = _mm_set1_ps(c.b);
+  float bestDistance = INFINITY;
+  int best = 0;
+  for (int i=0; i < p.size(); i += 4)
+  {
+    __m128 dL = _mm_sub_ps(_mm_loadu_ps(&p.L[i]), cL);
+    __m128 da = _mm_sub_ps(_mm_loadu_ps(&p.a[i]), ca);
+    __m128 db = _mm_sub_ps(_mm_loadu_ps(&p.b[i]), cb);
+    __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dL, dL), _mm_mul_ps(da, da)), _mm_mul_ps(db, db));
+
+    // The smallest distance in every lane, then the first lane that has it
+    __m128 m = _mm_min_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    float chunkBest = _mm_cvtss_f32(m);
+    if (chunkBest < bestDistance)
+    {
+      bestDistance = chunkBest;
+      best = i + __builtin_ctz(_mm_movemask_ps(_mm_cmpeq_ps(d, m)));
+    }
+  }
+  error = paletteError<false>(p, best, c);
+  return p.index[best];
+}
+
+__attribute__((target("avx2"))) inline __m256 compandingAvx2(const float* table, __m256 t)
+{
+  __m256 pos = _mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(t, _mm256_setzero_ps()), _mm256_set1_ps(1.0f)), _mm256_set1_ps((float)LabTables::CompandingSteps));
+  __m256i i = _mm256_cvttps_epi32(_mm256_min_ps(pos, _mm256_set1_ps((float)(LabTables::CompandingSteps - 1))));
+  __m256 frac = _mm256_sub_ps(pos, _mm256_cvtepi32_ps(i));
+  __m256 c0 = _mm256_i32gather_ps(table, i, 4);
+  __m256 c1 = _mm256_i32gather_ps(table + 1, i, 4);
+  return _mm256_add_ps(c0, _mm256_mul_ps(_mm256_sub_ps(c1, c0), frac));
+}
+
+__attribute__((target("avx2"))) inline void xyzToLabAvx2(const float* x, const float* y, const float* z, LabColor* out, int count)
+{
+  const LabTables& tables = LabTables::instance();
+  const float* table = tables.compandingTable();
+  int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 fx = compandingAvx2(table, _mm256_loadu_ps(x + i));
+    __m256 fy = compandingAvx2(table, _mm256_loadu_ps(y + i));
+    __m256 fz = compandingAvx2(table, _mm256_loadu_ps(z + i));
+
+    alignas(32) float L[8];
+    alignas(32) float a[8];
+    alignas(32) float b[8];
+    _mm256_store_ps(L, _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(116.0f), fy), _mm256_set1_ps(16.0f)));
+    _mm256_store_ps(a, _mm256_mul_ps(_mm256_set1_ps(500.0f), _mm256_sub_ps(fx, fy)));
+    _mm256_store_ps(b, _mm256_mul_ps(_mm256_set1_ps(200.0f), _mm256_sub_ps(fy, fz)));
+    for (int j=0; j < 8; ++j)
+    {
+      out[i+j] = LabColor{L[j], a[j], b[j]};
+    }
+  }
+  xyzToLabSse2(x + i, y + i, z + i, out + i, count - i);
+}
+
+__attribute__((target("avx2"))) inline uint8_t nearestColorAvx2(const PackedLabPalette& p, const LabColor& c, LabColor& error)
+{
+  __m256 cL = _mm256_set1_ps(c.L);
+  __m256 ca = _mm256_set1_ps(c.a);
+  __m256 cb = _mm256_set1_ps(c.b);
+  float bestDistance = INFINITY;
+  int best = 0;
+  for (int i=0; i < p.size(); i += 8)
+  {
+    __m256 dL = _mm256_sub_ps(_mm256_loadu_ps(&p.L[i]), cL);
+    __m256 da = _mm256_sub_ps(_mm256_loadu_ps(&p.a[i]), ca);
+    __m256 db = _mm256_sub_ps(_mm256_loadu_ps(&p.b[i]), cb);
+    __m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dL, dL), _mm256_mul_ps(da, da)), _mm256_mul_ps(db, db));
+
+    __m256 m = _mm256_min_ps(d, _mm256_permute2f128_ps(d, d, 1));
+    m = _mm256_min_ps(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm256_min_ps(m, _mm256_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    float chunkBest = _mm256_cvtss_f32(m);
+    if (chunkBest < bestDistance)
+    {
+      bestDistance = chunkBest;
+      best = i + __builtin_ctz(_mm256_movemask_ps(_mm256_cmp_ps(d, m, _CMP_EQ_OQ)));
+    }
+  }
+  error = paletteError<false>(p, best, c);
+  return p.index[best];
+}
+
+#elif LAB_KERNELS_NEON
+
+inline float32x4_t compandingNeon(const float* table, float32x4_t t)
+{
+  float32x4_t pos = vmulq_n_f32(vminq_f32(vmaxq_f32(t, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f)), (float)LabTables::CompandingSteps);
+  int32x4_t i = vcvtq_s32_f32(vminq_f32(pos, vdupq_n_f32((float)(LabTables::CompandingSteps - 1))));
+  float32x4_t frac = vsubq_f32(pos, vcvtq_f32_s32(i));
+
+  int32_t index[4];
+  vst1q_s32(index, i);
+  float c0s[4] = {table[index[0]], table[index[1]], table[index[2]], table[index[3]]};
+  float c1s[4] = {table[index[0]+1], table[index[1]+1], table[index[2]+1], table[index[3]+1]};
+  float32x4_t c0 = vld1q_f32(c0s);
+  float32x4_t c1 = vld1q_f32(c1s);
+  return vaddq_f32(c0, vmulq_f32(vsubq_f32(c1, c0), frac));
+}
+
+inline void xyzToLabNeon(const float* x, const float* y, const float* z, LabColor* out, int count)
+{
+  const LabTables& tables = LabTables::instance();
+  const float* table = tables.compandingTable();
+  int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    float32x4_t fx = compandingNeon(table, vld1q_f32(x + i));
+    float32x4_t fy = compandingNeon(table, vld1q_f32(y + i));
+    float32x4_t fz = compandingNeon(table, vld1q_f32(z + i));
+
+    float L[4];
+    float a[4];
+    float b[4];
+    vst1q_f32(L, vsubq_f32(vmulq_n_f32(fy, 116.0f), vdupq_n_f32(16.0f)));
+    vst1q_f32(a, vmulq_n_f32(vsubq_f32(fx, fy), 500.0f));
+    vst1q_f32(b, vmulq_n_f32(vsubq_f32(fy, fz), 200.0f));
+    for (int j=0; j < 4; ++j)
+    {
+      out[i+j] = LabColor{L[j], a[j], b[j]};
+    }
+  }
+  xyzToLabScalar(x + i, y + i, z + i, out + i, count - i);
+}
+
+inline uint8_t nearestColorNeon(const PackedLabPalette& p, const LabColor& c, LabColor& error)
+{
+  float32x4_t cL = vdupq_n_f32(c.L);
+  float32x4_t ca = vdupq_n_f32(c.a);
+  float32x4_t cb = vdupq_n_f32(c.b);
+  float bestDistance = INFINITY;
+  int best = 0;
+  for (int i=0; i < p.size(); i += 4)
+  {
+    float32x4_t dL = vsubq_f32(vld1q_f32(&p.L[i]), cL);
+    float32x4_t da = vsubq_f32(vld1q_f32(&p.a[i]), ca);
+    float32x4_t db = vsubq_f32(vld1q_f32(&p.b[i]), cb);
+    float32x4_t d = vaddq_f32(vaddq_f32(vmulq_f32(dL, dL), vmulq_f32(da, da)), vmulq_f32(db, db));
+
+    float chunkBest = vminvq_f32(d);
+    if (chunkBest < bestDistance)
+    {
+      float lanes[4];
+      vst1q_f32(lanes, d);
+      int lane = 0;
+      while (lanes[lane] != chunkBest)
+      {
+        ++lane;
+      }
+      bestDistance = chunkBest;
+      best = i + lane;
+    }
+  }
+  error = paletteError<false>(p, best, c);
+  return p.index[best];
+}
+
+#endif
+
+// Every set of kernels this CPU can run, narrowest first
+inline std::vector<LabKernels> availableLabKernels()
+{
+  std::vector<LabKernels> kernels{{"scalar", xyzToLabScalar, nullptr}};
+#if LAB_KERNELS_X86
+  kernels.push_back({"sse2", xyzToLabSse2, nearestColorSse2});
+  if (__builtin_cpu_supports("avx2"))
+  {
+    kernels.push_back({"avx2", xyzToLabAvx2, nearestColorAvx2});
+  }
+#elif LAB_KERNELS_NEON
+  kernels.push_back({"neon", xyzToLabNeon, nearestColorNeon});
+#endif
+  return kernels;
+}
+
+// The widest kernels this CPU can run, or the ones named by the
+// PINKY_LAB_KERNELS environment variable (to compare them)
+inline const LabKernels& labKernels()
+{
+  static const LabKernels kernels = []()
+  {
+    std::vector<LabKernels> available = availableLabKernels();
+    LabKernels chosen = available.back();
+#if LAB_KERNELS_X86 || LAB_KERNELS_NEON
+    const char* name = getenv("PINKY_LAB_KERNELS");
+    for (const LabKernels& k : available)
+    {
+      if (name && strcmp(name, k.name) == 0)
+      {
+        chosen = k;
+      }
+    }
+#endif
+    return chosen;
+  }();
+  return kernels;
+}
@@ -0,0 +1,329 @@
+#pragma once
+
+#include "DeferredLog.hpp"
+#include "Hal.hpp"
+
+#include <stdint.h>
+#include <algorithm>
+#include <iostream>
+
+// Heap and stack high-water marks over a command. Allocations are counted
+// through operator new/delete, which the firmware links wrapped (see
+// CMakeLists.txt and pinky.cpp). After each one the heap in use is sampled
+// to keep its peak. Stacks are painted with a pattern and scanned for
+// the deepest word overwritten: core0's below the caller when a command
+// starts, core1's whole stack before each SecondCore job.
+//
+// Build with PINKY_MEMWATCH=0 to compile it out.
+#ifndef PINKY_MEMWATCH
+#define PINKY_MEMWATCH 1
+#endif
+
+#if PINKY_MEMWATCH && PICO_ON_DEVICE
+// Stack ends from the pico-sdk linker scripts
+extern "C" uint32_t __StackBottom, __StackTop, __StackOneBottom, __StackOneTop;
+#endif
+
+struct MemReport
+{
+  uint32_t allocations = 0;
+  uint32_t frees = 0;
+  uint64_t allocatedBytes = 0;
+  uint32_t heapStart = 0;
+  uint32_t heapPeak = 0;
+  uint32_t heapEnd = 0;
+  // Deepest stack use, 0 where it can't be measured
+  uint32_t stackPeak[2] = {0, 0};
+  uint32_t stackSize[2] = {0, 0};
+  bool stackOverflow[2] = {false, false};
+};
+
+// What one core has allocated, and the most heap in use it has seen
+struct MemCounts
+{
+  uint32_t allocations = 0;
+  uint32_t frees = 0;
+  uint64_t allocatedBytes = 0;
+  uint32_t heapPeak = 0;
+
+  MemCounts operator+(const MemCounts& other) const
+  {
+    return {allocations + other.allocations, frees + other.frees, allocatedBytes + other.allocatedBytes, std::max(heapPeak, other.heapPeak)};
+  }
+};
+
+class MemWatch
+{
+public:
+  // Report after each command while this is set
+  static inline bool enabled = true;
+
+  // caller is where operator new was called from, for AllocationGuard
+  static void noteAlloc(size_t size, const void* caller = nullptr)
+  {
+#if PINKY_MEMWATCH
+    MemCounts& counts = counts_[halCoreNum()];
+    ++counts.allocations;
+    counts.allocatedBytes += size;
+    counts.heapPeak = std::max(counts.heapPeak, usedHeap());
+    if (guardPaused_ > 0)
+    {
+      ++guardIgnored_;
+    }
+    else if (guardDepth_ > 0 && !guardFirstCaller_)
+    {
+      guardFirstSize_ = (uint32_t)size;
+      guardFirstCaller_ = caller ? caller : (const void*)1;
+    }
+#else
+    (void)size;
+    (void)caller;
+#endif
+  }
+
+  // Allocations counted so far, both cores together
+  static uint32_t allocations()
+  {
+#if PINKY_MEMWATCH
+    return counts_[0].allocations + counts_[1].allocations;
+#else
+    return 0;
+#endif
+  }
+
+  static void noteFree()
+  {
+#if PINKY_MEMWATCH
+    ++counts_[halCoreNum()].frees;
+#endif
+  }
+
+  // Call with core1 in reset, before it's launched
+  static void paintCore1Stack()
+  {
+#if PINKY_MEMWATCH && PICO_ON_DEVICE
+    paint(&__StackOneBottom, &__StackOneTop);
+#endif
+  }
+
+  // Call once core1's job is done, before it's reset
+  static void measureCore1Stack()
+  {
+#if PINKY_MEMWATCH && PICO_ON_DEVICE
+    core1StackPeak_ = std::max(core1StackPeak_, deepest(&__StackOneBottom, &__StackOneTop));
+#endif
+  }
+
+  // Start watching. Nested calls are folded into the outermost.
+  static void begin()
+  {
+#if PINKY_MEMWATCH
+    if (depth_++ > 0)
+    {
+      return;
+    }
+    start_ = counts_[0] + counts_[1];
+    startHeap_ = usedHeap();
+    for (MemCounts& counts : counts_)
+    {
+      counts.heapPeak = startHeap_;
+    }
+    core1StackPeak_ = 0;
+#if PICO_ON_DEVICE
+    // Stop short of the caller, leaving room for paint()'s own frame.
+    // Interrupts are off meanwhile, since their handlers run on this stack
+    // too and would have their frames painted over.
+    uint32_t marker;
+    uint32_t interrupts = save_and_disable_interrupts();
+    paint(&__StackBottom, (uint32_t*)((uintptr_t)&marker - 256));
+    restore_interrupts(interrupts);
+#endif
+#endif
+  }
+
+  // Stop watching, true with the report when this ends the outermost call
+  static bool end(MemReport& report)
+  {
+#if PINKY_MEMWATCH
+    if (depth_ == 0 || --depth_ > 0)
+    {
+      return false;
+    }
+    MemCounts total = counts_[0] + counts_[1];
+    report.allocations = total.allocations - start_.allocations;
+    report.frees = total.frees - start_.frees;
+    report.allocatedBytes = total.allocatedBytes - start_.allocatedBytes;
+    report.heapStart = startHeap_;
+    report.heapEnd = usedHeap();
+    report.heapPeak = std::max({counts_[0].heapPeak, counts_[1].heapPeak, report.heapEnd});
+#if PICO_ON_DEVICE
+    report.stackPeak[0] = deepest(&__StackBottom, &__StackTop);
+    report.stackSize[0] = (uint32_t)((&__StackTop - &__StackBottom) * 4);
+    report.stackOverflow[0] = __StackBottom != StackPaint;
+    report.stackPeak[1] = core1StackPeak_;
+    report.stackSize[1] = (uint32_t)((&__StackOneTop - &__StackOneBottom) * 4);
+    report.stackOverflow[1] = core1StackPeak_ >= report.stackSize[1];
+#endif
+    return true;
+#else
+    (void)report;
+    return false;
+#endif
+  }
+
+private:
+  static constexpr uint32_t StackPaint = 0x5ac3a55c;
+
+  static uint32_t usedHeap()
+  {
+#if PICO_ON_DEVICE
+    return (uint32_t)getUsedHeap();
+#else
+    return 0;
+#endif
+  }
+
+#if PICO_ON_DEVICE
+  static void paint(uint32_t* from, uint32_t* to)
+  {
+    for (volatile uint32_t* word = from; word < to; ++word)
+    {
+      *word = StackPaint;
+    }
+  }
+
+  // Bytes from the top of the stack down to the deepest word written
+  static uint32_t deepest(const uint32_t* bottom, const uint32_t* top)
+  {
+    const volatile uint32_t* word = bottom;
+    while (word < top && *word == StackPaint)
+    {
+      ++word;
+    }
+    return (uint32_t)((top - word) * 4);
+  }
+#endif
+
+  friend class AllocationGuard;
+  friend class AllocationGuardPause;
+
+#if PINKY_MEMWATCH
+  static inline int guardDepth_ = 0;
+  static inline int guardPaused_ = 0;
+  static inline uint32_t guardIgnored_ = 0;
+  static inline uint32_t guardFirstSize_ = 0;
+  static inline const void* guardFirstCaller_ = nullptr;
+  static inline MemCounts counts_[2];
+  static inline MemCounts start_;
+  static inline uint32_t startHeap_ = 0;
+  static inline uint32_t core1StackPeak_ = 0;
+  static inline int depth_ = 0;
+#endif
+};
+
+// Flags any allocation made while one is in scope. The snap path runs on
+// memory set aside at startup (PhotoPipeline, ScratchArena), so anything
+// it allocates is a regression: it's logged when the outermost guard ends,
+// with the size and caller of the first allocation to track it down.
+class AllocationGuard
+{
+public:
+  AllocationGuard()
+  {
+#if PINKY_MEMWATCH
+    if (MemWatch::guardDepth_++ == 0)
+    {
+      MemWatch::guardFirstCaller_ = nullptr;
+      start_ = MemWatch::allocations() - MemWatch::guardIgnored_;
+    }
+#endif
+  }
+
+  ~AllocationGuard()
+  {
+#if PINKY_MEMWATCH
+    if (--MemWatch::guardDepth_ > 0)
+    {
+      return;
+    }
+    uint32_t count = MemWatch::allocations() - MemWatch::guardIgnored_ - start_;
+    if (count > 0)
+    {
+      ++violations_;
+      PINKY_LOG(AllocationGuardHit, count, MemWatch::guardFirstSize_, (uint32_t)(uintptr_t)MemWatch::guardFirstCaller_);
+    }
+#endif
+  }
+
+  // Guarded scopes that allocated
+  static uint32_t violations()
+  {
+    return violations_;
+  }
+
+private:
+  uint32_t start_ = 0;
+  static inline uint32_t violations_ = 0;
+};
+
+// Leaves allocations made while in scope out of any AllocationGuard, for
+// ones that aren't the firmware's (the host simulator's panel model)
+class AllocationGuardPause
+{
+public:
+  AllocationGuardPause()
+  {
+#if PINKY_MEMWATCH
+    ++MemWatch::guardPaused_;
+#endif
+  }
+
+  ~AllocationGuardPause()
+  {
+#if PINKY_MEMWATCH
+    --MemWatch::guardPaused_;
+#endif
+  }
+
+  AllocationGuardPause(const AllocationGuardPause&) = delete;
+  AllocationGuardPause& operator=(const AllocationGuardPause&) = delete;
+};
+
+inline void printMemReport(std::ostream& out, const char* name, const MemReport& report)
+{
+  out << "[" << name << "] heap " << report.heapStart << " -> peak " << report.heapPeak << " -> " << report.heapEnd
+      << ", " << report.allocations << " allocs (" << report.allocatedBytes << " bytes), " << report.frees << " frees";
+  for (int core=0; core < 2; ++core)
+  {
+    if (report.stackSize[core] > 0)
+    {
+      out << ", core" << core << " stack " << report.stackPeak[core] << "/" << report.stackSize[core]
+          << (report.stackOverflow[core] ? " OVERFLOWED" : "");
+    }
+  }
+  out << std::endl;
+}
+
+// Watches from construction to destruction and prints the report, if
+// MemWatch::enabled, when the outermost scope ends
+class MemWatchScope
+{
+public:
+  MemWatchScope(const char* name)
+    : name_{name}
+  {
+    MemWatch::begin();
+  }
+
+  ~MemWatchScope()
+  {
+    MemReport report;
+    if (MemWatch::end(report) && MemWatch::enabled)
+    {
+      printMemReport(std::cout, name_, report);
+    }
+  }
+
+private:
+  const char* name_;
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "cpp/Color.hpp"
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+// Palette colors stored as separate, contiguous L, a and b arrays so the
+// nearest color kernels can walk them without touching a hash map. L, a
+// and b are padded to a multiple of PadTo with entries too far away to
+// ever be nearest, so vector kernels can always load whole registers.
+struct PackedLabPalette
+{
+  static constexpr int PadTo = 8;
+  static constexpr float Unreachable = 1e18f;
+
+  std::vector<float> L;
+  std::vector<float> a;
+  std::vector<float> b;
+  std::vector<uint8_t> index;
+
+  int size() const
+  {
+    return (int)index.size();
+  }
+
+  void clear()
+  {
+    L.clear();
+    a.clear();
+    b.clear();
+    index.clear();
+  }
+
+  void push_back(uint8_t indexedColor, const LabColor& color)
+  {
+    int n = size();
+    int padded = (n / PadTo + 1) * PadTo;
+    L.resize(padded, Unreachable);
+    a.resize(padded, 0.0f);
+    b.resize(padded, 0.0f);
+    L[n] = color.L;
+    a[n] = color.a;
+    b[n] = color.b;
+    index.push_back(indexedColor);
+  }
+};
+
+// Find the nearest palette entry to color, returning its indexed color
+// and writing the remaining error
+using NearestColorFunc = uint8_t(*)(const PackedLabPalette& palette, const LabColor& color, LabColor& error);
+
+// Distance used for comparison only. Squared distance orders entries the same
+// way deltaE does, without the sqrt. Monochrome palettes compare L alone.
+template <bool Monochrome>
+inline float paletteDistance(const PackedLabPalette& p, int i, const LabColor& c)
+{
+  float dL = p.L[i] - c.L;
+  if constexpr (Monochrome)
+  {
+    return dL * dL;
+  }
+  else
+  {
+    float da = p.a[i] - c.a;
+    float db = p.b[i] - c.b;
+    return dL * dL + da * da + db * db;
+  }
+}
+
+template <bool Monochrome>
+inline LabColor paletteError(const PackedLabPalette& p, int i, const LabColor& c)
+{
+  if constexpr (Monochrome)
+  {
+    return LabColor{c.L - p.L[i], 0, 0};
+  }
+  else
+  {
+    return LabColor{c.L - p.L[i], c.a - p.a[i], c.b - p.b[i]};
+  }
+}
+
+template <bool Monochrome, size_t... I>
+inline int nearestPaletteEntry(const PackedLabPalette& p, const LabColor& c, std::index_sequence<I...>)
+{
+  // Fully unrolled, branch free min selection: each step is a pair of selects
+  if constexpr (sizeof...(I) == 0)
+  {
+    // A single color is always the nearest
+    (void)p;
+    (void)c;
+    return 0;
+  }
+  else
+  {
+    float bestDistance = paletteDistance<Monochrome>(p, 0, c);
+    int best = 0;
+    ([&]
+    {
+      float d = paletteDistance<Monochrome>(p, (int)I + 1, c);
+      bool closer = d < bestDistance;
+      bestDistance = closer ? d : bestDistance;
+      best = closer ? (int)I + 1 : best;
+    }(), ...);
+    return best;
+  }
+}
+
+// Nearest color search specialized on palette size N
+template <int N, bool Monochrome>
+uint8_t nearestColorKernel(const PackedLabPalette& p, const LabColor& c, LabColor& error)
+{
+  static_assert(N > 0, "Palette must contain at least one color");
+  int best = nearestPaletteEntry<Monochrome>(p, c, std::make_index_sequence<N - 1>{});
+  error = paletteError<Monochrome>(p, best, c);
+  return p.index[best];
+}
+
+// Fallback for palette sizes without a specialization
+template <bool Monochrome>
+uint8_t nearestColorKernelGeneric(const PackedLabPalette& p, const LabColor& c, LabColor& error)
+{
+  if (p.size() == 0)
+  {
+    error = LabColor{0, 0, 0};
+    return 0;
+  }
+
+  float bestDistance = paletteDistance<Monochrome>(p, 0, c);
+  int best = 0;
+  for (int i=1; i < p.size(); ++i)
+  {
+    float d = paletteDistance<Monochrome>(p, i, c);
+    bool closer = d < bestDistance;
+    bestDistance = closer ? d : bestDistance;
+    best = closer ? i : best;
+  }
+  error = paletteError<Monochrome>(p, best, c);
+  return p.index[best];
+}
+
+template <bool Monochrome>
+NearestColorFunc selectNearestColorKernel(int paletteSize)
+{
+  switch (paletteSize)
+  {
+    case 1: return nearestColorKernel<1, Monochrome>;
+    case 2: return nearestColorKernel<2, Monochrome>;
+    case 3: return nearestColorKernel<3, Monochrome>;
+    case 4: return nearestColorKernel<4, Monochrome>;
+    case 5: return nearestColorKernel<5, Monochrome>;
+    case 6: return nearestColorKernel<6, Monochrome>;
+    case 7: return nearestColorKernel<7, Monochrome>;
+    case 8: return nearestColorKernel<8, Monochrome>;
+    default: return nearestColorKernelGeneric<Monochrome>;
+  }
+}
+
+// Pick the kernel for a palette. Call this once per frame, not per pixel.
+inline NearestColorFunc selectNearestColorKernel(int paletteSize, bool monochrome)
+{
+  return monochrome ? selectNearestColorKernel<true>(paletteSize)
+                    : selectNearestColorKernel<false>(paletteSize);
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "ByteSource.hpp"
+#include "Camera.hpp"
+#include "DeferredLog.hpp"
+#include "Hal.hpp"
+#include "ImageConvert.hpp"
+#include "ImageDecode.hpp"
+#include "ImageEffect.hpp"
+#include "InkyBase.hpp"
+#include "JpegParallel.hpp"
+#include "MemWatch.hpp"
+#include "Scheduler.hpp"
+#include "ScratchArena.hpp"
+#include "SourceCache.hpp"
+#include "Stats.hpp"
+#include "Trace.hpp"
+
+#include <cpp/Color.hpp>
+#include <cpp/Logging.hpp>
+
+#include <functional>
+#include <memory>
+
+// How an image may be decoded. Any lets a JPEG be read into RAM so both
+// cores can work on it. Streaming decodes as the data arrives, for sources
+// too big or too slow to buffer. SingleCore keeps core1 off, for when the
+// output is being written to flash as it arrives.
+enum class DecodeMode
+{
+  Any,
+  Streaming,
+  SingleCore
+};
+
+// Picture in, panel updated: decode, dither through the current color map
+// and show. Nothing in here touches the hardware except through the Inky,
+// the Camera and Hal.hpp, so the host simulator runs the same snap path as
+// the firmware. Everything a snap needs is set aside at construction (the
+// dither error rows, the source cache, the ScratchArena for decoding), so a
+// snap doesn't allocate; an AllocationGuard reports it if it does. The one
+// exception is a camera JPEG buffered whole for parallel decoding.
+class PhotoPipeline
+{
+public:
+  // Progress feedback, the LED strip on the device
+  using Indicator = std::function<void(float progress, RGBColor color)>;
+  // Copies the picture the camera just took to where it can be decoded
+  // from later (flash, on the device), so the camera is free for the next
+  // shot sooner. Returns a source for the copy, or null if it couldn't be
+  // made.
+  using Spooler = std::function<ByteSource*(Camera& camera)>;
+
+  float ditherAccuracy = 0.95f;
+  bool yuvDownsample = true;
+  // Used instead of the display's own color map when set (effects)
+  std::shared_ptr<IndexedColorMap> specialColorMap;
+  // What the dither stage saw last, for rerender
+  SourceImageCache sourceCache;
+  // snap() copies each capture out through spooler before decoding it
+  // while this is set
+  bool spoolCaptures = false;
+  Spooler spooler;
+
+  // Scratch for decoding into a display this wide
+  static size_t scratchBytesFor(int width)
+  {
+    return jpegParallelScratchBytes(width) + JpegSegmentScratchBytes;
+  }
+
+  PhotoPipeline(Inky& inky, Indicator indicator = nullptr)
+    : inky_{inky}
+    , indicator_{indicator}
+    , labError_{inky.bufferIndexed().width}
+    , lumaError_{inky.bufferIndexed().width}
+  {
+    auto& display = inky_.bufferIndexed();
+    ScratchArena& arena = ScratchArena::instance();
+    size_t scratchBytes = scratchBytesFor(display.width);
+    if (arena.capacity() < scratchBytes)
+    {
+      arena.reserve(scratchBytes);
+    }
+    bool cached = sourceCache.reserve(display.width, display.height, !colorMap().isMonochrome());
+    // Choosing the Lab kernels allocates, so do it before the first snap
+    labKernels();
+    DEBUG_LOG("Set aside " << scratchBytes << " bytes of decode scratch" << (cached ? " and a source cache" : ""));
+  }
+
+  const IndexedColorMap& colorMap() const
+  {
+    return specialColorMap ? *specialColorMap : inky_.colorMap();
+  }
+
+  // Run writeImage(ditherView, progressCb) with a fresh dither view for the
+  // current color map over the cleared display buffer, then show it
+  template <typename WriteImage>
+  bool ditherAndShow(WriteImage&& writeImage)
+  {
+    // Clear the display
+    {
+      TraceScope trace(TraceSpan::Clear);
+      inky_.clear();
+    }
+
+    indicate(1.0f, {0,255,0});
+    // Called every row or so, which is where decoding yields
+    auto showProgress = [&](float progress)
+    {
+      Scheduler::yield();
+      if (progress > 0.17f)
+      {
+        indicate(progress, {0,128,255});
+      }
+    };
+    ProgressUpdateCallback progressCb = showProgress;
+
+    bool ok = false;
+    uint64_t startTime = halTimeUs();
+    if (colorMap().isMonochrome())
+    {
+      // Monochrome maps only look at lightness, so skip chroma entirely
+      LumaDitherView buffer(inky_.bufferIndexed(), colorMap(), &lumaError_);
+      buffer.ditherAccuracy = ditherAccuracy;
+      StatScope stat(StatCounter::DecodeUs);
+      ok = writeImage(buffer, progressCb);
+    }
+    else
+    {
+      // Decoders hand over Lab directly (YUV converts through lookup tables)
+      LabInputDitherView buffer(inky_.bufferIndexed(), colorMap(), &labError_);
+      buffer.ditherAccuracy = ditherAccuracy;
+      StatScope stat(StatCounter::DecodeUs);
+      ok = writeImage(buffer, progressCb);
+    }
+
+    if (ok)
+    {
+      PINKY_LOG(PictureConverted, (halTimeUs() - startTime) / 1000);
+      TraceScope trace(TraceSpan::Show);
+      inky_.show();
+    }
+
+    return ok;
+  }
+
+  // Decode an image of the given format and size from src into buffer,
+  // centered
+  template <typename ImageViewT>
+  bool decodeImage(ImageViewT& buffer, ByteSource& src, CaptureFormat format, int width, int height, ProgressUpdateCallback& progressCb, DecodeMode mode = DecodeMode::Any)
+  {
+    AlignCenterView centeredBuffer(buffer, width, height);
+
+    if (format == CaptureFormat::RGB565)
+    {
+      return decodeImageRGB565(width, height, src, centeredBuffer, progressCb);
+    }
+    else if (format == CaptureFormat::YUV && !yuvDownsample)
+    {
+      return decodeImageYUYV(width, height, src, centeredBuffer, progressCb);
+    }
+    else if (format == CaptureFormat::YUV && yuvDownsample)
+    {
+      AlignCenterView centeredBuffer(buffer, width/2, height/2);
+      return decodeImageYUYVHalf(width, height, src, centeredBuffer, progressCb);
+    }
+    else if (format == CaptureFormat::JPG)
+    {
+      // Restart intervals can be split across both cores when the whole
+      // JPEG is in memory (spooled to flash, or buffered on the heap if
+      // there is room for it)
+      uint32_t jpegSize = src.remaining();
+      if (mode == DecodeMode::SingleCore)
+      {
+        return decodeImageJPG(width, height, src, centeredBuffer, progressCb);
+      }
+      if (src.data())
+      {
+        return decodeImageJPGParallel(width, height, src.data(), jpegSize, centeredBuffer, progressCb);
+      }
+      if (mode == DecodeMode::Any && jpegSize + JpegBufferHeapReserve < halFreeHeap())
+      {
+        // Captures vary too much in size to set aside room for the largest,
+        // so this is the one allocation a snap makes on purpose
+        std::unique_ptr<uint8_t[]> jpeg;
+        {
+          AllocationGuardPause pause;
+          jpeg.reset(new uint8_t[jpegSize]);
+        }
+        if (!readYielding(src, jpeg.get(), jpegSize))
+        {
+          return false;
+        }
+        return decodeImageJPGParallel(width, height, jpeg.get(), jpegSize, centeredBuffer, progressCb);
+      }
+      return decodeImageJPGUnsplit(width, height, src, centeredBuffer, progressCb);
+    }
+    return false;
+  }
+
+  // Decode an image of the given format and size from src into the
+  // display buffer and show it. What the dither stage sees is kept in
+  // sourceCache for rerender, if there is room for it.
+  bool renderImage(ByteSource& src, CaptureFormat format, int width, int height, DecodeMode mode = DecodeMode::Any)
+  {
+    bool chroma = !colorMap().isMonochrome();
+    auto& display = inky_.bufferIndexed();
+    uint32_t cacheBytes = SourceImageCache::bytesFor(display.width, display.height, chroma);
+
+    sourceCache.clear();
+    bool caching = sourceCache.reserve(display.width, display.height, chroma);
+    if (!caching)
+    {
+      PINKY_LOG(NoSourceCache, cacheBytes);
+    }
+    if (caching)
+    {
+      sourceCache.begin(display.width, display.height, chroma);
+    }
+
+    bool decodeOk = ditherAndShow([&](auto& buffer, ProgressUpdateCallback& progressCb)
+    {
+      if (caching)
+      {
+        SourceCacheView cachedBuffer(buffer, sourceCache);
+        return decodeImage(cachedBuffer, src, format, width, height, progressCb, mode);
+      }
+      return decodeImage(buffer, src, format, width, height, progressCb, mode);
+    });
+
+    if (decodeOk && caching)
+    {
+      sourceCache.commit();
+    }
+    else
+    {
+      sourceCache.clear();
+    }
+    return decodeOk;
+  }
+
+  bool takePicture(Camera& camera, CaptureFormat format)
+  {
+    PINKY_LOG(TakingPhoto);
+    indicate(1.0f, {255,0,0});
+    return camera.takePicture(format);
+  }
+
+  // Render the picture the camera just took, straight out of the camera
+  bool renderPicture(Camera& camera)
+  {
+    PINKY_LOG(FetchingPhoto);
+    ByteSource& src = camera.picture();
+    bool decodeOk = renderImage(src, camera.format(), camera.width(), camera.height());
+    src.discard();
+    return decodeOk;
+  }
+
+  // Copy the picture the camera just took out through spooler, then
+  // render the copy
+  bool renderSpooled(Camera& camera)
+  {
+    PINKY_LOG(SpoolingPhoto);
+    ByteSource* spooled = spooler(camera);
+    return spooled && renderImage(*spooled, camera.format(), camera.width(), camera.height());
+  }
+
+  bool snap(Camera& camera, CaptureFormat format)
+  {
+    SnapStatsScope stats;
+    AllocationGuard guard;
+    if (!takePicture(camera, format))
+    {
+      return false;
+    }
+    return spoolCaptures && spooler ? renderSpooled(camera) : renderPicture(camera);
+  }
+
+private:
+  // readFully() a chunk at a time, yielding in between, for reading out a
+  // whole capture
+  static bool readYielding(ByteSource& src, uint8_t* dest, uint32_t len)
+  {
+    constexpr uint32_t ChunkSize = 16 * 1024;
+    while (len > 0)
+    {
+      uint32_t count = std::min(len, ChunkSize);
+      if (!readFully(src, dest, count))
+      {
+        return false;
+      }
+      dest += count;
+      len -= count;
+      Scheduler::yield();
+    }
+    return true;
+  }
+
+  void indicate(float progress, RGBColor color)
+  {
+    if (indicator_)
+    {
+      indicator_(progress, color);
+    }
+  }
+
+  // Restart segment offsets of a JPEG decoded in parallel, room for 2048
+  static constexpr size_t JpegSegmentScratchBytes = 16 * 1024;
+  // Heap to leave free, on top of the JPEG itself, before buffering a
+  // capture for parallel decoding. The strip buffers are in scratch.
+  static constexpr uint32_t JpegBufferHeapReserve = 64 * 1024;
+
+  Inky& inky_;
+  Indicator indicator_;
+  LabDiffusionBuffer labError_;
+  LumaDiffusionBuffer lumaError_;
+};
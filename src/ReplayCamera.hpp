@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Camera.hpp"
+#include "HalSim.hpp"
+#include "Stats.hpp"
+#include "Trace.hpp"
+
+#include <cpp/Logging.hpp>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// A camera for the host simulator that plays back pictures from files, in
+// turn. Capturing and reading out cost virtual time as the Arducam Mega
+// would: the exposure up front, then the FIFO read over SPI.
+class ReplayCamera : public Camera
+{
+public:
+  struct Picture
+  {
+    std::string name;
+    std::vector<uint8_t> data;
+    CaptureFormat format;
+    int width;
+    int height;
+  };
+
+  // Time from the capture command to the picture being in the FIFO
+  uint32_t captureMs = 150;
+  // SPI clock the FIFO is read out at (cam_spi_master.c)
+  uint32_t spiSpeedHz = 8000000;
+
+  // Where the modeled time went
+  uint64_t captureUs = 0;
+  uint64_t readoutUs = 0;
+
+  ReplayCamera()
+    : source_{*this}
+  { }
+
+  void add(Picture picture)
+  {
+    pictures_.push_back(std::move(picture));
+  }
+
+  // The picture last taken
+  const Picture* current() const
+  {
+    return current_;
+  }
+
+  virtual bool takePicture(CaptureFormat format) override
+  {
+    TraceScope trace(TraceSpan::TakePicture);
+    if (pictures_.empty())
+    {
+      DEBUG_LOG("Nothing to replay");
+      return false;
+    }
+
+    current_ = &pictures_[next_];
+    next_ = (next_ + 1) % pictures_.size();
+    DEBUG_LOG_IF(format != current_->format, "Replaying " << current_->name << " in its own format " << (int)current_->format << ", not " << (int)format);
+
+    captureUs += (uint64_t)captureMs * 1000;
+    SimBoard::instance().clock.advanceUs((uint64_t)captureMs * 1000);
+    source_.reset(current_->data.data(), (uint32_t)current_->data.size());
+    return true;
+  }
+
+  virtual int width() const override
+  {
+    return current_ ? current_->width : 0;
+  }
+
+  virtual int height() const override
+  {
+    return current_ ? current_->height : 0;
+  }
+
+  virtual CaptureFormat format() const override
+  {
+    return current_ ? current_->format : CaptureFormat::JPG;
+  }
+
+  virtual ByteSource& picture() override
+  {
+    return source_;
+  }
+
+private:
+  // The FIFO readout. There's no data() because the camera's FIFO isn't
+  // addressable, so the pipeline buffers (or streams) as it would on the
+  // device.
+  class Readout : public ByteSource
+  {
+  public:
+    Readout(ReplayCamera& camera)
+      : camera_{camera}
+    { }
+
+    void reset(const uint8_t* data, uint32_t size)
+    {
+      data_ = data;
+      size_ = size;
+      pos_ = 0;
+    }
+
+    virtual uint32_t remaining() const override
+    {
+      return size_ - pos_;
+    }
+
+    virtual uint32_t read(uint8_t* dest, uint32_t len) override
+    {
+      // In the Arducam's 255 byte bursts, as ArducamByteSource reads
+      TraceScope trace(TraceSpan::CameraRead);
+      StatScope stat(StatCounter::CameraReadUs);
+      uint32_t count = std::min(len, remaining());
+      trace.setArg((uint16_t)((count + 254) / 255));
+      for (uint32_t burst=0; burst < count; burst += 255)
+      {
+        Stats::addCameraRead(std::min<uint32_t>(255, count - burst));
+      }
+      memcpy(dest, data_ + pos_, count);
+      pos_ += count;
+
+      uint64_t us = (uint64_t)count * 8 * 1000000 / std::max<uint32_t>(camera_.spiSpeedHz, 1);
+      camera_.readoutUs += us;
+      SimBoard::instance().clock.advanceUs(us);
+      return count;
+    }
+
+    virtual void discard() override
+    {
+      pos_ = size_;
+    }
+
+  private:
+    ReplayCamera& camera_;
+    const uint8_t* data_ = nullptr;
+    uint32_t size_ = 0;
+    uint32_t pos_ = 0;
+  };
+
+  std::vector<Picture> pictures_;
+  size_t next_ = 0;
+  const Picture* current_ = nullptr;
+  Readout source_;
+};
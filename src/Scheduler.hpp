@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Hal.hpp"
+
+#include <stdint.h>
+#include <algorithm>
+#include <functional>
+
+// Cooperative scheduling for core0. The main loop's services (the shutter
+// button, the USB command line, the LEDs, the deferred log) are tasks that
+// run when their deadline comes up, and with nothing due the loop sleeps
+// until the next one. Long work - a snap's decode and dither, the panel
+// upload and refresh - runs in the foreground and yields at regular points:
+// each row it decodes (through the pipeline's progress callback), each SPI
+// chunk of a frame, and each sleep while the panel is busy.
+enum class TaskWhen : uint8_t
+{
+  Idle,   // only between commands (the command line, which isn't reentrant)
+  Always  // at every yield point too (the button, which mustn't miss a press)
+};
+
+struct SchedulerTask
+{
+  const char* name = nullptr;
+  uint32_t periodUs = 0;
+  TaskWhen when = TaskWhen::Idle;
+  std::function<void()> run;
+  uint64_t dueUs = 0;
+  bool running = false;
+  uint32_t runs = 0;
+  uint32_t longestRunUs = 0;
+};
+
+class Scheduler
+{
+public:
+  static constexpr int MaxTasks = 8;
+
+  // Run f every periodMs, starting now. False if there's no room.
+  static bool add(const char* name, uint32_t periodMs, TaskWhen when, std::function<void()> f)
+  {
+    if (count_ == MaxTasks)
+    {
+      return false;
+    }
+    SchedulerTask& task = tasks_[count_++];
+    task.name = name;
+    task.periodUs = periodMs * 1000;
+    task.when = when;
+    task.run = std::move(f);
+    task.dueUs = halTimeUs();
+    return true;
+  }
+
+  // One pass of the main loop: run whatever is due, then sleep until the
+  // next deadline
+  static void runOnce()
+  {
+    runDue(TaskWhen::Idle);
+    halSleepUntilUs(nextDueUs(TaskWhen::Idle));
+  }
+
+  // Let the tasks that may interrupt computation run, if any are due. Cheap
+  // enough to call per row.
+  static void yield()
+  {
+    if (halCoreNum() == 0)
+    {
+      noteYield();
+      runDue(TaskWhen::Always);
+    }
+  }
+
+  // Sleep for at least ms, running the tasks that may interrupt a command
+  // as they come due
+  static void sleepMs(uint32_t ms)
+  {
+    uint64_t endUs = halTimeUs() + (uint64_t)ms * 1000;
+    if (halCoreNum() != 0)
+    {
+      halSleepUntilUs(endUs);
+      return;
+    }
+    while (true)
+    {
+      noteYield();
+      runDue(TaskWhen::Always);
+      if (halTimeUs() >= endUs)
+      {
+        break;
+      }
+      halSleepUntilUs(std::min(endUs, nextDueUs(TaskWhen::Always)));
+    }
+  }
+
+  // The longest a command went without yielding, since the last reset
+  static uint32_t longestGapUs()
+  {
+    return longestGapUs_;
+  }
+
+  // Start measuring gaps from now
+  static void resetLongestGap()
+  {
+    longestGapUs_ = 0;
+    lastYieldUs_ = halTimeUs();
+  }
+
+  template <typename F>
+  static void forEach(F&& f)
+  {
+    for (int i=0; i < count_; ++i)
+    {
+      f((const SchedulerTask&)tasks_[i]);
+    }
+  }
+
+private:
+  static void runDue(TaskWhen level)
+  {
+    for (int i=0; i < count_; ++i)
+    {
+      SchedulerTask& task = tasks_[i];
+      if (task.running || task.when < level || halTimeUs() < task.dueUs)
+      {
+        continue;
+      }
+      uint64_t startUs = halTimeUs();
+      if (level == TaskWhen::Idle)
+      {
+        // Whatever it runs is a command, so gaps count from here
+        lastYieldUs_ = startUs;
+      }
+      task.running = true;
+      task.run();
+      task.running = false;
+      uint64_t endUs = halTimeUs();
+      if (level == TaskWhen::Idle)
+      {
+        lastYieldUs_ = 0;
+      }
+      ++task.runs;
+      task.longestRunUs = std::max(task.longestRunUs, (uint32_t)(endUs - startUs));
+      task.dueUs = endUs + task.periodUs;
+    }
+  }
+
+  // The earliest deadline of the tasks that may run at level
+  static uint64_t nextDueUs(TaskWhen level)
+  {
+    uint64_t due = UINT64_MAX;
+    for (int i=0; i < count_; ++i)
+    {
+      const SchedulerTask& task = tasks_[i];
+      if (!task.running && task.when >= level)
+      {
+        due = std::min(due, task.dueUs);
+      }
+    }
+    return due;
+  }
+
+  static void noteYield()
+  {
+    uint64_t now = halTimeUs();
+    if (lastYieldUs_ != 0)
+    {
+      longestGapUs_ = std::max(longestGapUs_, (uint32_t)(now - lastYieldUs_));
+    }
+    lastYieldUs_ = now;
+  }
+
+  static inline SchedulerTask tasks_[MaxTasks];
+  static inline int count_ = 0;
+  static inline uint64_t lastYieldUs_ = 0;
+  static inline uint32_t longestGapUs_ = 0;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "DeferredLog.hpp"
+
+#include <stdint.h>
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+
+// Working memory for decoding, set aside once at startup so a snap doesn't
+// touch the heap (and can't fail on a fragmented one). Buffers are taken
+// off the top and handed back in reverse order, which ScratchBuffer does by
+// living on the stack.
+class ScratchArena
+{
+public:
+  static ScratchArena& instance()
+  {
+    static ScratchArena arena;
+    return arena;
+  }
+
+  // Allocate the arena. Only meant to be called at startup.
+  void reserve(size_t bytes)
+  {
+    storage_ = std::make_unique<uint8_t[]>(bytes);
+    capacity_ = bytes;
+    used_ = 0;
+    peak_ = 0;
+  }
+
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  size_t available() const
+  {
+    return capacity_ - used_;
+  }
+
+  // Most ever in use at once
+  size_t peak() const
+  {
+    return peak_;
+  }
+
+  // bytes aligned to align, or null if they don't fit
+  void* take(size_t bytes, size_t align)
+  {
+    size_t offset = (used_ + align - 1) & ~(align - 1);
+    if (offset + bytes > capacity_)
+    {
+      return nullptr;
+    }
+    used_ = offset + bytes;
+    peak_ = std::max(peak_, used_);
+    return storage_.get() + offset;
+  }
+
+  size_t mark() const
+  {
+    return used_;
+  }
+
+  // Hand back everything taken since mark. Marks handed back out of order
+  // never grow the arena again.
+  void release(size_t mark)
+  {
+    used_ = std::min(used_, mark);
+  }
+
+private:
+  std::unique_ptr<uint8_t[]> storage_;
+  size_t capacity_ = 0;
+  size_t used_ = 0;
+  size_t peak_ = 0;
+};
+
+// count Ts from the arena for as long as this is in scope, value
+// initialized. If the arena is too small (or was never reserved, as in
+// the host tools) they come from the heap instead.
+template <typename T>
+class ScratchBuffer
+{
+public:
+  static_assert(std::is_trivially_destructible<T>::value, "Scratch is handed back without destructors");
+
+  explicit ScratchBuffer(size_t count)
+    : mark_{ScratchArena::instance().mark()}
+    , size_{count}
+  {
+    data_ = (T*)ScratchArena::instance().take(count * sizeof(T), alignof(T));
+    if (data_)
+    {
+      std::uninitialized_value_construct_n(data_, count);
+    }
+    else
+    {
+      if (ScratchArena::instance().capacity() > 0)
+      {
+        PINKY_LOG(ScratchTooSmall, count * sizeof(T));
+      }
+      heap_ = std::make_unique<T[]>(count);
+      data_ = heap_.get();
+    }
+  }
+
+  ~ScratchBuffer()
+  {
+    ScratchArena::instance().release(mark_);
+  }
+
+  ScratchBuffer(const ScratchBuffer&) = delete;
+  ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+  T* data()
+  {
+    return data_;
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  T& operator[](size_t i)
+  {
+    return data_[i];
+  }
+
+private:
+  size_t mark_;
+  size_t size_;
+  T* data_;
+  std::unique_ptr<T[]> heap_;
+};
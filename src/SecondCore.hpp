@@ -0,0 +1,95 @@
+#pragma once
+
+#include "MemWatch.hpp"
+
+#include <atomic>
+
+#if PICO_ON_DEVICE
+#include <pico/stdlib.h>
+#else
+#include <thread>
+#endif
+
+#if defined(ENABLE_PICO_MULTICORE)
+#include <pico/multicore.h>
+#endif
+
+// Runs one job at a time on core1 (or a worker thread on the host) while
+// the caller carries on. Without ENABLE_PICO_MULTICORE the device has no
+// second core to offer and callers fall back to doing the work themselves.
+class SecondCore
+{
+public:
+  using Job = void(*)(void* arg);
+
+  static constexpr bool available()
+  {
+#if defined(ENABLE_PICO_MULTICORE) || !PICO_ON_DEVICE
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  static void launch(Job job, void* arg)
+  {
+#if defined(ENABLE_PICO_MULTICORE)
+    job_ = job;
+    arg_ = arg;
+    done_.store(false, std::memory_order_release);
+    multicore_reset_core1();
+    MemWatch::paintCore1Stack();
+    multicore_launch_core1([]()
+    {
+      job_(arg_);
+      done_.store(true, std::memory_order_release);
+    });
+#elif !PICO_ON_DEVICE
+    // The host's stand-in for core1 isn't the firmware allocating
+    AllocationGuardPause pause;
+    thread_ = std::thread(job, arg);
+#else
+    job(arg);
+#endif
+  }
+
+  // Wait for the job to finish
+  static void join()
+  {
+#if defined(ENABLE_PICO_MULTICORE)
+    while (!done_.load(std::memory_order_acquire))
+    {
+      tight_loop_contents();
+    }
+    MemWatch::measureCore1Stack();
+
+    // Park core1 in reset so it can't be caught running from flash while
+    // flash is being written
+    multicore_reset_core1();
+#elif !PICO_ON_DEVICE
+    if (thread_.joinable())
+    {
+      thread_.join();
+    }
+#endif
+  }
+
+  // Call from inside spin loops that wait on the other core
+  static void relax()
+  {
+#if PICO_ON_DEVICE
+    tight_loop_contents();
+#else
+    std::this_thread::yield();
+#endif
+  }
+
+private:
+#if defined(ENABLE_PICO_MULTICORE)
+  static inline Job job_ = nullptr;
+  static inline void* arg_ = nullptr;
+  static inline std::atomic<bool> done_ {true};
+#elif !PICO_ON_DEVICE
+  static inline std::thread thread_;
+#endif
+};
@@ -0,0 +1,423 @@
+#pragma once
+
+#include "Crc32.hpp"
+#include "HalSim.hpp"
+#include "Image.hpp"
+#include "InkyConfig.hpp"
+#include "InkyPalettes.hpp"
+#include "MemWatch.hpp"
+
+#include <cpp/Color.hpp>
+
+#include <stdint.h>
+#include <string.h>
+#include <array>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Simulated Inky boards for the host build (see HalSim.hpp): the panel's
+// controller on the SPI bus and the EEPROM that identifies it.
+
+// What the EEPROM of each supported board holds
+inline InkyEeprom simInkyEeprom(DisplayVariant variant)
+{
+  InkyEeprom eeprom
+  {
+    .width = 0,
+    .height = 0,
+    .colorCapability = ColorCapability::BlackWhite,
+    .pcbVariant = 12,
+    .displayVariant = variant,
+    .writeTime = {},
+  };
+  strcpy(eeprom.writeTime, "simulated");
+
+  switch (variant)
+  {
+    case DisplayVariant::Seven_Colour_UC8159:
+      eeprom.width = 600;
+      eeprom.height = 448;
+      eeprom.colorCapability = ColorCapability::SevenColor;
+      break;
+    case DisplayVariant::Seven_Colour_640x400_UC8159:
+    case DisplayVariant::Seven_Colour_640x400_UC8159_v2:
+      eeprom.width = 640;
+      eeprom.height = 400;
+      eeprom.colorCapability = ColorCapability::SevenColor;
+      break;
+    case DisplayVariant::Spectra_6_7_3_800x480_E673:
+      eeprom.width = 800;
+      eeprom.height = 480;
+      eeprom.colorCapability = ColorCapability::Spectra6;
+      break;
+    case DisplayVariant::Black_wHAT_SSD1683:
+    case DisplayVariant::Red_wHAT_SSD1683:
+    case DisplayVariant::Yellow_wHAT_SSD1683:
+      eeprom.width = 400;
+      eeprom.height = 300;
+      eeprom.colorCapability = variant == DisplayVariant::Red_wHAT_SSD1683 ? ColorCapability::BlackWhiteRed
+                             : variant == DisplayVariant::Yellow_wHAT_SSD1683 ? ColorCapability::BlackWhiteYellow
+                             : ColorCapability::BlackWhite;
+      break;
+    default:
+      break;
+  }
+  return eeprom;
+}
+
+// An I2C EEPROM with an 8 bit address pointer. Writes only move the
+// pointer, the contents are write protected.
+class SimEeprom : public SimPeripheral
+{
+public:
+  SimEeprom(uint8_t address, const InkyEeprom& contents)
+    : address_{address}
+  {
+    memory_.fill(0xFF);
+    memcpy(memory_.data(), &contents, sizeof(contents));
+  }
+
+  virtual bool i2cWrite(uint8_t address, const uint8_t* data, size_t len) override
+  {
+    if (address != address_)
+    {
+      return false;
+    }
+    if (len > 0)
+    {
+      pointer_ = data[0];
+    }
+    return true;
+  }
+
+  virtual bool i2cRead(uint8_t address, uint8_t* data, size_t len) override
+  {
+    if (address != address_)
+    {
+      return false;
+    }
+    for (size_t i=0; i < len; ++i)
+    {
+      data[i] = memory_[pointer_++];
+    }
+    return true;
+  }
+
+private:
+  uint8_t address_;
+  uint8_t pointer_ = 0;
+  std::array<uint8_t, 256> memory_;
+};
+
+// An Inky board: the panel controller on the SPI bus and its EEPROM on
+// I2C. The controller follows the command stream the driver sends (DC low
+// for command bytes, high for their data), holds BUSY for as long as the
+// real one would, roughly, and keeps what every refresh puts on the glass.
+class SimInky : public SimPeripheral
+{
+public:
+  // How long the controller holds BUSY for, in ms
+  struct Timing
+  {
+    uint32_t resetMs = 10;
+    uint32_t powerOnMs = 100;
+    uint32_t powerOffMs = 50;
+    uint32_t refreshMs = 30000;
+  };
+
+  // A refresh, in the colors of the panel's palette
+  struct Refresh
+  {
+    uint64_t timeUs;
+    int width;
+    int height;
+    std::vector<RGBColor> pixels;
+  };
+
+  Timing timing;
+  std::vector<Refresh> refreshes;
+  uint64_t busyUs = 0;
+
+  SimInky(DisplayVariant variant, const InkyConfig& config = {})
+    : config_{config}
+    , eepromContents_{simInkyEeprom(variant)}
+    , eeprom_{config.I2CDeviceId, eepromContents_}
+  {
+    switch (variant)
+    {
+      case DisplayVariant::Black_wHAT_SSD1683:
+      case DisplayVariant::Red_wHAT_SSD1683:
+      case DisplayVariant::Yellow_wHAT_SSD1683:
+        controller_ = Controller::SSD1683;
+        timing.refreshMs = variant == DisplayVariant::Black_wHAT_SSD1683 ? 4000 : 16000;
+        break;
+      case DisplayVariant::Spectra_6_7_3_800x480_E673:
+        controller_ = Controller::E673;
+        timing.refreshMs = 20000;
+        break;
+      default:
+        controller_ = Controller::UC8159;
+        timing.refreshMs = 30000;
+        break;
+    }
+
+    int width = eepromContents_.width;
+    int height = eepromContents_.height;
+    if (controller_ == Controller::SSD1683)
+    {
+      black_.resize((width * height + 7) / 8);
+      color_.resize((width * height + 7) / 8);
+    }
+    else
+    {
+      ram_.resize(width * height / 2);
+    }
+
+    SimBoard::instance().attach(*this);
+    SimBoard::instance().attach(eeprom_);
+  }
+
+  virtual ~SimInky()
+  {
+    SimBoard::instance().detach(eeprom_);
+    SimBoard::instance().detach(*this);
+  }
+
+  const InkyEeprom& eeprom() const
+  {
+    return eepromContents_;
+  }
+
+  // BUSY is active low on the UC8159 and E673, active high on the SSD1683
+  virtual bool drivesPin(uint pin, bool& level) override
+  {
+    if (pin != config_.BUSY_PIN)
+    {
+      return false;
+    }
+    bool busy = SimBoard::instance().clock.nowUs() < busyUntilUs_;
+    level = controller_ == Controller::SSD1683 ? busy : !busy;
+    return true;
+  }
+
+  virtual void pinChanged(uint pin, bool level) override
+  {
+    if (pin == config_.RESET_PIN && level && inReset_)
+    {
+      busy(timing.resetMs);
+    }
+    inReset_ = pin == config_.RESET_PIN ? !level : inReset_;
+  }
+
+  virtual void spiWrite(uint csPin, const uint8_t* data, size_t len) override
+  {
+    if (csPin != config_.SPI_CSn_PIN)
+    {
+      return;
+    }
+
+    // The panel model's memory isn't the firmware's
+    AllocationGuardPause pause;
+    if (SimBoard::instance().getPin(config_.DC_PIN))
+    {
+      writeData(data, len);
+      return;
+    }
+    for (size_t i=0; i < len; ++i)
+    {
+      command(data[i]);
+    }
+  }
+
+private:
+  enum class Controller
+  {
+    UC8159,
+    E673,
+    SSD1683
+  };
+
+  void busy(uint32_t ms)
+  {
+    busyUs += (uint64_t)ms * 1000;
+    busyUntilUs_ = SimBoard::instance().clock.nowUs() + (uint64_t)ms * 1000;
+  }
+
+  void command(uint8_t command)
+  {
+    command_ = command;
+    offset_ = 0;
+    if (controller_ == Controller::SSD1683)
+    {
+      switch (command)
+      {
+        case 0x12: // SW_RESET
+          busy(timing.resetMs);
+          break;
+        case 0x20: // MASTER_ACTIVATE
+          refresh();
+          break;
+      }
+      return;
+    }
+
+    // UC8159 and E673 share these
+    switch (command)
+    {
+      case 0x02: // POF
+        busy(timing.powerOffMs);
+        break;
+      case 0x04: // PON
+        busy(timing.powerOnMs);
+        break;
+      case 0x12: // DRF
+        refresh();
+        break;
+    }
+  }
+
+  void writeData(const uint8_t* data, size_t len)
+  {
+    std::vector<uint8_t>* ram = nullptr;
+    if (controller_ == Controller::SSD1683)
+    {
+      ram = command_ == 0x24 ? &black_ : command_ == 0x26 ? &color_ : nullptr;
+    }
+    else if (command_ == 0x10) // DTM1
+    {
+      ram = &ram_;
+    }
+
+    if (ram && offset_ < ram->size())
+    {
+      size_t count = std::min(len, ram->size() - offset_);
+      memcpy(ram->data() + offset_, data, count);
+    }
+    offset_ += len;
+  }
+
+  // Decode the RAM the same way the driver's frame buffer encodes it
+  void refresh()
+  {
+    int width = eepromContents_.width;
+    int height = eepromContents_.height;
+    Refresh refresh{SimBoard::instance().clock.nowUs(), width, height, std::vector<RGBColor>(width * height)};
+
+    if (controller_ == Controller::SSD1683)
+    {
+      std::shared_ptr<IndexedColorMap> colorMap = inkySSD1683ColorMap(eepromContents_.colorCapability);
+      std::shared_ptr<PackedTwoPlaneBinaryImage> frame = inkySSD1683Frame(width, height, *colorMap, eepromContents_.colorCapability);
+      frame->getPlane(PackedTwoPlaneBinaryImage::Plane::Black) = black_;
+      if (eepromContents_.colorCapability != ColorCapability::BlackWhite)
+      {
+        frame->getPlane(PackedTwoPlaneBinaryImage::Plane::Color) = color_;
+      }
+      render(*frame, *colorMap, refresh.pixels);
+    }
+    else
+    {
+      std::shared_ptr<IndexedColorMap> colorMap = controller_ == Controller::E673 ? inkyE673ColorMap() : inkyUC8159ColorMap();
+      Packed4BitIndexedImage frame(width, height);
+      frame.getData() = ram_;
+      render(frame, *colorMap, refresh.pixels);
+    }
+
+    refreshes.push_back(std::move(refresh));
+    busy(timing.refreshMs);
+  }
+
+  static void render(const ImageView<IndexedColor>& frame, const IndexedColorMap& colorMap, std::vector<RGBColor>& pixels)
+  {
+    for (int y=0; y < frame.height; ++y)
+    {
+      for (int x=0; x < frame.width; ++x)
+      {
+        pixels[y * frame.width + x] = colorMap.toRGBColor(frame.getPixel(x, y));
+      }
+    }
+  }
+
+  InkyConfig config_;
+  InkyEeprom eepromContents_;
+  SimEeprom eeprom_;
+  Controller controller_;
+
+  uint64_t busyUntilUs_ = 0;
+  bool inReset_ = false;
+  uint8_t command_ = 0;
+  size_t offset_ = 0;
+  std::vector<uint8_t> ram_;
+  std::vector<uint8_t> black_;
+  std::vector<uint8_t> color_;
+};
+
+// Write 8 bit RGB pixels as a PNG. The pixel data goes in stored
+// (uncompressed) deflate blocks, so there's no zlib to depend on.
+inline bool writePng(const std::string& path, int width, int height, const std::vector<RGBColor>& pixels)
+{
+  auto put32 = [](std::vector<uint8_t>& out, uint32_t value)
+  {
+    for (int shift=24; shift >= 0; shift -= 8)
+    {
+      out.push_back((uint8_t)(value >> shift));
+    }
+  };
+
+  std::vector<uint8_t> raw;
+  raw.reserve((size_t)(width * 3 + 1) * height);
+  for (int y=0; y < height; ++y)
+  {
+    raw.push_back(0); // no filter
+    for (int x=0; x < width; ++x)
+    {
+      const RGBColor& c = pixels[y * width + x];
+      raw.insert(raw.end(), {c.R, c.G, c.B});
+    }
+  }
+
+  std::vector<uint8_t> zlib{0x78, 0x01};
+  uint32_t adlerA = 1;
+  uint32_t adlerB = 0;
+  for (size_t pos=0; pos < raw.size() || pos == 0;)
+  {
+    uint16_t len = (uint16_t)std::min<size_t>(raw.size() - pos, 65535);
+    bool last = pos + len == raw.size();
+    zlib.insert(zlib.end(), {(uint8_t)last, (uint8_t)len, (uint8_t)(len >> 8), (uint8_t)~len, (uint8_t)(~len >> 8)});
+    zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + len);
+    for (size_t i=pos; i < pos + len; ++i)
+    {
+      adlerA = (adlerA + raw[i]) % 65521;
+      adlerB = (adlerB + adlerA) % 65521;
+    }
+    pos += len;
+    if (last)
+    {
+      break;
+    }
+  }
+  put32(zlib, (adlerB << 16) | adlerA);
+
+  std::vector<uint8_t> png{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  auto chunk = [&](const char* type, const std::vector<uint8_t>& data)
+  {
+    put32(png, (uint32_t)data.size());
+    size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    put32(png, crc32(0, png.data() + start, (uint32_t)(png.size() - start)));
+  };
+
+  std::vector<uint8_t> header;
+  put32(header, width);
+  put32(header, height);
+  header.insert(header.end(), {8, 2, 0, 0, 0}); // 8 bit RGB, no interlace
+  chunk("IHDR", header);
+  chunk("IDAT", zlib);
+  chunk("IEND", {});
+
+  std::ofstream out(path, std::ios::binary);
+  out.write((const char*)png.data(), png.size());
+  return (bool)out;
+}
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "Hal.hpp"
+#include "ImageDecode.hpp"
+#include "ImageView.hpp"
+#include "IndexedColor.hpp"
+
+#include <cpp/Color.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Heap to leave free for decoding once the cache is allocated
+constexpr uint32_t SourceCacheHeapReserve = 64 * 1024;
+
+// The last decoded image at display resolution, as it was handed to the
+// dither stage, so a different color map or dither setting can be applied
+// without another capture and decode. Color images keep Lab 4:2:0: an 8 bit
+// L plane plus a and b at half resolution in each direction (1.5 bytes per
+// pixel), each chroma sample the mean of its 2x2 cell. Monochrome images
+// keep only luma (1 byte per pixel). The storage is kept from one image to
+// the next, so recording doesn't allocate.
+//
+// A replay isn't bit exact with the original decode: L is quantised to
+// steps of 100/255, a and b are rounded to whole units and clamped to
+// -128..127, and chroma is shared by each 2x2 cell, so dithering the
+// replay can differ from dithering the decode by a pixel here and there.
+//
+// The cache is only allocated while the heap keeps SourceCacheHeapReserve
+// free on top of it. When it doesn't, the image isn't kept, the NoSourceCache
+// message is logged, and rerender falls back to the spooled capture, or has
+// nothing to rerender if spool is off.
+class SourceImageCache
+{
+public:
+  static uint32_t bytesFor(int width, int height, bool chroma)
+  {
+    uint32_t lumaBytes = (uint32_t)width * height;
+    return chroma ? lumaBytes + 2 * chromaWidth(width) * chromaHeight(height) : lumaBytes;
+  }
+
+  bool valid() const
+  {
+    return valid_;
+  }
+
+  bool hasChroma() const
+  {
+    return chroma_;
+  }
+
+  void clear()
+  {
+    valid_ = false;
+  }
+
+  // Clear and give the storage back to the heap
+  void release()
+  {
+    clear();
+    lightness_ = std::vector<uint8_t>();
+    a_ = std::vector<uint8_t>();
+    b_ = std::vector<uint8_t>();
+  }
+
+  // Make sure there is storage for an image of the given size, allocating
+  // it only if it isn't there already and the heap has room for it
+  bool reserve(int width, int height, bool chroma)
+  {
+    size_t lumaBytes = (size_t)width * height;
+    size_t chromaBytes = chroma ? (size_t)chromaWidth(width) * chromaHeight(height) : 0;
+    if (lightness_.size() == lumaBytes && (!chroma || a_.size() == chromaBytes))
+    {
+      return true;
+    }
+
+    release();
+    if (bytesFor(width, height, chroma) + SourceCacheHeapReserve >= halFreeHeap())
+    {
+      return false;
+    }
+    lightness_.resize(lumaBytes);
+    a_.resize(chromaBytes);
+    b_.resize(chromaBytes);
+    return true;
+  }
+
+  // Start recording an image of the given size, into storage from
+  // reserve(). chroma is false for images only ever written as luma.
+  void begin(int width, int height, bool chroma)
+  {
+    clear();
+    width_ = width;
+    height_ = height;
+    chroma_ = chroma;
+    std::fill(lightness_.begin(), lightness_.end(), 0);
+    if (chroma)
+    {
+      std::fill(a_.begin(), a_.end(), 128);
+      std::fill(b_.begin(), b_.end(), 128);
+    }
+    written_ = ImageRegion{};
+  }
+
+  // Recording finished successfully
+  void commit()
+  {
+    valid_ = !written_.empty();
+  }
+
+  void record(int x, int y, const LabColor* colors, int count)
+  {
+    // Chroma first, while written_ still covers only what came before
+    if (chroma_)
+    {
+      recordChroma(x, y, colors, count);
+    }
+    extendWritten(x, y, count);
+    uint8_t* l = &lightness_[y * width_ + x];
+    for (int i=0; i < count; ++i)
+    {
+      l[i] = (uint8_t)std::clamp((int)std::lround(colors[i].L * 2.55f), 0, 255);
+    }
+  }
+
+  void record(int x, int y, const LumaColor* colors, int count)
+  {
+    extendWritten(x, y, count);
+    uint8_t* l = &lightness_[y * width_ + x];
+    for (int i=0; i < count; ++i)
+    {
+      l[i] = tables().lumaToLightness[colors[i].Y];
+    }
+  }
+
+  // Write the cached image into view, which must be the same size
+  template <typename PixelT>
+  bool replay(ImageView<PixelT>& view, ProgressUpdateCallback progressCb = nullptr) const
+  {
+    if (!valid_ || view.width != width_ || view.height != height_)
+    {
+      return false;
+    }
+
+    PixelT chunk[DecodeChunkSize];
+    for (int y = written_.y; y < written_.bottom(); ++y)
+    {
+      for (int x0 = written_.x; x0 < written_.right(); x0 += DecodeChunkSize)
+      {
+        int count = std::min(DecodeChunkSize, written_.right() - x0);
+        for (int i=0; i < count; ++i)
+        {
+          pixelAt(x0 + i, y, chunk[i]);
+        }
+        view.setPixels(x0, y, chunk, count);
+      }
+      if (progressCb)
+      {
+        progressCb((float)(y - written_.y) / (float)written_.height);
+      }
+    }
+    return true;
+  }
+
+private:
+  struct Tables
+  {
+    std::array<uint8_t, 256> lumaToLightness;
+    std::array<uint8_t, 256> lightnessToLuma;
+  };
+
+  // Lightness here is Lab L scaled to 0-255, as in IndexedColorMap
+  static const Tables& tables()
+  {
+    static Tables t = []()
+    {
+      Tables t;
+      for (int i=0; i < 256; ++i)
+      {
+        uint8_t v = (uint8_t)i;
+        t.lumaToLightness[i] = (uint8_t)std::clamp((int)std::lround(RGBColor{v, v, v}.toLab().L * 2.55f), 0, 255);
+      }
+      // Lightness rises with luma, so the inverse is a merge
+      int luma = 0;
+      for (int l=0; l < 256; ++l)
+      {
+        while (luma < 255 && t.lumaToLightness[luma] < l)
+        {
+          ++luma;
+        }
+        t.lightnessToLuma[l] = (uint8_t)luma;
+      }
+      return t;
+    }();
+    return t;
+  }
+
+  static int chromaWidth(int width) { return (width + 1) / 2; }
+  static int chromaHeight(int height) { return (height + 1) / 2; }
+
+  // Fold each sample into the mean of its 2x2 cell. Decoders write rows top
+  // to bottom and left to right, so the samples a cell already holds are
+  // those of it inside written_ and earlier in this run, and a region that
+  // starts on an odd row or column still averages only real samples.
+  void recordChroma(int x, int y, const LabColor* colors, int count)
+  {
+    int cy = (y / 2) * chromaWidth(width_);
+    for (int i=0; i < count; ++i)
+    {
+      int px = x + i;
+      int left = px & ~1;
+      int before = 0;
+      if (y & 1)
+      {
+        before += recorded(left, y - 1) + recorded(left + 1, y - 1);
+      }
+      if ((px & 1) && (i > 0 || recorded(px - 1, y)))
+      {
+        ++before;
+      }
+      int c = cy + px / 2;
+      a_[c] = foldMean(a_[c], colors[i].a, before);
+      b_[c] = foldMean(b_[c], colors[i].b, before);
+    }
+  }
+
+  bool recorded(int x, int y) const
+  {
+    return !written_.empty() && x >= written_.x && x < written_.right() && y >= written_.y && y < written_.bottom();
+  }
+
+  // The mean of count samples with mean stored (offset by 128), and sample
+  static uint8_t foldMean(uint8_t stored, float sample, int count)
+  {
+    float sum = (float)stored * count + sample + 128.0f;
+    return (uint8_t)std::clamp((int)std::lround(sum / (count + 1)), 0, 255);
+  }
+
+  void extendWritten(int x, int y, int count)
+  {
+    ImageRegion run {x, y, count, 1};
+    if (written_.empty())
+    {
+      written_ = run;
+      return;
+    }
+    int x0 = std::min(written_.x, run.x);
+    int y0 = std::min(written_.y, run.y);
+    int x1 = std::max(written_.right(), run.right());
+    int y1 = std::max(written_.bottom(), run.bottom());
+    written_ = ImageRegion{x0, y0, x1 - x0, y1 - y0};
+  }
+
+  void pixelAt(int x, int y, LabColor& out) const
+  {
+    float L = lightness_[y * width_ + x] / 2.55f;
+    if (!chroma_)
+    {
+      out = LabColor{L, 0, 0};
+      return;
+    }
+    int c = (y / 2) * chromaWidth(width_) + x / 2;
+    out = LabColor{L, (float)a_[c] - 128.0f, (float)b_[c] - 128.0f};
+  }
+
+  void pixelAt(int x, int y, LumaColor& out) const
+  {
+    out = LumaColor{tables().lightnessToLuma[lightness_[y * width_ + x]]};
+  }
+
+  int width_ = 0;
+  int height_ = 0;
+  bool chroma_ = false;
+  bool valid_ = false;
+  ImageRegion written_;
+  std::vector<uint8_t> lightness_;
+  std::vector<uint8_t> a_;
+  std::vector<uint8_t> b_;
+};
+
+// Passes pixels through to destination while recording them into a cache
+template <typename ImageViewT>
+class SourceCacheView : public ImageView<typename ImageViewT::PixelType>
+{
+public:
+  using PixelType = typename ImageViewT::PixelType;
+
+  SourceCacheView(ImageViewT& destination, SourceImageCache& cache)
+    : ImageView<PixelType>{destination.width, destination.height}
+    , destination_{destination}
+    , cache_{cache}
+  { }
+
+  virtual ~SourceCacheView() = default;
+
+  virtual PixelType getPixel(int x, int y) const override
+  {
+    return destination_.getPixel(x, y);
+  }
+
+  virtual void setPixel(int x, int y, const PixelType& color) override
+  {
+    setPixels(x, y, &color, 1);
+  }
+
+  virtual void setPixels(int x, int y, const PixelType* colors, int count) override
+  {
+    // Clip once, like the dither views do
+    int x0 = std::max(x, 0);
+    int x1 = std::min(x + count, this->width);
+    if (y < 0 || y >= this->height || x0 >= x1)
+    {
+      return;
+    }
+    cache_.record(x0, y, colors + (x0 - x), x1 - x0);
+    destination_.setPixels(x0, y, colors + (x0 - x), x1 - x0);
+  }
+
+  virtual ImageRegion visibleRegion() const override
+  {
+    return destination_.visibleRegion();
+  }
+
+private:
+  ImageViewT& destination_;
+  SourceImageCache& cache_;
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+// Lock-free ring of preallocated slots with exactly one producer and one
+// consumer, which may run on different cores. Slots can be filled and
+// drained in place, so large blocks never get copied. The slots are either
+// the ring's own or lent by the caller.
+template <typename T>
+class SpscRing
+{
+public:
+  SpscRing(uint32_t capacity, const T& init = T())
+    : owned_(capacity, init)
+    , slots_{owned_.data()}
+    , capacity_{capacity}
+  { }
+
+  SpscRing(T* slots, uint32_t capacity)
+    : slots_{slots}
+    , capacity_{capacity}
+  { }
+
+  uint32_t capacity() const
+  {
+    return capacity_;
+  }
+
+  uint32_t size() const
+  {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+  // Producer: the next free slot, or null if the ring is full
+  T* writeSlot()
+  {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == capacity())
+    {
+      return nullptr;
+    }
+    return &slots_[head % capacity()];
+  }
+
+  // Producer: publish the slot returned by writeSlot()
+  void commitWrite()
+  {
+    head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  bool push(const T& value)
+  {
+    T* slot = writeSlot();
+    if (!slot)
+    {
+      return false;
+    }
+    *slot = value;
+    commitWrite();
+    return true;
+  }
+
+  // Consumer: the oldest published slot, or null if the ring is empty
+  T* readSlot()
+  {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) == tail)
+    {
+      return nullptr;
+    }
+    return &slots_[tail % capacity()];
+  }
+
+  // Consumer: hand the slot returned by readSlot() back to the producer
+  void commitRead()
+  {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  bool pop(T& value)
+  {
+    T* slot = readSlot();
+    if (!slot)
+    {
+      return false;
+    }
+    value = *slot;
+    commitRead();
+    return true;
+  }
+
+private:
+  std::vector<T> owned_;
+  T* slots_;
+  uint32_t capacity_;
+
+  // Free running counts of slots written and read
+  std::atomic<uint32_t> head_ {0};
+  std::atomic<uint32_t> tail_ {0};
+};
@@ -0,0 +1,233 @@
+#pragma once
+
+#include "Hal.hpp"
+
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include <ostream>
+
+// Always-on counters for the hot paths: what each stage moved and how long
+// it took, so a slow snap can be put down to the camera, the CPU or the
+// panel. Each core counts into its own set, so nothing is shared on the
+// hot path. The totals are sampled around each snap and the last
+// StatsSnapHistory of them kept for the stats command.
+//
+// Build with PINKY_STATS=0 to compile the counters out.
+#ifndef PINKY_STATS
+#define PINKY_STATS 1
+#endif
+
+enum class StatCounter : uint8_t
+{
+  CameraBytes,     // read out of the camera
+  CameraReads,     // readBuff bursts
+  CameraReadUs,
+  DecodeUs,        // the whole decode stage, camera reads and dithering included
+  PixelsDecoded,
+  LabConversions,  // pixels converted to Lab through the lookup tables
+  PixelsDithered,
+  DitherUs,
+  SpiBytes,        // sent to the panel
+  SpiUs,
+  SleepUs,         // display driver sleeps, BUSY polling included
+  BusyWaitUs,      // waiting on the panel's BUSY line
+  Count
+};
+
+// readBuff burst sizes, in buckets of this many bytes (a burst is at most
+// 255 bytes)
+constexpr uint32_t StatsReadBucketBytes = 32;
+constexpr int StatsReadBuckets = 8;
+constexpr int StatsSnapHistory = 8;
+
+struct StatsTotals
+{
+  std::array<uint64_t, (int)StatCounter::Count> counters {};
+  std::array<uint32_t, StatsReadBuckets> readSizes {};
+
+  uint64_t operator[](StatCounter counter) const
+  {
+    return counters[(int)counter];
+  }
+
+  StatsTotals operator-(const StatsTotals& other) const
+  {
+    StatsTotals delta;
+    for (size_t i=0; i < counters.size(); ++i)
+    {
+      delta.counters[i] = counters[i] - other.counters[i];
+    }
+    for (size_t i=0; i < readSizes.size(); ++i)
+    {
+      delta.readSizes[i] = readSizes[i] - other.readSizes[i];
+    }
+    return delta;
+  }
+};
+
+// One snap: what the counters moved by, over how long
+struct SnapStats
+{
+  uint64_t totalUs = 0;
+  StatsTotals totals;
+};
+
+class Stats
+{
+public:
+  static void add(StatCounter counter, uint64_t value)
+  {
+#if PINKY_STATS
+    perCore_[halCoreNum()].counters[(int)counter] += value;
+#else
+    (void)counter;
+    (void)value;
+#endif
+  }
+
+  static void addCameraRead(uint32_t bytes)
+  {
+#if PINKY_STATS
+    StatsTotals& totals = perCore_[halCoreNum()];
+    totals.counters[(int)StatCounter::CameraBytes] += bytes;
+    ++totals.counters[(int)StatCounter::CameraReads];
+    ++totals.readSizes[std::min<uint32_t>(bytes / StatsReadBucketBytes, StatsReadBuckets - 1)];
+#else
+    (void)bytes;
+#endif
+  }
+
+  // Both cores together
+  static StatsTotals totals()
+  {
+    StatsTotals sum;
+#if PINKY_STATS
+    for (const StatsTotals& core : perCore_)
+    {
+      for (size_t i=0; i < sum.counters.size(); ++i)
+      {
+        sum.counters[i] += core.counters[i];
+      }
+      for (size_t i=0; i < sum.readSizes.size(); ++i)
+      {
+        sum.readSizes[i] += core.readSizes[i];
+      }
+    }
+#endif
+    return sum;
+  }
+
+  static void addSnap(const SnapStats& snap)
+  {
+#if PINKY_STATS
+    snaps_[snapCount_ % StatsSnapHistory] = snap;
+    ++snapCount_;
+#else
+    (void)snap;
+#endif
+  }
+
+  // The snaps kept, oldest first
+  template <typename F>
+  static void forEachSnap(F&& f)
+  {
+#if PINKY_STATS
+    uint32_t first = snapCount_ - std::min<uint32_t>(snapCount_, StatsSnapHistory);
+    for (uint32_t i=first; i < snapCount_; ++i)
+    {
+      f(i, snaps_[i % StatsSnapHistory]);
+    }
+#else
+    (void)f;
+#endif
+  }
+
+#if PINKY_STATS
+private:
+  static inline StatsTotals perCore_[2];
+  static inline SnapStats snaps_[StatsSnapHistory];
+  static inline uint32_t snapCount_ = 0;
+#endif
+};
+
+// Adds the time from construction to destruction to a counter
+class StatScope
+{
+public:
+#if PINKY_STATS
+  StatScope(StatCounter counter)
+    : counter_{counter}
+    , startUs_{halTimeUs()}
+  { }
+
+  ~StatScope()
+  {
+    Stats::add(counter_, halTimeUs() - startUs_);
+  }
+
+private:
+  StatCounter counter_;
+  uint64_t startUs_;
+#else
+  StatScope(StatCounter /*counter*/) { }
+#endif
+};
+
+// Records one snap's worth of counters, from construction to destruction
+class SnapStatsScope
+{
+public:
+#if PINKY_STATS
+  SnapStatsScope()
+    : startUs_{halTimeUs()}
+    , start_{Stats::totals()}
+  { }
+
+  ~SnapStatsScope()
+  {
+    Stats::addSnap({halTimeUs() - startUs_, Stats::totals() - start_});
+  }
+
+private:
+  uint64_t startUs_;
+  StatsTotals start_;
+#else
+  SnapStatsScope() { }
+#endif
+};
+
+// Rates per stage for the snaps kept
+inline void printSnapStats(std::ostream& out)
+{
+  // Bytes (or pixels) per us is MB/s (or Mpix/s)
+  auto rate = [](uint64_t count, uint64_t us) { return (float)count / (float)std::max<uint64_t>(us, 1); };
+  auto ms = [](uint64_t us) { return (float)us / 1000.0f; };
+
+  bool any = false;
+  Stats::forEachSnap([&](uint32_t index, const SnapStats& snap)
+  {
+    any = true;
+    const StatsTotals& t = snap.totals;
+    out << "Snap " << index << ": " << ms(snap.totalUs) << " ms" << std::endl;
+    out << "  camera  " << t[StatCounter::CameraBytes] << " bytes in " << ms(t[StatCounter::CameraReadUs]) << " ms, "
+        << rate(t[StatCounter::CameraBytes], t[StatCounter::CameraReadUs]) << " MB/s, " << t[StatCounter::CameraReads] << " readBuff bursts (by "
+        << StatsReadBucketBytes << " bytes:";
+    for (uint32_t count : t.readSizes)
+    {
+      out << " " << count;
+    }
+    out << ")" << std::endl;
+    out << "  decode  " << t[StatCounter::PixelsDecoded] << " px in " << ms(t[StatCounter::DecodeUs]) << " ms, "
+        << rate(t[StatCounter::PixelsDecoded], t[StatCounter::DecodeUs]) << " Mpix/s, " << t[StatCounter::LabConversions] << " Lab conversions" << std::endl;
+    out << "  dither  " << t[StatCounter::PixelsDithered] << " px in " << ms(t[StatCounter::DitherUs]) << " ms, "
+        << rate(t[StatCounter::PixelsDithered], t[StatCounter::DitherUs]) << " Mpix/s" << std::endl;
+    out << "  spi     " << t[StatCounter::SpiBytes] << " bytes in " << ms(t[StatCounter::SpiUs]) << " ms, "
+        << rate(t[StatCounter::SpiBytes], t[StatCounter::SpiUs]) << " MB/s" << std::endl;
+    out << "  sleep   " << ms(t[StatCounter::SleepUs]) << " ms, " << ms(t[StatCounter::BusyWaitUs]) << " ms waiting on BUSY" << std::endl;
+  });
+  if (!any)
+  {
+    out << "No snaps yet" << std::endl;
+  }
+}
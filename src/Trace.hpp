@@ -0,0 +1,274 @@
+#pragma once
+
+#include "Hal.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include <ostream>
+
+// Per-stage timing of the snap path. Spans are recorded into a fixed ring
+// per core (so both cores can record without locking), keeping the most
+// recent TraceEventsPerCore of each. The trace command dumps them and
+// tools/trace2chrome.py turns the dump into a Chrome trace. Recording is
+// off until the tracing property is set.
+//
+// Camera reads come a few hundred bytes at a time, as the decoder asks for
+// them, so a run of them with nothing else recorded on the core in between
+// is kept as one span. That holds a UXGA JPEG snap to one read span per MCU
+// row, and the whole snap fits in the ring.
+//
+// Build with PINKY_TRACE=0 to compile every span out.
+#ifndef PINKY_TRACE
+#define PINKY_TRACE 1
+#endif
+
+enum class TraceSpan : uint8_t
+{
+  TakePicture,  // capture command until the picture is in the camera FIFO
+  CameraRead,   // reads out of the camera, arg is the number of bursts
+  DecodeRow,    // one source row (or MCU row), arg is the row
+  Dither,       // dithering within one output row, arg is the row
+  Clear,        // clearing the display buffer
+  Show,         // Inky::show, upload and refresh
+  SpiUpload,    // data sent to the panel, arg is the command
+  WaitBusy,     // waiting on the panel, arg is the command it's busy with
+};
+
+struct TraceEvent
+{
+  uint32_t startUs;
+  uint32_t durationUs;
+  uint16_t arg;
+  TraceSpan span;
+  uint8_t core;
+};
+
+constexpr uint32_t TraceEventsPerCore = 1024;
+
+struct TraceRing
+{
+  std::array<TraceEvent, TraceEventsPerCore> events;
+  // Events ever recorded. Only the core that owns the ring writes it.
+  uint32_t count = 0;
+};
+
+class Trace
+{
+public:
+  // Spans are only recorded while this is set
+  static inline bool enabled = false;
+
+  static void record(TraceSpan span, uint32_t startUs, uint32_t endUs, uint16_t arg)
+  {
+#if PINKY_TRACE
+    uint core = halCoreNum();
+    TraceRing& ring = rings_[core];
+    if (span == TraceSpan::CameraRead && ring.count > 0)
+    {
+      // Like TraceRowTimer, the run ends where its last read did and is as
+      // long as all its reads together
+      TraceEvent& last = ring.events[(ring.count - 1) % TraceEventsPerCore];
+      if (last.span == span)
+      {
+        last.durationUs += endUs - startUs;
+        last.startUs = endUs - last.durationUs;
+        last.arg = (uint16_t)std::min<uint32_t>(last.arg + arg, UINT16_MAX);
+        return;
+      }
+    }
+    ring.events[ring.count % TraceEventsPerCore] = {startUs, endUs - startUs, arg, span, (uint8_t)core};
+    ++ring.count;
+#else
+    (void)span;
+    (void)startUs;
+    (void)endUs;
+    (void)arg;
+#endif
+  }
+
+  // Events still in the rings, both cores merged by start time. Each core's
+  // own are in the order they ended (nested spans after their children).
+  // Don't call while either core is recording.
+  template <typename F>
+  static void forEach(F&& f)
+  {
+#if PINKY_TRACE
+    uint32_t next[2];
+    for (int core=0; core < 2; ++core)
+    {
+      next[core] = rings_[core].count - std::min(rings_[core].count, TraceEventsPerCore);
+    }
+    while (true)
+    {
+      const TraceEvent* oldest = nullptr;
+      int oldestCore = 0;
+      for (int core=0; core < 2; ++core)
+      {
+        if (next[core] == rings_[core].count)
+        {
+          continue;
+        }
+        const TraceEvent& event = rings_[core].events[next[core] % TraceEventsPerCore];
+        if (!oldest || (int32_t)(event.startUs - oldest->startUs) < 0)
+        {
+          oldest = &event;
+          oldestCore = core;
+        }
+      }
+      if (!oldest)
+      {
+        return;
+      }
+      f(*oldest);
+      ++next[oldestCore];
+    }
+#else
+    (void)f;
+#endif
+  }
+
+  // Events lost to the rings wrapping since the last clear
+  static uint32_t dropped()
+  {
+    uint32_t count = 0;
+#if PINKY_TRACE
+    for (const TraceRing& ring : rings_)
+    {
+      count += ring.count - std::min(ring.count, TraceEventsPerCore);
+    }
+#endif
+    return count;
+  }
+
+  static void clear()
+  {
+#if PINKY_TRACE
+    for (TraceRing& ring : rings_)
+    {
+      ring.count = 0;
+    }
+#endif
+  }
+
+#if PINKY_TRACE
+private:
+  static inline TraceRing rings_[2];
+#endif
+};
+
+// The events as text, one span per line, for tools/trace2chrome.py:
+//   <span> <core> <start us> <duration us> <arg>
+inline void printTrace(std::ostream& out)
+{
+  uint32_t count = 0;
+  Trace::forEach([&](const TraceEvent&) { ++count; });
+  out << "Trace: " << count << " events, " << Trace::dropped() << " dropped" << std::endl;
+  Trace::forEach([&](const TraceEvent& event)
+  {
+    out << magic_enum::enum_name(event.span) << " " << (int)event.core << " " << event.startUs << " "
+        << event.durationUs << " " << event.arg << "\n";
+  });
+  out << "Trace end" << std::endl;
+}
+
+// Records a span from construction to destruction
+class TraceScope
+{
+public:
+#if PINKY_TRACE
+  TraceScope(TraceSpan span, uint16_t arg = 0)
+    : span_{span}
+    , arg_{arg}
+    , active_{Trace::enabled}
+    , startUs_{active_ ? (uint32_t)halTimeUs() : 0}
+  { }
+
+  ~TraceScope()
+  {
+    if (active_)
+    {
+      Trace::record(span_, startUs_, (uint32_t)halTimeUs(), arg_);
+    }
+  }
+
+  void setArg(uint16_t arg)
+  {
+    arg_ = arg;
+  }
+
+private:
+  TraceSpan span_;
+  uint16_t arg_;
+  bool active_;
+  uint32_t startUs_;
+#else
+  TraceScope(TraceSpan /*span*/, uint16_t /*arg*/ = 0) { }
+  void setArg(uint16_t /*arg*/) { }
+#endif
+};
+
+// Time spread over many short calls that belong to one row (dithering a
+// row a chunk at a time), recorded as one span per row. The span ends where
+// the row's last call did and is as long as all its calls together.
+class TraceRowTimer
+{
+public:
+  TraceRowTimer(TraceSpan span)
+    : span_{span}
+  { }
+
+  ~TraceRowTimer()
+  {
+    flush();
+  }
+
+  uint32_t begin()
+  {
+#if PINKY_TRACE
+    return Trace::enabled ? (uint32_t)halTimeUs() : 0;
+#else
+    return 0;
+#endif
+  }
+
+  void end(int row, uint32_t startUs)
+  {
+#if PINKY_TRACE
+    if (!Trace::enabled)
+    {
+      return;
+    }
+    if (row != row_)
+    {
+      flush();
+      row_ = row;
+    }
+    endUs_ = (uint32_t)halTimeUs();
+    totalUs_ += endUs_ - startUs;
+#else
+    (void)row;
+    (void)startUs;
+#endif
+  }
+
+private:
+  void flush()
+  {
+#if PINKY_TRACE
+    if (row_ >= 0 && totalUs_ > 0)
+    {
+      Trace::record(span_, endUs_ - totalUs_, endUs_, (uint16_t)row_);
+    }
+    totalUs_ = 0;
+    row_ = -1;
+#endif
+  }
+
+  TraceSpan span_;
+  int row_ = -1;
+  uint32_t endUs_ = 0;
+  uint32_t totalUs_ = 0;
+};
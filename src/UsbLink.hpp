@@ -0,0 +1,364 @@
+#pragma once
+
+#include "ByteSource.hpp"
+#include "Crc32.hpp"
+#include "DeferredLog.hpp"
+#include "Hal.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// Binary protocol over USB CDC stdio, entered from the text command line
+// (see the link command) and left again with an Exit frame or after
+// LinkIdleTimeoutUs of silence. Every frame is
+//
+//   'P' 'K' type:u8 length:u16 payload[length] crc:u32
+//
+// little endian, with the CRC-32 (as in zlib) over type, length and
+// payload. Frames that fail the check are dropped and the receiver looks
+// for the next 'P' 'K', so log text printed between frames is skipped too.
+// tools/pinky_link.py is the host side.
+constexpr uint8_t LinkVersion = 1;
+constexpr uint32_t LinkMaxPayload = 4096;
+constexpr uint32_t LinkIdleTimeoutUs = 10 * 1000 * 1000;
+constexpr uint32_t LinkByteTimeoutUs = 500 * 1000;
+
+enum class LinkFrame : uint8_t
+{
+  Hello = 0x01,         // host -> device, answered with Ack
+  Ack = 0x02,           // device -> host: version:u8 on Hello, empty otherwise
+  Error = 0x03,         // device -> host: message text
+  Upload = 0x10,        // size:u32 width:u16 height:u16 format:u8, then UploadData
+  UploadData = 0x11,    // the next piece of the upload
+  Download = 0x20,      // source:u8 (LinkDisplaySource or a gallery slot) encoding:u8
+  DownloadInfo = 0x21,  // rawSize:u32 width:u16 height:u16 layout:u8 encoding:u8
+  DownloadData = 0x22,  // the next piece of the download
+  DownloadEnd = 0x23,   // size:u32 crc:u32 over all DownloadData payloads
+  Log = 0x30,           // device -> host: dropped:u32, then entries of
+                        // timeUs:u32 message:u16 core:u8 argCount:u8 args:u32[argCount]
+  Exit = 0x7F           // host -> device, answered with Ack
+};
+
+constexpr uint8_t LinkDisplaySource = 0xFF;
+
+inline void putLE(uint8_t* dest, uint32_t value, int bytes)
+{
+  for (int i=0; i < bytes; ++i)
+  {
+    dest[i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+inline uint32_t getLE(const uint8_t* src, int bytes)
+{
+  uint32_t value = 0;
+  for (int i=0; i < bytes; ++i)
+  {
+    value |= (uint32_t)src[i] << (8 * i);
+  }
+  return value;
+}
+
+class UsbLink
+{
+public:
+  UsbLink()
+  {
+    payload_.reserve(LinkMaxPayload);
+  }
+
+  // Wait for the next good frame. False if nothing arrives in time.
+  bool receive(LinkFrame& type)
+  {
+    uint8_t header[3];
+    while (true)
+    {
+      // Hunt for the magic, allowing a long wait before a frame starts
+      int c = readByte(LinkIdleTimeoutUs);
+      if (c < 0)
+      {
+        return false;
+      }
+      if (c != 'P')
+      {
+        continue;
+      }
+      // Any 'P' in a run of them may be the one that starts the magic
+      do
+      {
+        c = readByte(LinkByteTimeoutUs);
+      } while (c == 'P');
+      if (c != 'K')
+      {
+        continue;
+      }
+      if (!readBytes(header, sizeof(header)))
+      {
+        continue;
+      }
+      uint32_t length = getLE(header + 1, 2);
+      uint8_t crcBytes[4];
+      if (length > LinkMaxPayload)
+      {
+        continue;
+      }
+      payload_.resize(length);
+      if (!readBytes(payload_.data(), length) || !readBytes(crcBytes, 4))
+      {
+        continue;
+      }
+      uint32_t crc = crc32(crc32(0, header, sizeof(header)), payload_.data(), length);
+      if (crc != getLE(crcBytes, 4))
+      {
+        ++badFrames_;
+        continue;
+      }
+      type = (LinkFrame)header[0];
+      return true;
+    }
+  }
+
+  // The payload of the frame last received
+  const std::vector<uint8_t>& payload() const
+  {
+    return payload_;
+  }
+
+  // Frames dropped for a bad checksum so far
+  uint32_t badFrames() const
+  {
+    return badFrames_;
+  }
+
+  static void send(LinkFrame type, const uint8_t* payload = nullptr, uint32_t length = 0)
+  {
+    uint8_t header[5] = {'P', 'K', (uint8_t)type};
+    putLE(header + 3, length, 2);
+    uint8_t crc[4];
+    putLE(crc, crc32(crc32(0, header + 2, 3), payload, length), 4);
+    write(header, sizeof(header));
+    write(payload, length);
+    write(crc, sizeof(crc));
+  }
+
+  static void sendError(const char* message)
+  {
+    send(LinkFrame::Error, (const uint8_t*)message, (uint32_t)strlen(message));
+  }
+
+private:
+  static int readByte(uint32_t timeoutUs)
+  {
+    return halSerialReadByte(timeoutUs);
+  }
+
+  static bool readBytes(uint8_t* dest, uint32_t count)
+  {
+    for (uint32_t i=0; i < count; ++i)
+    {
+      int c = readByte(LinkByteTimeoutUs);
+      if (c < 0)
+      {
+        return false;
+      }
+      dest[i] = (uint8_t)c;
+    }
+    return true;
+  }
+
+  static void write(const uint8_t* data, uint32_t length)
+  {
+    if (length > 0)
+    {
+      halSerialWrite(data, length);
+    }
+  }
+
+  std::vector<uint8_t> payload_;
+  uint32_t badFrames_ = 0;
+};
+
+// The data of an upload, read out of UploadData frames as they arrive, so
+// the whole file never has to be in memory. Made once the Upload request
+// itself has been received, which isn't part of the data.
+class LinkByteSource : public ByteSource
+{
+public:
+  LinkByteSource(UsbLink& link, uint32_t size)
+    : link_{link}
+    , remaining_{size}
+    , pos_{(uint32_t)link.payload().size()}
+  { }
+
+  virtual uint32_t remaining() const override
+  {
+    return remaining_;
+  }
+
+  virtual uint32_t read(uint8_t* dest, uint32_t len) override
+  {
+    uint32_t done = 0;
+    len = std::min(len, remaining_);
+    while (done < len)
+    {
+      if (pos_ == link_.payload().size() && !nextFrame())
+      {
+        break;
+      }
+      uint32_t count = std::min(len - done, (uint32_t)link_.payload().size() - pos_);
+      memcpy(dest + done, link_.payload().data() + pos_, count);
+      pos_ += count;
+      done += count;
+    }
+    remaining_ -= done;
+    return done;
+  }
+
+  // Take the rest of the upload off the link, so the next frame read is a
+  // new command
+  virtual void discard() override
+  {
+    while (remaining_ > 0)
+    {
+      uint32_t left = (uint32_t)link_.payload().size() - pos_;
+      if (left >= remaining_)
+      {
+        pos_ += remaining_;
+        remaining_ = 0;
+        break;
+      }
+      remaining_ -= left;
+      pos_ += left;
+      if (!nextFrame())
+      {
+        break;
+      }
+    }
+  }
+
+  // The upload was cut short or interrupted by another frame
+  bool failed() const
+  {
+    return failed_;
+  }
+
+private:
+  bool nextFrame()
+  {
+    LinkFrame type;
+    pos_ = 0;
+    if (!link_.receive(type) || type != LinkFrame::UploadData)
+    {
+      failed_ = true;
+      remaining_ = 0;
+      return false;
+    }
+    return true;
+  }
+
+  UsbLink& link_;
+  uint32_t remaining_;
+  uint32_t pos_;
+  bool failed_ = false;
+};
+
+// Sends whatever is written to it as DownloadData frames, keeping a
+// running CRC of it all for the DownloadEnd frame. Works as a
+// FrameEncoder sink.
+class LinkDownloadSink
+{
+public:
+  LinkDownloadSink(UsbLink& link)
+    : link_{link}
+  {
+    chunk_.reserve(LinkMaxPayload);
+  }
+
+  bool write(const uint8_t* data, uint32_t size)
+  {
+    while (size > 0)
+    {
+      uint32_t count = std::min(size, LinkMaxPayload - (uint32_t)chunk_.size());
+      if (count == LinkMaxPayload)
+      {
+        // A whole frame's worth, straight from where it is
+        send(data, count);
+      }
+      else
+      {
+        chunk_.insert(chunk_.end(), data, data + count);
+        if (chunk_.size() == LinkMaxPayload)
+        {
+          flush();
+        }
+      }
+      data += count;
+      size -= count;
+    }
+    return true;
+  }
+
+  // Send anything still buffered, then DownloadEnd
+  void finish()
+  {
+    flush();
+    uint8_t end[8];
+    putLE(end, size_, 4);
+    putLE(end + 4, crc_, 4);
+    link_.send(LinkFrame::DownloadEnd, end, sizeof(end));
+  }
+
+private:
+  void flush()
+  {
+    if (!chunk_.empty())
+    {
+      send(chunk_.data(), (uint32_t)chunk_.size());
+      chunk_.clear();
+    }
+  }
+
+  void send(const uint8_t* data, uint32_t size)
+  {
+    link_.send(LinkFrame::DownloadData, data, size);
+    crc_ = crc32(crc_, data, size);
+    size_ += size;
+  }
+
+  UsbLink& link_;
+  std::vector<uint8_t> chunk_;
+  uint32_t size_ = 0;
+  uint32_t crc_ = 0;
+};
+
+// Send up to max of the deferred log's oldest entries as one Log frame,
+// outside link mode too (tools/pinky_log.py picks the frames out of the
+// text around them). Returns how many went.
+inline uint32_t sendLogFrame(uint32_t max)
+{
+  constexpr uint32_t EntryBytes = 8 + 4 * LogMaxArgs;
+  uint8_t payload[4 + 16 * EntryBytes];
+  uint32_t length = 4;
+  putLE(payload, DeferredLog::dropped(), 4);
+  uint32_t count = DeferredLog::drain([&](const LogEntry& entry)
+  {
+    uint8_t* dest = payload + length;
+    putLE(dest, entry.timeUs, 4);
+    putLE(dest + 4, (uint16_t)entry.message, 2);
+    dest[6] = entry.core;
+    dest[7] = entry.argCount;
+    for (int i=0; i < entry.argCount; ++i)
+    {
+      putLE(dest + 8 + 4 * i, entry.args[i], 4);
+    }
+    length += 8 + 4 * entry.argCount;
+  }, std::min(max, (uint32_t)((sizeof(payload) - 4) / EntryBytes)));
+  if (count > 0)
+  {
+    UsbLink::send(LinkFrame::Log, payload, length);
+  }
+  return count;
+}
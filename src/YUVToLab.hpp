@@ -0,0 +1,111 @@
+#pragma once
+
+#include "LabKernels.hpp"
+#include "Stats.hpp"
+
+#include <cpp/Color.hpp>
+
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// Lookup tables for converting full range (JFIF) YUV and 8 bit RGB straight
+// to Lab, without going through RGBColor::toLab().
+//
+//   1. Chroma contributions to R'G'B' are separable, so each is a table
+//      lookup added to Y.
+//   2. Each clamped R', G' and B' maps to its (linearized) contribution to
+//      X, Y and Z, already divided by the D65 white point (LabTables).
+//   3. The Lab companding function is a cube root LUT with interpolation,
+//      done a row at a time by the widest LabKernels available.
+class YUVToLabTable
+{
+public:
+  // Rows are converted in runs of this many pixels
+  static constexpr int RowChunk = 32;
+
+  static const YUVToLabTable& instance()
+  {
+    static YUVToLabTable table;
+    return table;
+  }
+
+  LabColor toLab(uint8_t y, uint8_t u, uint8_t v) const
+  {
+    int r, g, b;
+    toRGB(y, u, v, r, g, b);
+    float x, yy, z;
+    lab_.xyz(r, g, b, x, yy, z);
+    return lab_.toLab(x, yy, z);
+  }
+
+  LabColor toLab(const RGBColor& rgb) const
+  {
+    float x, y, z;
+    lab_.xyz(rgb.R, rgb.G, rgb.B, x, y, z);
+    return lab_.toLab(x, y, z);
+  }
+
+  // Rows of count pixels. Identical results to converting one at a time.
+  void toLab(const uint8_t* y, const uint8_t* u, const uint8_t* v, LabColor* out, int count) const
+  {
+    Stats::add(StatCounter::LabConversions, count);
+    float xs[RowChunk], ys[RowChunk], zs[RowChunk];
+    for (int i0=0; i0 < count; i0 += RowChunk)
+    {
+      int n = std::min(RowChunk, count - i0);
+      for (int i=0; i < n; ++i)
+      {
+        int r, g, b;
+        toRGB(y[i0+i], u[i0+i], v[i0+i], r, g, b);
+        lab_.xyz(r, g, b, xs[i], ys[i], zs[i]);
+      }
+      labKernels().xyzToLab(xs, ys, zs, out + i0, n);
+    }
+  }
+
+  void toLab(const RGBColor* rgb, LabColor* out, int count) const
+  {
+    Stats::add(StatCounter::LabConversions, count);
+    float xs[RowChunk], ys[RowChunk], zs[RowChunk];
+    for (int i0=0; i0 < count; i0 += RowChunk)
+    {
+      int n = std::min(RowChunk, count - i0);
+      for (int i=0; i < n; ++i)
+      {
+        const RGBColor& c = rgb[i0+i];
+        lab_.xyz(c.R, c.G, c.B, xs[i], ys[i], zs[i]);
+      }
+      labKernels().xyzToLab(xs, ys, zs, out + i0, n);
+    }
+  }
+
+private:
+  YUVToLabTable() :
+    lab_{LabTables::instance()}
+  {
+    for (int i=0; i < 256; ++i)
+    {
+      float c = (float)(i - 128);
+      rFromV_[i] = (int)std::lround(1.402f * c);
+      gFromU_[i] = (int)std::lround(-0.344136f * c);
+      gFromV_[i] = (int)std::lround(-0.714136f * c);
+      bFromU_[i] = (int)std::lround(1.772f * c);
+    }
+  }
+
+  void toRGB(uint8_t y, uint8_t u, uint8_t v, int& r, int& g, int& b) const
+  {
+    r = std::clamp((int)y + rFromV_[v], 0, 255);
+    g = std::clamp((int)y + gFromU_[u] + gFromV_[v], 0, 255);
+    b = std::clamp((int)y + bFromU_[u], 0, 255);
+  }
+
+  const LabTables& lab_;
+
+  std::array<int, 256> rFromV_;
+  std::array<int, 256> gFromU_;
+  std::array<int, 256> gFromV_;
+  std::array<int, 256> bFromU_;
+};
@@ -0,0 +1,7 @@
+// A second, independent copy of picojpeg for the restart-interval parallel
+// JPEG decoder (see JpegParallel.hpp). picojpeg keeps all of its state in
+// file statics, so compiling it again with renamed entry points gives a
+// decoder that can run on core1 while the original runs on core0.
+#define pjpeg_decode_init pjpeg_core1_decode_init
+#define pjpeg_decode_mcu pjpeg_core1_decode_mcu
+#include "picojpeg.c"
@@ -3,6 +3,17 @@
 #include "ImageEffect.hpp"
 #include "ColorMapEffect.hpp"
 #include "ArducamUtil.hpp"
+#include "Bench.hpp"
+#include "DeferredLog.hpp"
+#include "FlashStore.hpp"
+#include "FrameCodec.hpp"
+#include "ImageDecode.hpp"
+#include "MemWatch.hpp"
+#include "PhotoPipeline.hpp"
+#include "Scheduler.hpp"
+#include "Stats.hpp"
+#include "Trace.hpp"
+#include "UsbLink.hpp"
 
 #include <cpp/Button.hpp>
 #include <cpp/LedStripWs2812b.hpp>
@@ -22,9 +33,80 @@
 #include <magic_enum/magic_enum.hpp>
 
 
+// operator new and delete, linked wrapped (see CMakeLists.txt) so MemWatch
+// can count allocations. Everything goes to the plain new and delete,
+// which the array and sized forms only forward to anyway.
+extern "C"
+{
+  void* __real__Znwj(size_t size);
+  void __real__ZdlPv(void* ptr);
+
+  void* __wrap__Znwj(size_t size)
+  {
+    void* ptr = __real__Znwj(size);
+    MemWatch::noteAlloc(size, __builtin_return_address(0));
+    return ptr;
+  }
+
+  void* __wrap__Znaj(size_t size)
+  {
+    void* ptr = __real__Znwj(size);
+    MemWatch::noteAlloc(size, __builtin_return_address(0));
+    return ptr;
+  }
+
+  void __wrap__ZdlPv(void* ptr)
+  {
+    if (ptr)
+    {
+      MemWatch::noteFree();
+    }
+    __real__ZdlPv(ptr);
+  }
+
+  void __wrap__ZdaPv(void* ptr)
+  {
+    __wrap__ZdlPv(ptr);
+  }
+
+  void __wrap__ZdlPvj(void* ptr, size_t /*size*/)
+  {
+    __wrap__ZdlPv(ptr);
+  }
+
+  void __wrap__ZdaPvj(void* ptr, size_t /*size*/)
+  {
+    __wrap__ZdlPv(ptr);
+  }
+}
+
+// Reports heap and stack high-water marks after each command (MemWatch.hpp)
+class WatchedCommandParser : public CommandParser
+{
+public:
+  template <typename F>
+  void addCommand(const char* name, const char* args, const char* help, F f)
+  {
+    CommandParser::addCommand(name, args, help, watched(name, f, &F::operator()));
+  }
+
+private:
+  template <typename F, typename R, typename... Args>
+  static auto watched(const char* name, F f, R (F::*)(Args...) const)
+  {
+    return [name, f](Args... args) -> R
+    {
+      MemWatchScope watch(name);
+      return f(args...);
+    };
+  }
+};
+
 void rebootIntoProgMode()
 {
-  //multicore_reset_core1();
+#ifdef ENABLE_PICO_MULTICORE
+  multicore_reset_core1();
+#endif
   reset_usb_boot(0,0);
 }
 
@@ -41,7 +123,7 @@ int main()
   shutterButton.holdActivationRepeatMs(-1); // Don't send more than one held event ever
 
   std::unique_ptr<Inky> inky = InkyCreate();
-  std::shared_ptr<IndexedColorMap> specialColorMap;
+  ColorMapEffect currentEffect = ColorMapEffect::None;
 
   LedStripWs2812b leds(16);
   LEDBuffer buf(6);
@@ -80,19 +162,56 @@ int main()
   cam.setAutoISOSensitive(0);
   cam.setAutoWhiteBalance(0);
   bool ledStateDirty = true;
-  float ditherAccuracy = 0.95f;
-  bool yuvDownsample = true;
+  int lastSpooledSlot = -1;
+  // Where a spooled snap reads its capture back from
+  MemoryByteSource spooledCapture(nullptr, 0);
   const ArducamResolution* camRes = pickCameraResolution(inky->eeprom().width, inky->eeprom().height);
   int camFormat = (int)CAM_IMAGE_PIX_FMT_YUV;
   snapAndFlushCamera(cam, camRes, (CAM_IMAGE_PIX_FMT)camFormat);
+  ArducamMegaCamera camera(cam, camRes);
 
-  CommandParser parser;
+  std::unique_ptr<PhotoPipeline> pipeline;
+  if (inky)
+  {
+    pipeline = std::make_unique<PhotoPipeline>(*inky, showProgressOnLeds);
+  }
+
+  WatchedCommandParser parser;
 
   parser.addCommand("mem", "", "Show memory usage stats",[&]()
   {
       std::cout << "Memory Usage: " << getUsedHeap() << " / " << getTotalHeap() << std::endl;
   });
 
+  parser.addProperty("memwatch", MemWatch::enabled, false, "Report heap and stack high-water marks after each command");
+
+  parser.addProperty("tracing", Trace::enabled, false, "Record timing spans for the trace command");
+
+  bool logBinary = false;
+  parser.addProperty("logbinary", logBinary, false, "Send deferred log messages as link Log frames for tools/pinky_log.py");
+
+  parser.addCommand("trace", "", "Dump the recorded timing spans (tools/trace2chrome.py reads them) and start over",[&]()
+  {
+    printTrace(std::cout);
+    Trace::clear();
+  });
+
+  parser.addCommand("stats", "", "Show camera, decode, dither and SPI throughput for the last few snaps",[&]()
+  {
+    printSnapStats(std::cout);
+  });
+
+  parser.addCommand("sched", "", "Show the main loop's tasks and the longest a command went without yielding",[&]()
+  {
+    Scheduler::forEach([](const SchedulerTask& task)
+    {
+      std::cout << task.name << ": every " << task.periodUs / 1000 << " ms" << (task.when == TaskWhen::Always ? " (also in commands)" : "")
+                << ", " << task.runs << " runs, longest " << task.longestRunUs << " us" << std::endl;
+    });
+    std::cout << "Longest gap between yields: " << Scheduler::longestGapUs() << " us" << std::endl;
+    Scheduler::resetLongestGap();
+  });
+
   parser.addCommand("prog", "", "Reboot into programming mode",[&]()
   {
     // Reboot into programming mode
@@ -111,9 +230,9 @@ int main()
 
   if (inky)
   {
-    parser.addProperty("dither", ditherAccuracy, false, "0.0 - 1.0 (default 0.75)");
+    parser.addProperty("dither", pipeline->ditherAccuracy, false, "0.0 - 1.0 (default 0.75)");
 
-    parser.addProperty("yuvDownsample", yuvDownsample, false, "Cut YUV image res in half");
+    parser.addProperty("yuvDownsample", pipeline->yuvDownsample, false, "Cut YUV image res in half");
 
     parser.addCommand("format", "[enum]", "JPG=1, RGB565=2, YUV=3", [&](int format){
       camFormat = format;
@@ -122,6 +241,7 @@ int main()
 
     parser.addCommand("mode", "[enum]", "4=320x320, 5=640x480, 12=2048x1536", [&](int mode){
       camRes = pickCameraResolution((CAM_IMAGE_MODE)mode);
+      camera.setResolution(camRes);
       snapAndFlushCamera(cam, camRes, (CAM_IMAGE_PIX_FMT)camFormat);
     });
 
@@ -177,88 +297,558 @@ int main()
       std::cout << "    Write Time: " << inky->eeprom().writeTime << std::endl;
     });
 
-    parser.addCommand("effect", "[val]", "", [&](std::string name) {
-
-      std::optional<ColorMapEffect> effect;
-      specialColorMap.reset();
-
-      if (!effect)
-      {
-        effect = magic_enum::enum_cast<ColorMapEffect>(name, magic_enum::case_insensitive);
-      }
+    // An effect by name or number
+    auto parseEffect = [](const std::string& name)
+    {
+      std::optional<ColorMapEffect> effect = magic_enum::enum_cast<ColorMapEffect>(name, magic_enum::case_insensitive);
 
       if (!effect)
       {
         effect = magic_enum::enum_cast<ColorMapEffect>(atoi(name.c_str()));
       }
+      return effect;
+    };
+
+    parser.addCommand("effect", "[val]", "", [&, parseEffect](std::string name) {
+
+      pipeline->specialColorMap.reset();
+      std::optional<ColorMapEffect> effect = parseEffect(name);
+      currentEffect = effect.value_or(ColorMapEffect::None);
 
       if (effect)
       {
-        specialColorMap = getColorMapWithEffect(inky->colorMap(), effect.value());
+        pipeline->specialColorMap = getColorMapWithEffect(inky->colorMap(), effect.value());
       }
       
-      if (specialColorMap)
+      if (pipeline->specialColorMap)
         std::cout << "Set custom effect" << std::endl;
       else
         std::cout << "Cleared custom effect" << std::endl;
     });
 
+    // Commands run after this block is gone, so they take the helper
+    // lambdas declared in it by copy
+    auto renderSpooled = [&](int slot)
+    {
+      const FlashSpoolHeader* header = FlashSpool::header(slot);
+      if (!header)
+      {
+        std::cout << "Nothing spooled in slot " << slot << std::endl;
+        return false;
+      }
+      MemoryByteSource src = FlashSpool::source(slot);
+      bool ok = pipeline->renderImage(src, (CaptureFormat)header->format, header->width, header->height);
+      lastSpooledSlot = ok ? slot : -1;
+      return ok;
+    };
+
+    // Copy the current capture out of the camera into a spool slot
+    auto spoolCapture = [&](Camera& source, int slot)
+    {
+      ByteSource& camSource = source.picture();
+      auto startTime = to_ms_since_boot(get_absolute_time());
+      uint32_t size = camSource.remaining();
+      bool spooled = FlashSpool::spool(slot, camSource, source.width(), source.height(), (uint8_t)source.format());
+      camSource.discard();
+      if (spooled)
+      {
+        PINKY_LOG(Spooled, size, slot, to_ms_since_boot(get_absolute_time()) - startTime);
+      }
+      return spooled;
+    };
+
+    // Snaps spool to flash through this while spool is on. The camera is
+    // free for the next shot as soon as it returns.
+    pipeline->spooler = [spoolCapture, &lastSpooledSlot, &spooledCapture](Camera& source) -> ByteSource*
+    {
+      int slot = FlashSpool::nextSlot();
+      if (!spoolCapture(source, slot))
+      {
+        return nullptr;
+      }
+      lastSpooledSlot = slot;
+      spooledCapture = FlashSpool::source(slot);
+      return &spooledCapture;
+    };
+
+    parser.addProperty("spool", pipeline->spoolCaptures, false, "Copy captures to flash before decoding");
+
     parser.addCommand("snap", "", "Snap a photo and display it.", [&]()
     {
-      CAM_IMAGE_PIX_FMT format = (CAM_IMAGE_PIX_FMT)camFormat;
-      DEBUG_LOG("Taking photo...");
-      showProgressOnLeds(1.0f, {255,0,0});
+      // The spooler records the slot of a spooled snap, for rerender
+      lastSpooledSlot = -1;
+      bool ok = pipeline->snap(camera, (CaptureFormat)camFormat);
+      if (!ok)
+      {
+        lastSpooledSlot = -1;
+      }
+      return ok;
+    });
 
-      auto status = cam.takePicture(camRes->mode, format);
-      DEBUG_LOG_IF(status != CamStatus::CAM_ERR_SUCCESS, "arducam takePicture returned error: " << (int)status);
-      DEBUG_LOG("Fetching photo...");
-      
-      // Clear the display
-      inky->clear();
+    parser.addCommand("rerender", "", "Redisplay the last photo with the current effect and dither", [&, renderSpooled]()
+    {
+      // A source kept for a monochrome map has no color left in it, so
+      // prefer the spooled capture when there is one
+      SourceImageCache& sourceCache = pipeline->sourceCache;
+      bool needsChroma = !pipeline->colorMap().isMonochrome() && !sourceCache.hasChroma();
+      if (sourceCache.valid() && (!needsChroma || lastSpooledSlot < 0))
+      {
+        DEBUG_LOG_IF(needsChroma, "Source image was kept without color");
+        return pipeline->ditherAndShow([&](auto& buffer, ProgressUpdateCallback& progressCb)
+        {
+          return sourceCache.replay(buffer, progressCb);
+        });
+      }
+      if (lastSpooledSlot >= 0)
+      {
+        // Too big to keep in RAM, decode the spooled capture again instead
+        return renderSpooled(lastSpooledSlot);
+      }
+      std::cout << "Nothing to rerender. Photos too big to keep in RAM need spool turned on." << std::endl;
+      return false;
+    });
+
+    parser.addCommand("burst", "[count]", "Snap photos into the flash spool without decoding them", [&, spoolCapture](int count)
+    {
+      count = std::clamp(count, 1, FlashSpoolSlots);
+      for (int shot = 0; shot < count; ++shot)
+      {
+        // Oldest first, so the newest captures are the last to go. The slot
+        // is erased before the shot, so the capture isn't left waiting in
+        // the camera meanwhile.
+        while (!FlashSpool::prepareNext())
+        {
+        }
+        int slot = FlashSpool::nextSlot();
+        if (slot == lastSpooledSlot)
+        {
+          // rerender mustn't pick up a different photo from it
+          lastSpooledSlot = -1;
+        }
+        showProgressOnLeds((float)(shot + 1) / (float)count, {255,0,0});
+        if (!camera.takePicture((CaptureFormat)camFormat) || !spoolCapture(camera, slot))
+        {
+          return false;
+        }
+      }
+      return true;
+    });
+
+    parser.addCommand("decode", "[slot]", "Display a spooled photo", [&, renderSpooled](int slot)
+    {
+      return renderSpooled(slot);
+    });
+
+    parser.addCommand("spooled", "", "List the spooled photos", [&]()
+    {
+      for (int slot = 0; slot < FlashSpoolSlots; ++slot)
+      {
+        const FlashSpoolHeader* header = FlashSpool::header(slot);
+        std::cout << "Slot " << slot << ": ";
+        if (header)
+        {
+          std::cout << header->width << "x" << header->height << " " << magic_enum::enum_name((CAM_IMAGE_PIX_FMT)header->format)
+                    << ", " << header->size << " bytes, #" << header->sequence << std::endl;
+        }
+        else
+        {
+          std::cout << "empty" << std::endl;
+        }
+      }
+    });
+
+    // Show a gallery frame. Frames already in the panel's layout go
+    // straight out of flash (decompressed on the way if they need to be).
+    // Packed4Bit frames for a two plane panel get unpacked into the display
+    // buffer first.
+    auto showFrame = [&](int slot)
+    {
+      const FlashFrameHeader* header = FlashGallery::header(slot);
+      auto& display = inky->bufferIndexed();
+      if (!header || header->width != display.width || header->height != display.height)
+      {
+        std::cout << "No frame for this display in slot " << slot << std::endl;
+        return false;
+      }
+
+      uint32_t nativeSize = 0;
+      for (const FramePlane& plane : inky->framePlanes())
+      {
+        nativeSize += plane.size;
+      }
+
+      auto startTime = to_ms_since_boot(get_absolute_time());
+      bool native = (FrameLayout)header->layout == inky->frameLayout();
+      MemoryByteSource stored(FlashGallery::data(slot), header->size);
+      if (native && (FrameEncoding)header->encoding == FrameEncoding::Compressed)
+      {
+        FrameDecodeSource decoded(stored);
+        native = decoded.remaining() == nativeSize;
+        if (native)
+        {
+          inky->show(decoded);
+        }
+      }
+      else if (native && header->size == nativeSize)
+      {
+        inky->show(stored.data());
+      }
+      else
+      {
+        native = false;
+      }
+
+      if (!native)
+      {
+        if (!FlashGallery::load(slot, display))
+        {
+          std::cout << "Frame in slot " << slot << " can't be shown on this display" << std::endl;
+          return false;
+        }
+        inky->show();
+      }
+      DEBUG_LOG("Showed frame " << slot << " (" << magic_enum::enum_name((ColorMapEffect)header->effect) << ") in "
+                << (to_ms_since_boot(get_absolute_time()) - startTime) << " ms");
+      return true;
+    };
 
-      showProgressOnLeds(1.0f, {0,255,0});
-      ProgressUpdateCallback progressCb = [&](float progress)
+    parser.addCommand("variants", "[effects]", "Snap a photo and render it once per comma separated effect, into the oldest gallery slots", [&, parseEffect, spoolCapture, showFrame](std::string names)
+    {
+      std::vector<ColorMapEffect> effects;
+      for (size_t begin = 0; begin <= names.size();)
       {
-        if (progress > 0.17f)
+        size_t end = std::min(names.find(',', begin), names.size());
+        std::optional<ColorMapEffect> effect = parseEffect(names.substr(begin, end - begin));
+        if (!effect)
         {
-          showProgressOnLeds(progress, {0,128,255});
+          std::cout << "Unknown effect " << names.substr(begin, end - begin) << std::endl;
+          return false;
         }
+        effects.push_back(effect.value());
+        begin = end + 1;
+      }
+      if (effects.size() > (size_t)FlashFrameSlots)
+      {
+        std::cout << "At most " << FlashFrameSlots << " variants" << std::endl;
+        return false;
+      }
+
+      auto& display = inky->bufferIndexed();
+      inky->clear();
+      IndexedColor background = display.getPixel(0, 0);
+
+      if (!pipeline->takePicture(camera, (CaptureFormat)camFormat))
+      {
+        return false;
+      }
+
+      int spoolSlot = pipeline->spoolCaptures ? FlashSpool::nextSlot() : -1;
+      if (spoolSlot >= 0 && !spoolCapture(camera, spoolSlot))
+      {
+        return false;
+      }
+
+      // Every variant gets its own color map, dither state and flash frame,
+      // all fed from the one decode. Frames go to the slots saved longest
+      // ago, like save, so they don't overwrite what was saved since.
+      struct Variant
+      {
+        std::shared_ptr<IndexedColorMap> effectMap;
+        std::unique_ptr<FlashFrameView> frame;
+        std::unique_ptr<LabInputDitherView> dither;
+      };
+      std::vector<Variant> variants(effects.size());
+      std::vector<int> slots = FlashGallery::oldestSlots((int)effects.size());
+      FanOutView<LabColor> fanOut(display.width, display.height, time_us_64);
+      for (size_t i = 0; i < effects.size(); ++i)
+      {
+        Variant& variant = variants[i];
+        int heapBefore = getUsedHeap();
+        variant.effectMap = getColorMapWithEffect(inky->colorMap(), effects[i]);
+        const IndexedColorMap& colorMap = variant.effectMap ? *variant.effectMap : inky->colorMap();
+        variant.frame = std::make_unique<FlashFrameView>(slots[i], display.width, display.height, background, (uint8_t)effects[i]);
+        variant.dither = std::make_unique<LabInputDitherView>(*variant.frame, colorMap);
+        variant.dither->ditherAccuracy = pipeline->ditherAccuracy;
+        fanOut.add(*variant.dither);
+        DEBUG_LOG("Variant " << i << " " << magic_enum::enum_name(effects[i]) << " uses " << (getUsedHeap() - heapBefore) << " bytes");
+      }
+
+      auto showProgress = [&](float progress)
+      {
+        showProgressOnLeds(progress, {0,128,255});
       };
+      ProgressUpdateCallback progressCb = showProgress;
+
+      auto startTime = time_us_64();
+      bool ok;
+      if (spoolSlot >= 0)
+      {
+        MemoryByteSource src = FlashSpool::source(spoolSlot);
+        ok = pipeline->decodeImage(fanOut, src, camera.format(), camera.width(), camera.height(), progressCb, DecodeMode::SingleCore);
+      }
+      else
+      {
+        ByteSource& camSource = camera.picture();
+        ok = pipeline->decodeImage(fanOut, camSource, camera.format(), camera.width(), camera.height(), progressCb, DecodeMode::SingleCore);
+        camSource.discard();
+      }
+      for (Variant& variant : variants)
+      {
+        ok = variant.frame->finish() && ok;
+      }
+      auto elapsedMs = (time_us_64() - startTime) / 1000;
+
+      // Rerender goes back to the photo, there's no source kept for it
+      pipeline->sourceCache.clear();
+      lastSpooledSlot = spoolSlot;
+      if (!ok)
+      {
+        return false;
+      }
+
+      DEBUG_LOG("Decoded once into " << variants.size() << " variants in " << elapsedMs << " ms");
+      for (int i = 0; i < fanOut.outputCount(); ++i)
+      {
+        DEBUG_LOG("  Variant " << i << " dithered in " << fanOut.busyTime(i) / 1000 << " ms");
+      }
+      for (size_t i = 0; i < variants.size(); ++i)
+      {
+        std::cout << "Variant " << magic_enum::enum_name(effects[i]) << " saved to slot " << slots[i] << std::endl;
+      }
+      return showFrame(slots[0]);
+    });
+
+    parser.addCommand("save", "", "Keep the display buffer in the flash gallery", [&]()
+    {
+      auto& display = inky->bufferIndexed();
+      int slot = FlashGallery::oldestSlot();
+      if (!FlashGallery::save(slot, inky->framePlanes(), display.width, display.height, inky->frameLayout(), (uint8_t)currentEffect))
+      {
+        return false;
+      }
+      std::cout << "Saved to slot " << slot << std::endl;
+      return true;
+    });
+
+    parser.addCommand("recall", "[slot]", "Display a frame from the flash gallery", [&, showFrame](int slot)
+    {
+      return showFrame(slot);
+    });
+
+    parser.addCommand("gallery", "", "List the frames in the flash gallery", [&]()
+    {
+      for (int slot = 0; slot < FlashFrameSlots; ++slot)
+      {
+        const FlashFrameHeader* header = FlashGallery::header(slot);
+        std::cout << "Slot " << slot << ": ";
+        if (header)
+        {
+          std::cout << header->width << "x" << header->height << " " << magic_enum::enum_name((FrameLayout)header->layout)
+                    << " " << magic_enum::enum_name((ColorMapEffect)header->effect) << ", " << header->size << " bytes "
+                    << magic_enum::enum_name((FrameEncoding)header->encoding) << ", #" << header->sequence << std::endl;
+        }
+        else
+        {
+          std::cout << "empty" << std::endl;
+        }
+      }
+    });
+
+    parser.addCommand("codec", "[slot]", "Measure frame compression on the display buffer, and decompression of a gallery frame", [&](int slot)
+    {
+      // Compress what's on the display now, counting the output only
+      uint32_t size = 0;
+      uint32_t compressedSize = 0;
+      uint64_t startTime = time_us_64();
+      {
+        auto& display = inky->bufferIndexed();
+        CountingSink sink;
+        std::vector<FramePlane> planes = inky->framePlanes();
+        for (const FramePlane& plane : planes)
+        {
+          size += plane.size;
+        }
+        FrameEncoder<CountingSink> encoder(sink, size, FlashGallery::stride(inky->frameLayout(), display.width));
+        for (const FramePlane& plane : planes)
+        {
+          encoder.write(plane.data, plane.size);
+        }
+        encoder.finish();
+        compressedSize = sink.count;
+      }
+      uint64_t encodeUs = std::max<uint64_t>(time_us_64() - startTime, 1);
+      std::cout << "Display buffer: " << size << " -> " << compressedSize << " bytes, ratio "
+                << (float)size / (float)compressedSize << ", encode " << (float)size / (float)encodeUs << " MB/s" << std::endl;
 
-      LabDitherView buffer(inky->bufferIndexed(), specialColorMap ? *specialColorMap : inky->colorMap());
-      buffer.ditherAccuracy = ditherAccuracy;
-      AlignCenterView centeredBuffer(buffer, camRes->width, camRes->height);
+      const FlashFrameHeader* header = FlashGallery::header(slot);
+      if (!header || (FrameEncoding)header->encoding != FrameEncoding::Compressed)
+      {
+        std::cout << "No compressed frame in slot " << slot << std::endl;
+        return false;
+      }
+
+      // Decode out of flash into a chunk at a time, as the panel upload does
+      std::vector<uint8_t> chunk(1024);
+      MemoryByteSource stored(FlashGallery::data(slot), header->size);
+      startTime = time_us_64();
+      FrameDecodeSource decoded(stored);
+      uint32_t decodedSize = decoded.remaining();
+      uint32_t count = 0;
+      for (uint32_t read = 1; read > 0; count += read)
+      {
+        read = decoded.read(chunk.data(), chunk.size());
+      }
+      uint64_t decodeUs = std::max<uint64_t>(time_us_64() - startTime, 1);
+      if (count != decodedSize)
+      {
+        std::cout << "Frame in slot " << slot << " is corrupt" << std::endl;
+        return false;
+      }
+      std::cout << "Slot " << slot << ": " << header->size << " -> " << decodedSize << " bytes, ratio "
+                << (float)decodedSize / (float)header->size << ", decode " << (float)decodedSize / (float)decodeUs << " MB/s" << std::endl;
+      return true;
+    });
+
+    // Render an image streamed in over the link, without ever holding all
+    // of it
+    auto linkUpload = [&](UsbLink& link)
+    {
+      const std::vector<uint8_t>& request = link.payload();
+      if (request.size() < 9)
+      {
+        link.sendError("Bad upload request");
+        return;
+      }
+      uint32_t size = getLE(&request[0], 4);
+      int width = (int)getLE(&request[4], 2);
+      int height = (int)getLE(&request[6], 2);
+      CaptureFormat format = (CaptureFormat)request[8];
+      // Logged for after the link exits, text mustn't land in the stream
+      PINKY_LOG(LinkReceiving, size, width, height);
 
-      bool decodeOk = false;
       auto startTime = to_ms_since_boot(get_absolute_time());
-      if (format == CAM_IMAGE_PIX_FMT_RGB565)
+      LinkByteSource src(link, size);
+      bool ok = pipeline->renderImage(src, format, width, height, DecodeMode::Streaming);
+      src.discard();
+      lastSpooledSlot = -1;
+      if (ok)
       {
-        decodeOk = decodeImageRGB565(camRes->width, camRes->height, cam, centeredBuffer, progressCb);
+        PINKY_LOG(UploadRendered, to_ms_since_boot(get_absolute_time()) - startTime);
       }
-      else if (format == CAM_IMAGE_PIX_FMT_YUV && !yuvDownsample)
+      if (src.failed())
       {
-        decodeOk = decodeImageYUYV(camRes->width, camRes->height, cam, centeredBuffer, progressCb);
+        link.sendError("Upload cut short");
       }
-      else if (format == CAM_IMAGE_PIX_FMT_YUV && yuvDownsample)
+      else if (!ok)
       {
-        AlignCenterView centeredBuffer(buffer, camRes->width/2, camRes->height/2);
-        decodeOk = decodeImageYUYVHalf(camRes->width, camRes->height, cam, centeredBuffer, progressCb);
+        link.sendError("Decode failed");
       }
-      else if (format == CAM_IMAGE_PIX_FMT_JPG)
+      else
       {
-        decodeOk = decodeImageJPG(camRes->width, camRes->height, cam, centeredBuffer, progressCb);
+        link.send(LinkFrame::Ack);
       }
+    };
 
-      flushCamera(cam);
+    // Send the display buffer, or a gallery frame as it's stored
+    auto linkDownload = [&](UsbLink& link)
+    {
+      const std::vector<uint8_t>& request = link.payload();
+      if (request.size() < 2 || request[1] > (uint8_t)FrameEncoding::Compressed)
+      {
+        link.sendError("Bad download request");
+        return;
+      }
+      int source = request[0];
+      FrameEncoding encoding = (FrameEncoding)request[1];
 
-      if (decodeOk)
+      uint8_t info[10];
+      LinkDownloadSink sink(link);
+      if (source == LinkDisplaySource)
       {
-        auto elapsedTimeMs = to_ms_since_boot(get_absolute_time()) - startTime;
-        DEBUG_LOG("Picture converted in " << elapsedTimeMs << " ms");
-        inky->show();
+        auto& display = inky->bufferIndexed();
+        std::vector<FramePlane> planes = inky->framePlanes();
+        uint32_t size = 0;
+        for (const FramePlane& plane : planes)
+        {
+          size += plane.size;
+        }
+        putLE(info, size, 4);
+        putLE(info + 4, display.width, 2);
+        putLE(info + 6, display.height, 2);
+        info[8] = (uint8_t)inky->frameLayout();
+        info[9] = (uint8_t)encoding;
+        link.send(LinkFrame::DownloadInfo, info, sizeof(info));
+
+        if (encoding == FrameEncoding::Compressed)
+        {
+          FrameEncoder<LinkDownloadSink> encoder(sink, size, FlashGallery::stride(inky->frameLayout(), display.width));
+          for (const FramePlane& plane : planes)
+          {
+            encoder.write(plane.data, plane.size);
+          }
+          encoder.finish();
+        }
+        else
+        {
+          for (const FramePlane& plane : planes)
+          {
+            sink.write(plane.data, plane.size);
+          }
+        }
       }
+      else
+      {
+        const FlashFrameHeader* header = FlashGallery::header(source);
+        if (!header)
+        {
+          link.sendError("Nothing in that gallery slot");
+          return;
+        }
+        const uint8_t* data = FlashGallery::data(source);
+        bool compressed = (FrameEncoding)header->encoding == FrameEncoding::Compressed;
+        putLE(info, compressed ? getLE(data, 4) : header->size, 4);
+        putLE(info + 4, header->width, 2);
+        putLE(info + 6, header->height, 2);
+        info[8] = header->layout;
+        info[9] = header->encoding;
+        link.send(LinkFrame::DownloadInfo, info, sizeof(info));
+        sink.write(data, header->size);
+      }
+      sink.finish();
+    };
 
-      return decodeOk;
+    parser.addCommand("link", "", "Switch to the binary protocol of tools/pinky_link.py until it exits", [&, linkUpload, linkDownload]()
+    {
+      UsbLink link;
+      link.send(LinkFrame::Ack, &LinkVersion, 1);
+      LinkFrame type;
+      while (link.receive(type))
+      {
+        switch (type)
+        {
+          case LinkFrame::Hello:
+            link.send(LinkFrame::Ack, &LinkVersion, 1);
+            break;
+          case LinkFrame::Upload:
+            linkUpload(link);
+            break;
+          case LinkFrame::Download:
+            linkDownload(link);
+            break;
+          case LinkFrame::Exit:
+            link.send(LinkFrame::Ack);
+            if (link.badFrames() > 0)
+            {
+              PINKY_LOG(LinkDroppedFrames, link.badFrames());
+            }
+            return true;
+          default:
+            link.sendError("Unexpected frame");
+            break;
+        }
+      }
+      DEBUG_LOG("Link went quiet, back to text commands");
+      return false;
     });
 
     parser.addCommand("bars", "", "Show a color test pattern",[&]()
@@ -280,8 +870,8 @@ int main()
     parser.addCommand("gradient", "", "Show a color test pattern",[&]()
     {
       // Color bar pattern, written directly in indexed colors
-      LabDitherView buffer(inky->bufferIndexed(), specialColorMap ? *specialColorMap : inky->colorMap());
-      buffer.ditherAccuracy = ditherAccuracy;
+      LabDitherView buffer(inky->bufferIndexed(), pipeline->colorMap());
+      buffer.ditherAccuracy = pipeline->ditherAccuracy;
 
       for (int y = 0; y < buffer.height; ++y)
       {
@@ -300,6 +890,12 @@ int main()
       inky->show();
     });
 
+    parser.addCommand("bench", "[stages]", "Time each pipeline stage on built in pictures, without a refresh: all, or a prefix like decode or dither/lab", [&](std::string stages)
+    {
+      Bench bench(*inky, *pipeline, std::cout);
+      return bench.run(stages);
+    });
+
     parser.addCommand("clear", "", "Clear the display",[&]()
     {
         inky->clear();
@@ -312,20 +908,24 @@ int main()
     });
   }
 
-  absolute_time_t nextEvalTime = get_absolute_time();
-  while (1)
+  // The main loop's services, each on its own deadline (Scheduler.hpp).
+  // The button is polled at every yield point of a running command, so a
+  // press during a snap is kept for after it; the rest wait for the
+  // command to finish.
+  bool snapPressed = false;
+  bool testHeld = false;
+  Scheduler::add("button", 20, TaskWhen::Always, [&]()
   {
-    // Regulate loop speed
-    sleep_until(nextEvalTime);
-    nextEvalTime = make_timeout_time_ms(50);
-
-    // Check for USB I/O
-    parser.processStdIo();
-
-    // Check for the shutter button being pressed
     shutterButton.update();
-    if (shutterButton.buttonUp())
+    snapPressed |= shutterButton.buttonUp();
+    testHeld |= shutterButton.heldActivate();
+  });
+
+  Scheduler::add("shutter", 20, TaskWhen::Idle, [&]()
+  {
+    if (snapPressed)
     {
+      snapPressed = false;
       parser.processCommand("snap");
     }
     else
@@ -333,11 +933,49 @@ int main()
       showProgressOnLeds(0.0f, {0,0,0});
     }
 
-    if (shutterButton.heldActivate())
+    if (testHeld)
     {
+      testHeld = false;
       parser.processCommand("test");
     }
+  });
+
+  Scheduler::add("stdio", 20, TaskWhen::Idle, [&]()
+  {
+    parser.processStdIo();
+  });
+
+  // With spool on, erase the slot the next capture goes to ahead of time,
+  // a block per run, so spooling a snap only has to program flash
+  Scheduler::add("spool", 100, TaskWhen::Idle, [&]()
+  {
+    if (pipeline && pipeline->spoolCaptures)
+    {
+      FlashSpool::prepareNext();
+    }
+  });
+
+  // Print what the snap path logged, a little at a time
+  constexpr uint32_t LogDrainPerRun = 16;
+  uint32_t logDropped = 0;
+  Scheduler::add("log", 50, TaskWhen::Idle, [&]()
+  {
+    if (logBinary)
+    {
+      sendLogFrame(LogDrainPerRun);
+      return;
+    }
+    DeferredLog::drain(printLogEntry, LogDrainPerRun);
+    if (DeferredLog::dropped() != logDropped)
+    {
+      logDropped = DeferredLog::dropped();
+      std::cout << "Log dropped " << logDropped << " messages so far" << std::endl;
+    }
+  });
 
+  while (1)
+  {
+    Scheduler::runOnce();
   }
   return 0;
 }
@@ -0,0 +1,723 @@
+// Microbenchmarks of the image pipeline's hot paths on the host, to gate
+// changes to them on measured numbers:
+//
+//   pinky_bench [--filter PREFIX] [--min-time S] [--repetitions N]
+//               [--format yuv|rgb565 --size WxH] [--json out.json]
+//               [--compare baseline.json] [--threshold PCT] [INPUT...]
+//
+// Covered are IndexedColorMap::toIndexedColor, the dither views, writes to
+// the packed frame buffers and the ColorMapEffect maps for each panel's
+// palette, and each decoder over a corpus of captures. INPUT is a JPEG, a
+// raw capture in --format at --size, or a directory of them; without any
+// the bench command's built in JPEG is used.
+//
+// Like Google Benchmark, each benchmark runs enough iterations to take
+// --min-time, --repetitions times, and the fastest is kept. --json writes
+// the results in Google Benchmark's JSON layout (time in ns per
+// iteration). --compare reads such a file back and flags each benchmark
+// more than --threshold percent slower than it was there, exiting with 1
+// if any is.
+
+#include "Bench.hpp"
+#include "ColorMapEffect.hpp"
+#include "DeferredLog.hpp"
+#include "ImageConvert.hpp"
+#include "ImageDecode.hpp"
+#include "InkyPalettes.hpp"
+#include "JpegParallel.hpp"
+#include "LabKernels.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct Panel
+{
+  const char* name;
+  int width;
+  int height;
+  ColorCapability capability;
+  FrameLayout layout;
+};
+
+// One panel per palette the drivers have
+const Panel Panels[] =
+{
+  {"uc8159", 600, 448, ColorCapability::SevenColor, FrameLayout::Packed4Bit},
+  {"e673", 800, 480, ColorCapability::Spectra6, FrameLayout::Packed4Bit},
+  {"ssd1683", 400, 300, ColorCapability::BlackWhite, FrameLayout::TwoPlaneBinary},
+  {"ssd1683-red", 400, 300, ColorCapability::BlackWhiteRed, FrameLayout::TwoPlaneBinary},
+};
+
+struct Options
+{
+  std::string filter;
+  double minTime = 0.2;
+  int repetitions = 3;
+  std::optional<CaptureFormat> format;
+  int width = 0;
+  int height = 0;
+  fs::path jsonPath;
+  fs::path comparePath;
+  double threshold = 10.0;
+  std::vector<fs::path> inputs;
+};
+
+// One capture of the corpus
+struct Capture
+{
+  std::string name;
+  CaptureFormat format;
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> data;
+};
+
+struct Benchmark
+{
+  std::string name;
+  // Pixels (or colors, or maps) one iteration handles
+  uint64_t items;
+  // False if it failed (a decoder that couldn't decode)
+  std::function<bool()> run;
+};
+
+struct Result
+{
+  std::string name;
+  uint64_t iterations;
+  double ns;
+  double itemsPerSecond;
+};
+
+// Written by benchmarks so their work isn't optimized away
+volatile uint32_t benchSink = 0;
+
+std::shared_ptr<IndexedColorMap> panelColorMap(const Panel& panel)
+{
+  switch (panel.capability)
+  {
+    case ColorCapability::SevenColor:
+      return inkyUC8159ColorMap();
+    case ColorCapability::Spectra6:
+      return inkyE673ColorMap();
+    default:
+      return inkySSD1683ColorMap(panel.capability);
+  }
+}
+
+std::shared_ptr<ImageView<IndexedColor>> panelFrame(const Panel& panel, const IndexedColorMap& colorMap)
+{
+  if (panel.layout == FrameLayout::Packed4Bit)
+  {
+    return std::make_shared<Packed4BitIndexedImage>(panel.width, panel.height);
+  }
+  return inkySSD1683Frame(panel.width, panel.height, colorMap, panel.capability);
+}
+
+// The bench pattern at a panel's size, in each pixel type the dither views
+// take
+struct PatternFrame
+{
+  int width;
+  int height;
+  std::vector<RGBColor> rgb;
+  std::vector<LabColor> lab;
+  std::vector<LumaColor> luma;
+
+  PatternFrame(int width, int height)
+    : width{width}
+    , height{height}
+    , rgb(width * height)
+    , lab(width * height)
+    , luma(width * height)
+  {
+    for (int y=0; y < height; ++y)
+    {
+      for (int x=0; x < width; ++x)
+      {
+        RGBColor c = benchPattern(x, y, width, height);
+        rgb[y * width + x] = c;
+        pixelFromRGB(c.R, c.G, c.B, lab[y * width + x]);
+        pixelFromRGB(c.R, c.G, c.B, luma[y * width + x]);
+      }
+    }
+  }
+};
+
+template <typename View, typename PixelT>
+void ditherFrame(View& view, const std::vector<PixelT>& pixels)
+{
+  view.ditherAccuracy = BenchDitherAccuracy;
+  for (int y=0; y < view.height; ++y)
+  {
+    view.setPixels(0, y, pixels.data() + y * view.width, view.width);
+  }
+  view.flush();
+}
+
+void addPanelBenchmarks(std::vector<Benchmark>& benchmarks, const Panel& panel)
+{
+  std::string suffix = std::string("/") + panel.name;
+  std::shared_ptr<IndexedColorMap> colorMap = panelColorMap(panel);
+  std::shared_ptr<ImageView<IndexedColor>> frame = panelFrame(panel, *colorMap);
+  auto pattern = std::make_shared<PatternFrame>(panel.width, panel.height);
+  uint64_t pixels = (uint64_t)panel.width * panel.height;
+
+  // A run of the pattern's colors, as a decoder hands them over
+  constexpr int Colors = 4096;
+  benchmarks.push_back({"toIndexedColor/lab" + suffix, Colors, [=]()
+  {
+    uint32_t sum = 0;
+    for (int i=0; i < Colors; ++i)
+    {
+      sum += colorMap->toIndexedColor(pattern->lab[i]);
+    }
+    benchSink = sum;
+    return true;
+  }});
+  benchmarks.push_back({"toIndexedColor/lab-error" + suffix, Colors, [=]()
+  {
+    uint32_t sum = 0;
+    LabColor error;
+    for (int i=0; i < Colors; ++i)
+    {
+      sum += colorMap->toIndexedColor(pattern->lab[i], error);
+    }
+    benchSink = sum;
+    return true;
+  }});
+  benchmarks.push_back({"toIndexedColor/rgb" + suffix, Colors, [=]()
+  {
+    uint32_t sum = 0;
+    for (int i=0; i < Colors; ++i)
+    {
+      sum += colorMap->toIndexedColor(pattern->rgb[i]);
+    }
+    benchSink = sum;
+    return true;
+  }});
+
+  // A whole frame through each view, with error rows lent as snap does
+  auto labError = std::make_shared<LabDiffusionBuffer>(panel.width);
+  auto lumaError = std::make_shared<LumaDiffusionBuffer>(panel.width);
+  benchmarks.push_back({"dither/LabDitherView" + suffix, pixels, [=]()
+  {
+    LabDitherView view(*frame, *colorMap, labError.get());
+    ditherFrame(view, pattern->rgb);
+    return true;
+  }});
+  benchmarks.push_back({"dither/LabInputDitherView" + suffix, pixels, [=]()
+  {
+    LabInputDitherView view(*frame, *colorMap, labError.get());
+    ditherFrame(view, pattern->lab);
+    return true;
+  }});
+  if (colorMap->isMonochrome())
+  {
+    benchmarks.push_back({"dither/LumaDitherView" + suffix, pixels, [=]()
+    {
+      LumaDitherView view(*frame, *colorMap, lumaError.get());
+      ditherFrame(view, pattern->luma);
+      return true;
+    }});
+  }
+
+  // Indexed colors into the frame buffer, a pixel and a row at a time
+  std::string frameName = panel.layout == FrameLayout::Packed4Bit ? "Packed4BitIndexedImage" : "PackedTwoPlaneBinaryImage";
+  auto indexed = std::make_shared<std::vector<IndexedColor>>(pixels);
+  for (uint64_t i=0; i < pixels; ++i)
+  {
+    (*indexed)[i] = colorMap->toIndexedColor(pattern->rgb[i]);
+  }
+  benchmarks.push_back({"pack/" + frameName + "/setPixel" + suffix, pixels, [=]()
+  {
+    for (int y=0; y < frame->height; ++y)
+    {
+      for (int x=0; x < frame->width; ++x)
+      {
+        frame->setPixel(x, y, (*indexed)[y * frame->width + x]);
+      }
+    }
+    frame->flush();
+    return true;
+  }});
+  benchmarks.push_back({"pack/" + frameName + "/setPixels" + suffix, pixels, [=]()
+  {
+    for (int y=0; y < frame->height; ++y)
+    {
+      frame->setPixels(0, y, indexed->data() + y * frame->width, frame->width);
+    }
+    frame->flush();
+    return true;
+  }});
+
+  // The maps the effect command makes, each built from scratch
+  benchmarks.push_back({"effect/PanelMap" + suffix, 1, [=]()
+  {
+    benchSink = panelColorMap(panel)->size();
+    return true;
+  }});
+  for (ColorMapEffect effect : magic_enum::enum_values<ColorMapEffect>())
+  {
+    if (effect == ColorMapEffect::None || !getColorMapWithEffect(*colorMap, effect))
+    {
+      continue;
+    }
+    benchmarks.push_back({"effect/" + std::string(magic_enum::enum_name(effect)) + suffix, 1, [=]()
+    {
+      benchSink = getColorMapWithEffect(*colorMap, effect)->size();
+      return true;
+    }});
+  }
+}
+
+// Every decoder that takes the capture's format, into Lab as the color
+// pipeline decodes
+void addDecodeBenchmarks(std::vector<Benchmark>& benchmarks, std::shared_ptr<const Capture> capture)
+{
+  std::string suffix = "/" + capture->name;
+  uint64_t pixels = (uint64_t)capture->width * capture->height;
+  auto decoder = [&](const char* name, uint64_t items, std::function<bool(ByteSource&, BenchSinkView<LabColor>&)> decode)
+  {
+    benchmarks.push_back({std::string("decode/") + name + suffix, items, [=]()
+    {
+      MemoryByteSource src(capture->data.data(), (uint32_t)capture->data.size());
+      BenchSinkView<LabColor> sink(capture->width, capture->height);
+      return decode(src, sink);
+    }});
+  };
+
+  int width = capture->width;
+  int height = capture->height;
+  const uint8_t* data = capture->data.data();
+  uint32_t size = (uint32_t)capture->data.size();
+  switch (capture->format)
+  {
+    case CaptureFormat::JPG:
+      decoder("jpeg", pixels, [=](ByteSource& src, auto& sink) { return decodeImageJPG(width, height, src, sink); });
+      decoder("jpeg-pipelined", pixels, [=](ByteSource& src, auto& sink) { return decodeImageJPGPipelined(width, height, src, sink); });
+      decoder("jpeg-parallel", pixels, [=](ByteSource&, auto& sink) { return decodeImageJPGParallel(width, height, data, size, sink); });
+      break;
+    case CaptureFormat::YUV:
+      decoder("yuyv", pixels, [=](ByteSource& src, auto& sink) { return decodeImageYUYV(width, height, src, sink); });
+      decoder("yuyv-half", pixels, [=](ByteSource& src, auto& sink) { return decodeImageYUYVHalf(width, height, src, sink); });
+      break;
+    case CaptureFormat::RGB565:
+      decoder("rgb565", pixels, [=](ByteSource& src, auto& sink) { return decodeImageRGB565(width, height, src, sink); });
+      break;
+  }
+}
+
+// JPEGs by extension, anything else needs --format and --size
+bool loadCapture(const fs::path& path, const Options& options, Capture& capture)
+{
+  std::ifstream in(path, std::ios::binary);
+  capture.name = path.filename().string();
+  capture.data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  if (capture.data.empty())
+  {
+    std::cerr << path.string() << ": can't read" << std::endl;
+    return false;
+  }
+
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  capture.format = (ext == ".jpg" || ext == ".jpeg") ? CaptureFormat::JPG : options.format.value_or(CaptureFormat::YUV);
+  if (capture.format == CaptureFormat::JPG)
+  {
+    if (!jpegDimensions(capture.data.data(), capture.data.size(), capture.width, capture.height))
+    {
+      std::cerr << path.string() << ": not a JPEG" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  capture.width = options.width;
+  capture.height = options.height;
+  if ((size_t)capture.width * capture.height * 2 != capture.data.size())
+  {
+    std::cerr << path.string() << ": " << capture.data.size() << " bytes is not a " << capture.width << "x" << capture.height << " capture (--size)" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// What the decoders logged since the last call, on one line. None of it
+// belongs in the table, but it says why a run failed.
+std::string drainLog()
+{
+  std::string text;
+  DeferredLog::drain([&](const LogEntry& entry)
+  {
+    char line[128];
+    formatLogEntry(entry, line, sizeof(line));
+    text += (text.empty() ? "" : "; ") + std::string(line);
+  });
+  return text;
+}
+
+// Grow the iteration count until a run takes minTime, then keep the
+// fastest of the repetitions at that count. False if the warm up run
+// fails.
+bool measure(const Benchmark& benchmark, const Options& options, Result& result)
+{
+  if (!benchmark.run())
+  {
+    return false;
+  }
+
+  uint64_t iterations = 1;
+  double seconds = 0.0;
+  while (true)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i=0; i < iterations; ++i)
+    {
+      benchmark.run();
+    }
+    seconds = secondsSince(start);
+    if (seconds >= options.minTime || iterations >= 1000000000)
+    {
+      break;
+    }
+    // Aim a little past minTime, growing at most tenfold at once
+    double scale = seconds > 0.0 ? options.minTime * 1.4 / seconds : 10.0;
+    iterations = std::max<uint64_t>(iterations + 1, (uint64_t)((double)iterations * std::min(scale, 10.0)));
+  }
+
+  double best = seconds;
+  for (int rep=1; rep < options.repetitions; ++rep)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i=0; i < iterations; ++i)
+    {
+      benchmark.run();
+    }
+    best = std::min(best, secondsSince(start));
+  }
+  result = {benchmark.name, iterations, best * 1e9 / (double)iterations, (double)(benchmark.items * iterations) / best};
+  return true;
+}
+
+std::string jsonString(const std::string& text)
+{
+  std::string out = "\"";
+  for (char c : text)
+  {
+    if (c == '"' || c == '\\')
+    {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out + "\"";
+}
+
+bool writeJson(const fs::path& path, const std::vector<Result>& results)
+{
+  std::ofstream out(path);
+  std::time_t now = std::time(nullptr);
+  char date[32];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  out << std::setprecision(10);
+  out << "{\n";
+  out << "  \"context\": {\n";
+  out << "    \"date\": " << jsonString(date) << ",\n";
+  out << "    \"executable\": \"pinky_bench\",\n";
+  out << "    \"lab_kernels\": " << jsonString(labKernels().name) << "\n";
+  out << "  },\n";
+  out << "  \"benchmarks\": [\n";
+  for (size_t i=0; i < results.size(); ++i)
+  {
+    const Result& result = results[i];
+    out << "    {\n";
+    out << "      \"name\": " << jsonString(result.name) << ",\n";
+    out << "      \"run_type\": \"iteration\",\n";
+    out << "      \"iterations\": " << result.iterations << ",\n";
+    out << "      \"real_time\": " << result.ns << ",\n";
+    out << "      \"cpu_time\": " << result.ns << ",\n";
+    out << "      \"time_unit\": \"ns\",\n";
+    out << "      \"items_per_second\": " << result.itemsPerSecond << "\n";
+    out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  out << "  ]\n";
+  out << "}\n";
+  return (bool)out;
+}
+
+// Benchmark names and their real_time from a file writeJson wrote (or
+// Google Benchmark, in ns). Only as much JSON as that takes is understood.
+bool readJson(const fs::path& path, std::map<std::string, double>& times)
+{
+  std::ifstream in(path);
+  std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  if (text.empty())
+  {
+    return false;
+  }
+
+  const std::string nameKey = "\"name\":";
+  const std::string timeKey = "\"real_time\":";
+  for (size_t pos = text.find(nameKey); pos != std::string::npos; pos = text.find(nameKey, pos))
+  {
+    size_t begin = text.find('"', pos + nameKey.size());
+    std::string name;
+    size_t end = begin + 1;
+    for (; end < text.size() && text[end] != '"'; ++end)
+    {
+      if (text[end] == '\\' && end + 1 < text.size())
+      {
+        ++end;
+      }
+      name += text[end];
+    }
+    size_t time = text.find(timeKey, end);
+    size_t next = text.find(nameKey, end);
+    if (begin == std::string::npos || time == std::string::npos || (next != std::string::npos && time > next))
+    {
+      return false;
+    }
+    times[name] = strtod(text.c_str() + time + timeKey.size(), nullptr);
+    pos = end;
+  }
+  return true;
+}
+
+// Prints each benchmark against the baseline, returning how many are more
+// than threshold percent slower. Baseline ones outside filter are left out.
+int compareResults(const std::vector<Result>& results, const std::map<std::string, double>& baseline, const Options& options)
+{
+  double threshold = options.threshold;
+  int slower = 0;
+  std::cout << std::endl << "Against the baseline, " << threshold << "% slower flagged:" << std::endl;
+  for (const Result& result : results)
+  {
+    auto it = baseline.find(result.name);
+    std::cout << "  " << std::left << std::setw(56) << result.name << std::right;
+    if (it == baseline.end())
+    {
+      std::cout << "  new" << std::endl;
+      continue;
+    }
+    double change = (result.ns / it->second - 1.0) * 100.0;
+    bool flagged = change > threshold;
+    slower += flagged;
+    std::cout << std::fixed << std::setprecision(1) << std::setw(12) << it->second << " -> " << std::setw(12) << result.ns << " ns  "
+              << std::showpos << std::setw(7) << change << "%" << std::noshowpos << std::defaultfloat << (flagged ? "  SLOWER" : "") << std::endl;
+  }
+  for (const auto& [name, ns] : baseline)
+  {
+    bool ran = std::any_of(results.begin(), results.end(), [&](const Result& result) { return result.name == name; });
+    if (!ran && name.compare(0, options.filter.size(), options.filter) == 0)
+    {
+      std::cout << "  " << std::left << std::setw(56) << name << std::right << "  not run" << std::endl;
+    }
+  }
+  return slower;
+}
+
+bool isCapture(const fs::path& path, const Options& options)
+{
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  return ext == ".jpg" || ext == ".jpeg" || (options.format && options.width > 0);
+}
+
+void usage()
+{
+  std::cerr << "usage: pinky_bench [--filter PREFIX] [--min-time S] [--repetitions N] [--format yuv|rgb565 --size WxH]" << std::endl;
+  std::cerr << "                   [--json FILE] [--compare FILE] [--threshold PCT] [INPUT...]" << std::endl;
+  std::cerr << "  INPUT is a JPEG, a raw capture in --format at --size, or a directory of them" << std::endl;
+}
+
+bool parseArgs(int argc, char** argv, Options& options)
+{
+  for (int i=1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--filter" && hasValue)
+    {
+      options.filter = argv[++i];
+    }
+    else if (arg == "--min-time" && hasValue)
+    {
+      options.minTime = std::max(atof(argv[++i]), 0.0);
+    }
+    else if (arg == "--repetitions" && hasValue)
+    {
+      options.repetitions = std::max(atoi(argv[++i]), 1);
+    }
+    else if (arg == "--format" && hasValue)
+    {
+      std::string name = argv[++i];
+      options.format = magic_enum::enum_cast<CaptureFormat>(name, magic_enum::case_insensitive);
+      if (!options.format || options.format == CaptureFormat::JPG)
+      {
+        std::cerr << "Unknown raw format " << name << std::endl;
+        return false;
+      }
+    }
+    else if (arg == "--size" && hasValue)
+    {
+      if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2)
+      {
+        return false;
+      }
+    }
+    else if (arg == "--json" && hasValue)
+    {
+      options.jsonPath = argv[++i];
+    }
+    else if (arg == "--compare" && hasValue)
+    {
+      options.comparePath = argv[++i];
+    }
+    else if (arg == "--threshold" && hasValue)
+    {
+      options.threshold = atof(argv[++i]);
+    }
+    else if (!arg.empty() && arg[0] != '-')
+    {
+      options.inputs.push_back(arg);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!parseArgs(argc, argv, options))
+  {
+    usage();
+    return 2;
+  }
+
+  std::map<std::string, double> baseline;
+  if (!options.comparePath.empty() && !readJson(options.comparePath, baseline))
+  {
+    std::cerr << options.comparePath.string() << ": not a benchmark JSON file" << std::endl;
+    return 1;
+  }
+
+  std::vector<fs::path> files;
+  for (const fs::path& input : options.inputs)
+  {
+    std::error_code error;
+    if (fs::is_directory(input, error))
+    {
+      for (const fs::directory_entry& entry : fs::directory_iterator(input, error))
+      {
+        if (entry.is_regular_file() && isCapture(entry.path(), options))
+        {
+          files.push_back(entry.path());
+        }
+      }
+    }
+    else
+    {
+      files.push_back(input);
+    }
+  }
+  std::sort(files.begin(), files.end());
+
+  std::vector<std::shared_ptr<const Capture>> corpus;
+  for (const fs::path& file : files)
+  {
+    auto capture = std::make_shared<Capture>();
+    if (loadCapture(file, options, *capture))
+    {
+      corpus.push_back(capture);
+    }
+  }
+  if (options.inputs.empty())
+  {
+    auto capture = std::make_shared<Capture>();
+    capture->name = "bench-sample";
+    capture->format = CaptureFormat::JPG;
+    capture->data.assign(BenchSampleJpeg, BenchSampleJpeg + sizeof(BenchSampleJpeg));
+    jpegDimensions(BenchSampleJpeg, sizeof(BenchSampleJpeg), capture->width, capture->height);
+    corpus.push_back(capture);
+  }
+
+  std::vector<Benchmark> benchmarks;
+  for (const Panel& panel : Panels)
+  {
+    addPanelBenchmarks(benchmarks, panel);
+  }
+  for (const std::shared_ptr<const Capture>& capture : corpus)
+  {
+    addDecodeBenchmarks(benchmarks, capture);
+  }
+
+  std::cout << "pinky_bench: " << labKernels().name << " Lab kernels, fastest of " << options.repetitions
+            << " runs of at least " << options.minTime << " s" << std::endl;
+  std::vector<Result> results;
+  int failed = 0;
+  for (const Benchmark& benchmark : benchmarks)
+  {
+    if (benchmark.name.compare(0, options.filter.size(), options.filter) != 0)
+    {
+      continue;
+    }
+    Result result;
+    bool ok = measure(benchmark, options, result);
+    std::string log = drainLog();
+    if (!ok)
+    {
+      std::cout << "  " << std::left << std::setw(56) << benchmark.name << std::right << "  failed: " << log << std::endl;
+      ++failed;
+      continue;
+    }
+
+    results.push_back(result);
+    std::cout << "  " << std::left << std::setw(56) << result.name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(14) << result.ns << " ns" << std::setw(10) << result.iterations << " iterations"
+              << std::setprecision(2) << std::setw(10) << result.itemsPerSecond / 1e6 << " M items/s" << std::defaultfloat << std::endl;
+  }
+  if (results.empty() && failed == 0)
+  {
+    std::cerr << "No benchmark starts with " << options.filter << std::endl;
+    return 1;
+  }
+
+  if (!options.jsonPath.empty() && !writeJson(options.jsonPath, results))
+  {
+    std::cerr << options.jsonPath.string() << ": can't write" << std::endl;
+    return 1;
+  }
+  if (!options.comparePath.empty())
+  {
+    int slower = compareResults(results, baseline, options);
+    std::cout << slower << " of " << results.size() << " benchmarks slower than the baseline" << std::endl;
+    return (slower == 0 && failed == 0) ? 0 : 1;
+  }
+  return failed == 0 ? 0 : 1;
+}
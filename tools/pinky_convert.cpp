@@ -0,0 +1,394 @@
+// Converts JPEGs into the packed frames an Inky panel takes, with the same
+// decode, color map and dither code the device runs, so the output matches
+// what the device would show bit for bit.
+//
+//   pinky_convert --panel e673 [--effect Saturated] [--dither 0.95]
+//                 [--jobs N] [--ppm] -o outdir photo.jpg photos/ ...
+//
+// Each input becomes outdir/<name>.bin, the frame as the panel driver sends
+// it (see Inky::framePlanes), and with --ppm a preview in the panel's
+// colors. Like the device, images are centered on the panel and cropped,
+// not scaled. Files are shared out between worker processes, one per core
+// by default (picojpeg keeps its state in globals, so threads won't do).
+
+#include "ColorMapEffect.hpp"
+#include "DeferredLog.hpp"
+#include "ImageConvert.hpp"
+#include "ImageDecode.hpp"
+#include "ImageEffect.hpp"
+#include "InkyPalettes.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct Panel
+{
+  const char* name;
+  int width;
+  int height;
+  ColorCapability capability;
+  FrameLayout layout;
+};
+
+// The panels the drivers support, at the size they correct the eeprom to
+const Panel Panels[] =
+{
+  {"uc8159", 600, 448, ColorCapability::SevenColor, FrameLayout::Packed4Bit},
+  {"uc8159-640", 640, 400, ColorCapability::SevenColor, FrameLayout::Packed4Bit},
+  {"e673", 800, 480, ColorCapability::Spectra6, FrameLayout::Packed4Bit},
+  {"ssd1683", 400, 300, ColorCapability::BlackWhite, FrameLayout::TwoPlaneBinary},
+  {"ssd1683-red", 400, 300, ColorCapability::BlackWhiteRed, FrameLayout::TwoPlaneBinary},
+  {"ssd1683-yellow", 400, 300, ColorCapability::BlackWhiteYellow, FrameLayout::TwoPlaneBinary},
+};
+
+struct Options
+{
+  const Panel* panel = nullptr;
+  ColorMapEffect effect = ColorMapEffect::None;
+  float ditherAccuracy = 0.95f;
+  int jobs = 0;
+  bool ppm = false;
+  fs::path outDir = ".";
+  std::vector<fs::path> inputs;
+};
+
+// A panel's frame buffer, either kind
+struct PanelFrame
+{
+  std::shared_ptr<Packed4BitIndexedImage> packed;
+  std::shared_ptr<PackedTwoPlaneBinaryImage> planes;
+  ColorCapability capability;
+
+  ImageView<IndexedColor>& view()
+  {
+    return packed ? (ImageView<IndexedColor>&)*packed : *planes;
+  }
+
+  // As InkyUC8159, InkyE673 and InkySSD1683 send it
+  std::vector<FramePlane> framePlanes() const
+  {
+    if (packed)
+    {
+      return {{packed->getData().data(), (uint32_t)packed->getData().size()}};
+    }
+    const auto& black = planes->getPlane(PackedTwoPlaneBinaryImage::Plane::Black);
+    const auto& color = planes->getPlane(PackedTwoPlaneBinaryImage::Plane::Color);
+    if (capability == ColorCapability::BlackWhite)
+    {
+      return {{black.data(), (uint32_t)black.size()}};
+    }
+    return {{black.data(), (uint32_t)black.size()}, {color.data(), (uint32_t)color.size()}};
+  }
+};
+
+std::shared_ptr<IndexedColorMap> panelColorMap(const Panel& panel)
+{
+  switch (panel.capability)
+  {
+    case ColorCapability::SevenColor:
+      return inkyUC8159ColorMap();
+    case ColorCapability::Spectra6:
+      return inkyE673ColorMap();
+    default:
+      return inkySSD1683ColorMap(panel.capability);
+  }
+}
+
+PanelFrame makePanelFrame(const Panel& panel, const IndexedColorMap& colorMap)
+{
+  PanelFrame frame;
+  frame.capability = panel.capability;
+  if (panel.layout == FrameLayout::Packed4Bit)
+  {
+    frame.packed = std::make_shared<Packed4BitIndexedImage>(panel.width, panel.height);
+  }
+  else
+  {
+    frame.planes = inkySSD1683Frame(panel.width, panel.height, colorMap, panel.capability);
+  }
+  return frame;
+}
+
+bool writeFile(const fs::path& path, const std::vector<FramePlane>& planes)
+{
+  std::ofstream out(path, std::ios::binary);
+  for (const FramePlane& plane : planes)
+  {
+    out.write((const char*)plane.data, plane.size);
+  }
+  return (bool)out;
+}
+
+// The frame in the colors the panel really shows
+bool writePPM(const fs::path& path, PanelFrame& frame, const IndexedColorMap& panelMap)
+{
+  ImageView<IndexedColor>& view = frame.view();
+  std::ofstream out(path, std::ios::binary);
+  out << "P6\n" << view.width << " " << view.height << "\n255\n";
+  std::vector<uint8_t> row(view.width * 3);
+  for (int y=0; y < view.height; ++y)
+  {
+    for (int x=0; x < view.width; ++x)
+    {
+      RGBColor rgb = panelMap.toRGBColor(view.getPixel(x, y));
+      row[x*3] = rgb.R;
+      row[x*3 + 1] = rgb.G;
+      row[x*3 + 2] = rgb.B;
+    }
+    out.write((const char*)row.data(), row.size());
+  }
+  return (bool)out;
+}
+
+// Decode, dither and pack one JPEG, the way snap does with spooling on
+bool convert(const fs::path& input, const Options& options, const IndexedColorMap& panelMap, const IndexedColorMap& colorMap)
+{
+  auto startTime = std::chrono::steady_clock::now();
+  std::ifstream in(input, std::ios::binary);
+  std::vector<uint8_t> jpeg((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  int width = 0;
+  int height = 0;
+  if (jpeg.empty() || !jpegDimensions(jpeg.data(), jpeg.size(), width, height))
+  {
+    std::cerr << input.string() << ": not a JPEG" << std::endl;
+    return false;
+  }
+
+  PanelFrame frame = makePanelFrame(*options.panel, panelMap);
+  ImageView<IndexedColor>& display = frame.view();
+
+  // Inky::clear()
+  IndexedColor border = panelMap.toIndexedColor(ColorName::Black);
+  for (int y=0; y < display.height; ++y)
+  {
+    for (int x=0; x < display.width; ++x)
+    {
+      display.setPixel(x, y, border);
+    }
+  }
+
+  MemoryByteSource src(jpeg.data(), (uint32_t)jpeg.size());
+  bool ok = false;
+  if (colorMap.isMonochrome())
+  {
+    LumaDitherView buffer(display, colorMap);
+    buffer.ditherAccuracy = options.ditherAccuracy;
+    AlignCenterView centeredBuffer(buffer, width, height);
+    ok = decodeImageJPG(width, height, src, centeredBuffer);
+  }
+  else
+  {
+    LabInputDitherView buffer(display, colorMap);
+    buffer.ditherAccuracy = options.ditherAccuracy;
+    AlignCenterView centeredBuffer(buffer, width, height);
+    ok = decodeImageJPG(width, height, src, centeredBuffer);
+  }
+  DeferredLog::drain(printLogEntry);
+  if (!ok)
+  {
+    std::cerr << input.string() << ": decode failed" << std::endl;
+    return false;
+  }
+
+  fs::path out = options.outDir / input.stem();
+  if (!writeFile(out.string() + ".bin", frame.framePlanes()) ||
+      (options.ppm && !writePPM(out.string() + ".ppm", frame, panelMap)))
+  {
+    std::cerr << out.string() << ": can't write output" << std::endl;
+    return false;
+  }
+
+  auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+  std::cout << input.string() << ": " << width << "x" << height << " -> " << out.string() << ".bin in " << elapsedMs << " ms" << std::endl;
+  return true;
+}
+
+bool isJpeg(const fs::path& path)
+{
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  return ext == ".jpg" || ext == ".jpeg";
+}
+
+void usage()
+{
+  std::cerr << "usage: pinky_convert --panel NAME [--effect NAME] [--dither 0.0-1.0] [--jobs N] [--ppm] [-o DIR] INPUT..." << std::endl;
+  std::cerr << "  INPUT is a JPEG or a directory of them" << std::endl;
+  std::cerr << "  panels:";
+  for (const Panel& panel : Panels)
+  {
+    std::cerr << " " << panel.name;
+  }
+  std::cerr << std::endl;
+}
+
+bool parseArgs(int argc, char** argv, Options& options)
+{
+  for (int i=1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--panel" && hasValue)
+    {
+      std::string name = argv[++i];
+      for (const Panel& panel : Panels)
+      {
+        options.panel = name == panel.name ? &panel : options.panel;
+      }
+      if (!options.panel)
+      {
+        std::cerr << "Unknown panel " << name << std::endl;
+        return false;
+      }
+    }
+    else if (arg == "--effect" && hasValue)
+    {
+      std::string name = argv[++i];
+      std::optional<ColorMapEffect> effect = magic_enum::enum_cast<ColorMapEffect>(name, magic_enum::case_insensitive);
+      if (!effect)
+      {
+        effect = magic_enum::enum_cast<ColorMapEffect>(atoi(name.c_str()));
+      }
+      if (!effect)
+      {
+        std::cerr << "Unknown effect " << name << std::endl;
+        return false;
+      }
+      options.effect = effect.value();
+    }
+    else if (arg == "--dither" && hasValue)
+    {
+      options.ditherAccuracy = std::clamp((float)atof(argv[++i]), 0.0f, 1.0f);
+    }
+    else if (arg == "--jobs" && hasValue)
+    {
+      options.jobs = atoi(argv[++i]);
+    }
+    else if (arg == "--ppm")
+    {
+      options.ppm = true;
+    }
+    else if (arg == "-o" && hasValue)
+    {
+      options.outDir = argv[++i];
+    }
+    else if (!arg.empty() && arg[0] != '-')
+    {
+      options.inputs.push_back(arg);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return options.panel && !options.inputs.empty();
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!parseArgs(argc, argv, options))
+  {
+    usage();
+    return 2;
+  }
+
+  std::vector<fs::path> files;
+  for (const fs::path& input : options.inputs)
+  {
+    std::error_code error;
+    if (fs::is_directory(input, error))
+    {
+      for (const fs::directory_entry& entry : fs::directory_iterator(input, error))
+      {
+        if (entry.is_regular_file() && isJpeg(entry.path()))
+        {
+          files.push_back(entry.path());
+        }
+      }
+    }
+    else
+    {
+      files.push_back(input);
+    }
+  }
+  std::sort(files.begin(), files.end());
+  fs::create_directories(options.outDir);
+
+  // Same as the effect command: an effect the panel can't do leaves the
+  // panel's own map in place
+  std::shared_ptr<IndexedColorMap> panelMap = panelColorMap(*options.panel);
+  std::shared_ptr<IndexedColorMap> effectMap = getColorMapWithEffect(*panelMap, options.effect);
+  const IndexedColorMap& colorMap = effectMap ? *effectMap : *panelMap;
+
+  // Workers take the next file from a shared counter until there are none
+  // left, and count the ones that fail
+  int jobs = options.jobs > 0 ? options.jobs : (int)sysconf(_SC_NPROCESSORS_ONLN);
+  jobs = std::max(1, std::min(jobs, (int)files.size()));
+  struct Shared
+  {
+    std::atomic<int> next;
+    std::atomic<int> failed;
+  };
+  Shared* shared = (Shared*)mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (shared == MAP_FAILED)
+  {
+    perror("mmap");
+    return 1;
+  }
+  new (shared) Shared{{0}, {0}};
+
+  auto startTime = std::chrono::steady_clock::now();
+  std::vector<pid_t> workers;
+  for (int job=0; job < jobs; ++job)
+  {
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+      perror("fork");
+      break;
+    }
+    if (pid == 0)
+    {
+      for (int i = shared->next++; i < (int)files.size(); i = shared->next++)
+      {
+        if (!convert(files[i], options, *panelMap, colorMap))
+        {
+          ++shared->failed;
+        }
+      }
+      std::cout.flush();
+      _exit(0);
+    }
+    workers.push_back(pid);
+  }
+
+  bool workersOk = !workers.empty();
+  for (pid_t pid : workers)
+  {
+    int status = 0;
+    waitpid(pid, &status, 0);
+    workersOk = workersOk && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  }
+
+  auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+  int failed = shared->failed;
+  std::cout << "Converted " << files.size() - failed << " of " << files.size() << " images for " << options.panel->name
+            << " with " << workers.size() << " workers in " << elapsedMs << " ms" << std::endl;
+  return (failed == 0 && workersOk) ? 0 : 1;
+}
@@ -0,0 +1,501 @@
+#!/usr/bin/env python3
+"""Host side of the pinky binary link (src/UsbLink.hpp).
+
+Talks to the device over its USB serial port: sends the `link` text command
+to switch it into the binary protocol, then uploads images to render or
+downloads the display buffer and gallery frames.
+
+    pinky_link.py --port /dev/ttyACM0 ping
+    pinky_link.py --port /dev/ttyACM0 upload photo.jpg
+    pinky_link.py --port /dev/ttyACM0 upload frame.rgb --format rgb565 --width 320 --height 240
+    pinky_link.py --port /dev/ttyACM0 download frame.bin [--slot 3] [--compressed]
+    pinky_link.py selftest [--loopback build/pinky_link_loopback]
+
+selftest runs the client against a simulated device on a pseudo terminal,
+so it needs no hardware. With --loopback it also drives the device's own
+UsbLink and FrameCodec code, built for the host as pinky_link_loopback.
+"""
+
+import argparse
+import os
+import select
+import struct
+import subprocess
+import sys
+import termios
+import threading
+import time
+import tty
+import zlib
+
+VERSION = 1
+MAX_PAYLOAD = 4096
+
+HELLO = 0x01
+ACK = 0x02
+ERROR = 0x03
+UPLOAD = 0x10
+UPLOAD_DATA = 0x11
+DOWNLOAD = 0x20
+DOWNLOAD_INFO = 0x21
+DOWNLOAD_DATA = 0x22
+DOWNLOAD_END = 0x23
+EXIT = 0x7F
+
+DISPLAY_SOURCE = 0xFF
+
+# CAM_IMAGE_PIX_FMT values
+FORMATS = {"jpg": 1, "rgb565": 2, "yuv": 3}
+
+# FrameLayout and FrameEncoding values
+LAYOUTS = ["Packed4Bit", "TwoPlaneBinary"]
+RAW = 0
+COMPRESSED = 1
+
+# Upload format pinky_link_loopback takes as a FrameCodec compressed frame
+LOOPBACK_COMPRESSED_FORMAT = 0x80
+
+CODEC_WINDOW = 4096
+CODEC_MIN_MATCH = 3
+
+
+class LinkError(Exception):
+    pass
+
+
+def encode_frame(frame_type, payload=b""):
+    body = struct.pack("<BH", frame_type, len(payload)) + payload
+    return b"PK" + body + struct.pack("<I", zlib.crc32(body))
+
+
+class Link:
+    """Frames over a file descriptor. Anything that isn't a good frame (the
+    device's log output, mostly) is skipped and handed to on_text."""
+
+    def __init__(self, fd, on_text=None):
+        self.fd = fd
+        self.buffer = bytearray()
+        self.on_text = on_text
+        self.bad_frames = 0
+
+    def send(self, frame_type, payload=b""):
+        data = encode_frame(frame_type, payload)
+        while data:
+            written = os.write(self.fd, data)
+            data = data[written:]
+
+    def _fill(self, deadline):
+        timeout = deadline - time.monotonic()
+        if timeout <= 0:
+            return False
+        ready, _, _ = select.select([self.fd], [], [], timeout)
+        if not ready:
+            return False
+        try:
+            chunk = os.read(self.fd, 65536)
+        except OSError:
+            return False
+        if not chunk:
+            return False
+        self.buffer += chunk
+        return True
+
+    def _skip(self, count):
+        if count > 0:
+            if self.on_text:
+                self.on_text(bytes(self.buffer[:count]))
+            del self.buffer[:count]
+
+    def receive(self, timeout=5.0):
+        deadline = time.monotonic() + timeout
+        while True:
+            start = self.buffer.find(b"PK")
+            if start < 0:
+                # Keep a trailing 'P', it may be the start of the magic
+                self._skip(len(self.buffer) - (1 if self.buffer.endswith(b"P") else 0))
+            else:
+                self._skip(start)
+                if len(self.buffer) >= 5:
+                    frame_type, length = struct.unpack_from("<BH", self.buffer, 2)
+                    if length > MAX_PAYLOAD:
+                        self._skip(1)
+                        continue
+                    if len(self.buffer) >= 9 + length:
+                        body = bytes(self.buffer[2:5 + length])
+                        (crc,) = struct.unpack_from("<I", self.buffer, 5 + length)
+                        if crc == zlib.crc32(body):
+                            del self.buffer[:9 + length]
+                            return frame_type, body[3:]
+                        self.bad_frames += 1
+                        self._skip(1)
+                        continue
+            if not self._fill(deadline):
+                raise LinkError("timed out waiting for the device")
+
+    def expect(self, frame_type, timeout=5.0):
+        got, payload = self.receive(timeout)
+        if got == ERROR:
+            raise LinkError("device: " + payload.decode(errors="replace"))
+        if got != frame_type:
+            raise LinkError("expected frame 0x%02x, got 0x%02x" % (frame_type, got))
+        return payload
+
+
+class Client:
+    def __init__(self, fd, verbose=False):
+        self.link = Link(fd, self._log if verbose else None)
+
+    @staticmethod
+    def _log(text):
+        sys.stderr.write(text.decode(errors="replace"))
+
+    def enter(self):
+        """Switch the device from text commands to the link"""
+        os.write(self.link.fd, b"\nlink\n")
+        version = self.link.expect(ACK, timeout=5.0)
+        if version and version[0] != VERSION:
+            raise LinkError("device speaks link version %d, not %d" % (version[0], VERSION))
+
+    def ping(self):
+        start = time.monotonic()
+        self.link.send(HELLO)
+        self.link.expect(ACK)
+        return time.monotonic() - start
+
+    def upload(self, data, width, height, image_format, timeout=120.0):
+        """Send an image for the device to render. Waits for it to reach the
+        panel, which takes a while for an e-ink refresh."""
+        self.link.send(UPLOAD, struct.pack("<IHHB", len(data), width, height, image_format))
+        for offset in range(0, len(data), MAX_PAYLOAD):
+            self.link.send(UPLOAD_DATA, data[offset:offset + MAX_PAYLOAD])
+        self.link.expect(ACK, timeout)
+
+    def download(self, source=DISPLAY_SOURCE, encoding=RAW):
+        """Fetch a frame, returning (info, frame bytes as sent)"""
+        self.link.send(DOWNLOAD, struct.pack("<BB", source, encoding))
+        raw_size, width, height, layout, encoding = struct.unpack(
+            "<IHHBB", self.link.expect(DOWNLOAD_INFO))
+        info = {"size": raw_size, "width": width, "height": height,
+                "layout": layout, "encoding": encoding}
+        data = bytearray()
+        while True:
+            frame_type, payload = self.link.receive()
+            if frame_type == DOWNLOAD_DATA:
+                data += payload
+            elif frame_type == DOWNLOAD_END:
+                size, crc = struct.unpack("<II", payload)
+                if size != len(data) or crc != zlib.crc32(data):
+                    raise LinkError("download is corrupt (lost %d bytes)" % (size - len(data)))
+                return info, bytes(data)
+            elif frame_type == ERROR:
+                raise LinkError("device: " + payload.decode(errors="replace"))
+            else:
+                raise LinkError("unexpected frame 0x%02x in download" % frame_type)
+
+    def exit(self):
+        self.link.send(EXIT)
+        self.link.expect(ACK)
+
+
+def decompress_frame(data):
+    """Expand a FrameCodec.hpp compressed frame"""
+    (size,) = struct.unpack_from("<I", data)
+    out = bytearray()
+    pos = 4
+    while len(out) < size:
+        token = data[pos]
+        pos += 1
+        if token & 0x80 == 0:
+            count = (token & 0x7F) + 1
+            out += data[pos:pos + count]
+            pos += count
+            continue
+        count = (token & 0x3F) + CODEC_MIN_MATCH
+        if token & 0x3F == 63:
+            count += data[pos]
+            pos += 1
+        if token & 0x40 == 0:
+            out += bytes([data[pos]]) * count
+            pos += 1
+        else:
+            (offset,) = struct.unpack_from("<H", data, pos)
+            pos += 2
+            if offset == 0 or offset > CODEC_WINDOW or offset > len(out):
+                raise LinkError("compressed frame is corrupt")
+            for _ in range(count):
+                out.append(out[-offset])
+    if len(out) != size:
+        raise LinkError("compressed frame is corrupt")
+    return bytes(out)
+
+
+def compress_frame(data):
+    """A valid, if weak, FrameCodec encoding (runs and literals only), for
+    the simulated device"""
+    out = bytearray(struct.pack("<I", len(data)))
+    literals = bytearray()
+
+    def flush_literals():
+        for start in range(0, len(literals), 128):
+            piece = literals[start:start + 128]
+            out.append(len(piece) - 1)
+            out.extend(piece)
+        literals.clear()
+
+    pos = 0
+    while pos < len(data):
+        run = 1
+        while pos + run < len(data) and run < CODEC_MIN_MATCH + 63 + 255 and data[pos + run] == data[pos]:
+            run += 1
+        if run >= CODEC_MIN_MATCH:
+            flush_literals()
+            extra = run - CODEC_MIN_MATCH
+            out.append(0x80 | min(extra, 63))
+            if extra >= 63:
+                out.append(extra - 63)
+            out.append(data[pos])
+            pos += run
+        else:
+            literals.append(data[pos])
+            pos += 1
+    flush_literals()
+    return bytes(out)
+
+
+def jpeg_size(data):
+    """Width and height from a JPEG's start of frame marker"""
+    pos = 2
+    while pos + 9 < len(data):
+        if data[pos] != 0xFF:
+            break
+        marker = data[pos + 1]
+        (length,) = struct.unpack_from(">H", data, pos + 2)
+        if 0xC0 <= marker <= 0xCF and marker not in (0xC4, 0xC8, 0xCC):
+            height, width = struct.unpack_from(">HH", data, pos + 5)
+            return width, height
+        pos += 2 + length
+    raise LinkError("can't find the size of the JPEG")
+
+
+def open_port(path):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd, termios.TCSANOW)
+    return fd
+
+
+def run(args, client):
+    client.enter()
+    try:
+        if args.command == "ping":
+            print("Link up, round trip %.1f ms" % (client.ping() * 1000))
+        elif args.command == "upload":
+            with open(args.file, "rb") as f:
+                data = f.read()
+            if not args.format and data[:2] != b"\xff\xd8":
+                raise LinkError("not a JPEG, give the --format")
+            image_format = FORMATS[args.format or "jpg"]
+            width, height = args.width, args.height
+            if image_format == FORMATS["jpg"] and not (width and height):
+                width, height = jpeg_size(data)
+            if not (width and height):
+                raise LinkError("--width and --height are needed for raw images")
+            start = time.monotonic()
+            client.upload(data, width, height, image_format)
+            print("Uploaded %d bytes and rendered in %.1f s" % (len(data), time.monotonic() - start))
+        elif args.command == "download":
+            start = time.monotonic()
+            source = DISPLAY_SOURCE if args.slot is None else args.slot
+            info, data = client.download(source, COMPRESSED if args.compressed else RAW)
+            elapsed = max(time.monotonic() - start, 1e-6)
+            frame = decompress_frame(data) if info["encoding"] == COMPRESSED else data
+            if len(frame) != info["size"]:
+                raise LinkError("frame is %d bytes, expected %d" % (len(frame), info["size"]))
+            with open(args.file, "wb") as f:
+                f.write(frame)
+            print("%dx%d %s frame, %d bytes over the link in %.2f s (%.0f KB/s)" % (
+                info["width"], info["height"], LAYOUTS[info["layout"]], len(data),
+                elapsed, len(data) / elapsed / 1024))
+    finally:
+        client.exit()
+
+
+class FakeDevice(threading.Thread):
+    """Enough of the device side of the link to test the client with.
+    Scatters log text, and frames with bad checksums, among its replies."""
+
+    def __init__(self, fd, width=64, height=24):
+        super().__init__(daemon=True)
+        self.link = Link(fd)
+        self.width = width
+        self.height = height
+        # A Packed4Bit frame with flat areas and some noise
+        self.frame = bytes(
+            (0x11 if (x // 8 + y // 4) % 2 else 0x23) if x < 24 else (x * 7 + y * 13) & 0xFF
+            for y in range(height) for x in range(width // 2))
+        self.uploads = []
+        self.error = None
+
+    def noise(self):
+        os.write(self.link.fd, b"[log] PKPK not a frame\r\n")
+        bad = bytearray(encode_frame(ACK, b"bad"))
+        bad[-1] ^= 0xFF
+        os.write(self.link.fd, bytes(bad))
+
+    def run(self):
+        try:
+            while b"link" not in self.link.buffer:
+                self.link._fill(time.monotonic() + 5)
+            self.link.buffer.clear()
+            self.noise()
+            self.link.send(ACK, bytes([VERSION]))
+            while True:
+                frame_type, payload = self.link.receive()
+                if frame_type == HELLO:
+                    self.link.send(ACK, bytes([VERSION]))
+                elif frame_type == UPLOAD:
+                    size, width, height, image_format = struct.unpack("<IHHB", payload)
+                    data = bytearray()
+                    while len(data) < size:
+                        frame_type, payload = self.link.receive()
+                        if frame_type != UPLOAD_DATA:
+                            raise LinkError("upload interrupted")
+                        data += payload
+                    self.uploads.append((bytes(data), width, height, image_format))
+                    os.write(self.link.fd, b"Picture converted in 1234 ms\r\n")
+                    self.link.send(ACK)
+                elif frame_type == DOWNLOAD:
+                    source, encoding = struct.unpack("<BB", payload)
+                    data = compress_frame(self.frame) if encoding == COMPRESSED else self.frame
+                    self.link.send(DOWNLOAD_INFO, struct.pack(
+                        "<IHHBB", len(self.frame), self.width, self.height, 0, encoding))
+                    for offset in range(0, len(data), MAX_PAYLOAD):
+                        self.link.send(DOWNLOAD_DATA, data[offset:offset + MAX_PAYLOAD])
+                        self.noise()
+                    self.link.send(DOWNLOAD_END, struct.pack("<II", len(data), zlib.crc32(data)))
+                elif frame_type == EXIT:
+                    self.link.send(ACK)
+                    return
+                else:
+                    self.link.send(ERROR, b"Unexpected frame")
+        except Exception as e:
+            self.error = e
+
+
+def selftest():
+    device_fd, host_fd = os.openpty()
+    device = FakeDevice(device_fd)
+    tty.setraw(device_fd, termios.TCSANOW)
+    device.start()
+
+    client = Client(open_port(os.ttyname(host_fd)))
+    os.close(host_fd)
+    client.enter()
+    client.ping()
+
+    image = bytes(range(256)) * 40
+    client.upload(image, 320, 240, FORMATS["jpg"])
+    assert device.uploads == [(image, 320, 240, FORMATS["jpg"])], "upload arrived damaged"
+
+    info, data = client.download()
+    assert info["encoding"] == RAW and data == device.frame, "raw download damaged"
+    info, data = client.download(encoding=COMPRESSED)
+    assert info["encoding"] == COMPRESSED and len(data) < len(device.frame)
+    assert decompress_frame(data) == device.frame, "compressed download damaged"
+    assert (info["width"], info["height"], info["size"]) == (device.width, device.height, len(device.frame))
+
+    client.exit()
+    device.join(5)
+    assert device.error is None, device.error
+    assert client.link.bad_frames > 0, "corrupt frames were not noticed"
+    print("selftest passed (%d bad frames skipped)" % client.link.bad_frames)
+
+
+def selftest_loopback(path):
+    """Resync, uploads and downloads against the C++ link in tools/pinky_link_loopback.cpp"""
+    device_fd, host_fd = os.openpty()
+    tty.setraw(device_fd, termios.TCSANOW)
+    device = subprocess.Popen([path], stdin=device_fd, stdout=device_fd)
+    text = bytearray()
+    client = Client(open_port(os.ttyname(host_fd)))
+    client.link.on_text = text.extend
+    os.close(host_fd)
+    try:
+        client.enter()
+        link = client.link
+
+        # Noise the device has to skip: text, a run of P before the magic,
+        # and a frame with a bad checksum, each followed by a good frame
+        bad = bytearray(encode_frame(HELLO, b"bad"))
+        bad[-1] ^= 0xFF
+        for noise in (b"[log] not a frame\r\n", b"PP", b"xPPPx" + b"P", bytes(bad)):
+            os.write(link.fd, noise + encode_frame(HELLO))
+            link.expect(ACK)
+
+        # A frame with flat areas and some noise, as FrameCodec sees on a panel
+        width, height = 200, 60
+        frame = bytes(
+            (0x11 if (x // 8 + y // 4) % 2 else 0x23) if x < 60 else (x * 7 + y * 13) & 0xFF
+            for y in range(height) for x in range(width // 2))
+
+        # Python encoder, C++ decoder
+        client.upload(compress_frame(frame), width, height, LOOPBACK_COMPRESSED_FORMAT)
+        info, data = client.download()
+        assert info["encoding"] == RAW and data == frame, "compressed upload damaged"
+
+        # C++ encoder, Python decoder
+        info, data = client.download(encoding=COMPRESSED)
+        assert info["encoding"] == COMPRESSED and len(data) < len(frame)
+        assert decompress_frame(data) == frame, "compressed download damaged"
+        assert (info["width"], info["height"], info["size"]) == (width, height, len(frame))
+
+        # Raw both ways, over several UploadData frames
+        image = bytes(range(256)) * 40
+        client.upload(image, 320, 240, FORMATS["jpg"])
+        info, data = client.download()
+        assert data == image, "raw upload damaged"
+
+        client.exit()
+        assert device.wait(5) == 0, "loopback failed"
+    finally:
+        if device.poll() is None:
+            device.kill()
+    assert b"Link dropped 1 bad frames" in text, "device didn't notice the bad frame: %r" % bytes(text)
+    print("loopback selftest passed")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--port", help="serial port of the device")
+    parser.add_argument("-v", "--verbose", action="store_true", help="show device log output")
+    commands = parser.add_subparsers(dest="command", required=True)
+    commands.add_parser("ping", help="check the link")
+    upload = commands.add_parser("upload", help="render an image on the device")
+    upload.add_argument("file")
+    upload.add_argument("--format", choices=sorted(FORMATS), help="default jpg")
+    upload.add_argument("--width", type=int)
+    upload.add_argument("--height", type=int)
+    download = commands.add_parser("download", help="fetch the display buffer or a gallery frame")
+    download.add_argument("file", help="where to write the packed frame")
+    download.add_argument("--slot", type=int, help="gallery slot instead of the display buffer")
+    download.add_argument("--compressed", action="store_true", help="compress the display buffer for the transfer")
+    selftest_parser = commands.add_parser("selftest", help="test against a simulated device")
+    selftest_parser.add_argument("--loopback", help="pinky_link_loopback to test the C++ link against too")
+    args = parser.parse_args()
+
+    try:
+        if args.command == "selftest":
+            selftest()
+            if args.loopback:
+                selftest_loopback(args.loopback)
+            return 0
+        if not args.port:
+            parser.error("--port is needed")
+        run(args, Client(open_port(args.port), args.verbose))
+    except (LinkError, OSError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,186 @@
+// The device side of the binary link (UsbLink.hpp), on stdin and stdout,
+// for tools/pinky_link.py selftest to drive over a pty. It runs the same
+// UsbLink, LinkByteSource, LinkDownloadSink and FrameCodec code as the
+// firmware's link command, with a frame buffer in place of the panel:
+//
+//   Upload    keeps the data as the frame, expanding it with
+//             FrameDecodeSource first if the format is
+//             LoopbackCompressedFormat
+//   Download  sends the frame back, compressed with FrameEncoder if asked
+//
+// Like the device, it waits for a "link" line before starting, and prints
+// the number of bad frames it dropped when the host exits.
+//
+//   pinky_link_loopback
+
+#include "FrameCodec.hpp"
+#include "Image.hpp"
+#include "UsbLink.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Upload format that marks the data as FrameCodec compressed
+constexpr uint8_t LoopbackCompressedFormat = 0x80;
+
+struct LoopbackFrame
+{
+  std::vector<uint8_t> data;
+  int width = 0;
+  int height = 0;
+};
+
+static void sendText(const char* text)
+{
+  halSerialWrite((const uint8_t*)text, (uint32_t)strlen(text));
+}
+
+// The text command line, reduced to waiting for "link"
+static bool waitForLink()
+{
+  std::string line;
+  while (true)
+  {
+    int c = halSerialReadByte(LinkIdleTimeoutUs);
+    if (c < 0)
+    {
+      return false;
+    }
+    if (c == '\r' || c == '\n')
+    {
+      if (line == "link")
+      {
+        return true;
+      }
+      line.clear();
+    }
+    else
+    {
+      line += (char)c;
+    }
+  }
+}
+
+static void upload(UsbLink& link, LoopbackFrame& frame)
+{
+  const std::vector<uint8_t>& request = link.payload();
+  if (request.size() < 9)
+  {
+    link.sendError("Bad upload request");
+    return;
+  }
+  uint32_t size = getLE(&request[0], 4);
+  int width = (int)getLE(&request[4], 2);
+  int height = (int)getLE(&request[6], 2);
+  bool compressed = request[8] == LoopbackCompressedFormat;
+
+  LinkByteSource src(link, size);
+  std::vector<uint8_t> data;
+  bool ok;
+  if (compressed)
+  {
+    FrameDecodeSource decoded(src);
+    data.resize(decoded.remaining());
+    ok = readFully(decoded, data.data(), (uint32_t)data.size());
+  }
+  else
+  {
+    data.resize(size);
+    ok = readFully(src, data.data(), size);
+  }
+  src.discard();
+  if (src.failed())
+  {
+    link.sendError("Upload cut short");
+    return;
+  }
+  if (!ok)
+  {
+    link.sendError("Decode failed");
+    return;
+  }
+  frame = LoopbackFrame{std::move(data), width, height};
+  link.send(LinkFrame::Ack);
+}
+
+static void download(UsbLink& link, const LoopbackFrame& frame)
+{
+  const std::vector<uint8_t>& request = link.payload();
+  if (request.size() < 2 || request[1] > (uint8_t)FrameEncoding::Compressed)
+  {
+    link.sendError("Bad download request");
+    return;
+  }
+  if (request[0] != LinkDisplaySource)
+  {
+    link.sendError("Nothing in that gallery slot");
+    return;
+  }
+  FrameEncoding encoding = (FrameEncoding)request[1];
+  uint32_t size = (uint32_t)frame.data.size();
+
+  uint8_t info[10];
+  putLE(info, size, 4);
+  putLE(info + 4, frame.width, 2);
+  putLE(info + 6, frame.height, 2);
+  info[8] = (uint8_t)FrameLayout::Packed4Bit;
+  info[9] = (uint8_t)encoding;
+  link.send(LinkFrame::DownloadInfo, info, sizeof(info));
+
+  LinkDownloadSink sink(link);
+  if (encoding == FrameEncoding::Compressed)
+  {
+    FrameEncoder<LinkDownloadSink> encoder(sink, size, (uint32_t)(frame.width + 1) / 2);
+    encoder.write(frame.data.data(), size);
+    encoder.finish();
+  }
+  else
+  {
+    sink.write(frame.data.data(), size);
+  }
+  sink.finish();
+}
+
+int main()
+{
+  if (!waitForLink())
+  {
+    fprintf(stderr, "No link command\n");
+    return 1;
+  }
+
+  UsbLink link;
+  LoopbackFrame frame;
+  link.send(LinkFrame::Ack, &LinkVersion, 1);
+  LinkFrame type;
+  while (link.receive(type))
+  {
+    switch (type)
+    {
+      case LinkFrame::Hello:
+        link.send(LinkFrame::Ack, &LinkVersion, 1);
+        break;
+      case LinkFrame::Upload:
+        upload(link, frame);
+        break;
+      case LinkFrame::Download:
+        download(link, frame);
+        break;
+      case LinkFrame::Exit:
+      {
+        char text[64];
+        snprintf(text, sizeof(text), "Link dropped %u bad frames\r\n", (unsigned)link.badFrames());
+        sendText(text);
+        link.send(LinkFrame::Ack);
+        return 0;
+      }
+      default:
+        link.sendError("Unexpected frame");
+        break;
+    }
+  }
+  fprintf(stderr, "Link went quiet\n");
+  return 1;
+}
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Expand the binary Log frames of the pinky deferred log (src/DeferredLog.hpp).
+
+With the logbinary property set, the device sends what the snap path logged
+as Log link frames of message ids and integer arguments instead of text.
+This reads them from a capture of the serial output or live from the port,
+formats each entry with the message list in src/DeferredLog.hpp, and passes
+any other text through as it is.
+
+    pinky_log.py capture.bin
+    pinky_log.py --port /dev/ttyACM0
+    pinky_log.py --selftest
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+from pinky_link import Link, LinkError, encode_frame, open_port
+
+LOG = 0x30
+
+MESSAGES_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "DeferredLog.hpp")
+
+CONVERSION = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z)?([diuxXoc%])")
+
+
+def load_messages(path=MESSAGES_PATH):
+    """The printf formats of PINKY_LOG_MESSAGES, in id order"""
+    with open(path) as f:
+        text = f.read()
+    start = text.index("#define PINKY_LOG_MESSAGES")
+    end = text.index("\n\n", start)
+    return [bytes(format, "ascii").decode("unicode_escape")
+            for _, format in re.findall(r'X\((\w+), "((?:[^"\\]|\\.)*)"\)', text[start:end])]
+
+
+def format_message(format, args):
+    """printf the way the device would, with every argument a uint32"""
+    args = list(args) + [0] * 4
+
+    def convert(match):
+        spec = match.group(0)
+        kind = match.group(1)
+        if kind == "%":
+            return "%"
+        value = args.pop(0)
+        if kind in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            kind = "d"
+        elif kind == "u":
+            kind = "d"
+        spec = re.sub(r"(hh|h|ll|l|z)?[diuxXoc]$", kind, spec)
+        return spec % value
+
+    return CONVERSION.sub(convert, format)
+
+
+def decode_log_frame(payload):
+    """The dropped count and (timeUs, message, core, args) of each entry"""
+    (dropped,) = struct.unpack_from("<I", payload, 0)
+    entries = []
+    pos = 4
+    while pos + 8 <= len(payload):
+        time_us, message, core, count = struct.unpack_from("<IHBB", payload, pos)
+        pos += 8
+        args = struct.unpack_from("<%dI" % count, payload, pos)
+        pos += 4 * count
+        entries.append((time_us, message, core, args))
+    return dropped, entries
+
+
+class LogPrinter:
+    def __init__(self, messages, out=sys.stdout):
+        self.messages = messages
+        self.out = out
+        self.dropped = 0
+
+    def text(self, data):
+        self.out.write(data.decode(errors="replace"))
+
+    def frame(self, payload):
+        dropped, entries = decode_log_frame(payload)
+        for time_us, message, core, args in entries:
+            if message < len(self.messages):
+                text = format_message(self.messages[message], args)
+            else:
+                text = "Unknown log message %d %s" % (message, list(args))
+            self.out.write("[%d.%03d core%d] %s\n" % (time_us // 1000, time_us % 1000, core, text))
+        if dropped != self.dropped:
+            self.out.write("Log dropped %d messages so far\n" % dropped)
+            self.dropped = dropped
+
+
+def follow(fd, printer, timeout):
+    link = Link(fd, on_text=printer.text)
+    while True:
+        try:
+            frame_type, payload = link.receive(timeout)
+        except LinkError:
+            # Whatever is left over was text
+            printer.text(bytes(link.buffer))
+            return
+        if frame_type == LOG:
+            printer.frame(payload)
+
+
+def log_frame(dropped, entries):
+    payload = struct.pack("<I", dropped)
+    for time_us, message, core, args in entries:
+        payload += struct.pack("<IHBB%dI" % len(args), time_us, message, core, len(args), *args)
+    return encode_frame(LOG, payload)
+
+
+def selftest():
+    messages = load_messages()
+    assert messages, "can't read the message list"
+    index = {format: i for i, format in enumerate(messages)}
+    bad_size = index["Bad image size! Got %u bytes, expected %u bytes"]
+    header = index["JPEG header error: %d"]
+    strips = index["Decoding JPG on %d cores: %d strips of %d MCU rows"]
+
+    capture = (b"Set aside 176128 bytes of decode scratch\r\n"
+               + log_frame(0, [(1500, bad_size, 0, (100, 153600)), (2250, header, 1, (0xFFFFFFFF,))])
+               + b"PK not a frame\r\n"
+               + log_frame(3, [(12345678, strips, 0, (2, 30, 1))]))
+    read_fd, write_fd = os.pipe()
+    os.write(write_fd, capture)
+    os.close(write_fd)
+
+    class Capture:
+        def __init__(self):
+            self.text = ""
+
+        def write(self, text):
+            self.text += text
+
+    out = Capture()
+    follow(read_fd, LogPrinter(messages, out), 0.5)
+    expected = ("Set aside 176128 bytes of decode scratch\r\n"
+                "[1.500 core0] Bad image size! Got 100 bytes, expected 153600 bytes\n"
+                "[2.250 core1] JPEG header error: -1\n"
+                "PK not a frame\r\n"
+                "[12345.678 core0] Decoding JPG on 2 cores: 30 strips of 1 MCU rows\n"
+                "Log dropped 3 messages so far\n")
+    assert out.text == expected, "got:\n" + out.text
+    print("selftest passed (%d messages known)" % len(messages))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("file", nargs="?", help="captured serial output")
+    parser.add_argument("--port", help="serial port of the device")
+    parser.add_argument("--messages", default=MESSAGES_PATH, help="DeferredLog.hpp to take the messages from")
+    parser.add_argument("--selftest", action="store_true", help="check the decoder against a made up capture")
+    args = parser.parse_args()
+
+    if args.selftest:
+        selftest()
+        return 0
+    if bool(args.file) == bool(args.port):
+        parser.error("give a file or --port")
+    try:
+        printer = LogPrinter(load_messages(args.messages))
+        if args.port:
+            fd = open_port(args.port)
+            while True:
+                follow(fd, printer, 60.0)
+        else:
+            fd = os.open(args.file, os.O_RDONLY)
+            follow(fd, printer, 0.1)
+    except (OSError, ValueError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
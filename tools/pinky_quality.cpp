@@ -0,0 +1,615 @@
+// Measures what each decode and dither configuration costs in picture
+// quality, against how long it takes, so a change made for speed can be
+// accepted or rejected on data:
+//
+//   pinky_quality [--panel e673 ...] [--effect None ...] [--blur N] [--runs N]
+//                 [--csv results.csv] photo.jpg photos/ ...
+//
+// Each reference JPEG is put through every configuration for each panel
+// (uc8159 and e673 by default, whose palettes are measured off real
+// panels), and what the panel would show, in its own palette, is compared
+// with the source. Both are blurred first (--blur passes of a [1 2 1]
+// filter, 2 by default) since dithering is meant to be seen from a
+// distance, then the deltaE of each pixel is taken. Images are centered
+// and cropped as on the device, and only the part the source covers
+// counts.
+//
+// A configuration is the input path (jpeg-rgb: RGB converted to Lab per
+// pixel in the dither, jpeg-lab: converted by the decoder's lookup tables,
+// yuyv and rgb565: the reference as raw captures of that format, luma: the
+// monochrome path) and a dither accuracy, 0 being no error diffusion at
+// all. The time is the host's for decoding and dithering one frame,
+// fastest of --runs. The summary averages each configuration over the
+// corpus and marks the Pareto front: those that no other is both faster
+// and closer than.
+
+#include "ColorMapEffect.hpp"
+#include "DeferredLog.hpp"
+#include "ImageConvert.hpp"
+#include "ImageDecode.hpp"
+#include "ImageEffect.hpp"
+#include "InkyPalettes.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct Panel
+{
+  const char* name;
+  int width;
+  int height;
+  ColorCapability capability;
+  FrameLayout layout;
+};
+
+const Panel Panels[] =
+{
+  {"uc8159", 600, 448, ColorCapability::SevenColor, FrameLayout::Packed4Bit},
+  {"uc8159-640", 640, 400, ColorCapability::SevenColor, FrameLayout::Packed4Bit},
+  {"e673", 800, 480, ColorCapability::Spectra6, FrameLayout::Packed4Bit},
+  {"ssd1683", 400, 300, ColorCapability::BlackWhite, FrameLayout::TwoPlaneBinary},
+  {"ssd1683-red", 400, 300, ColorCapability::BlackWhiteRed, FrameLayout::TwoPlaneBinary},
+  {"ssd1683-yellow", 400, 300, ColorCapability::BlackWhiteYellow, FrameLayout::TwoPlaneBinary},
+};
+
+enum class InputPath : uint8_t
+{
+  JpegRgb,
+  JpegLab,
+  Yuyv,
+  Rgb565,
+  Luma
+};
+
+const char* inputPathName(InputPath path)
+{
+  switch (path)
+  {
+    case InputPath::JpegRgb: return "jpeg-rgb";
+    case InputPath::JpegLab: return "jpeg-lab";
+    case InputPath::Yuyv: return "yuyv";
+    case InputPath::Rgb565: return "rgb565";
+    default: return "luma";
+  }
+}
+
+const float DitherAccuracies[] = {0.0f, 0.5f, 0.7f, 0.95f, 1.0f};
+
+struct Options
+{
+  std::vector<const Panel*> panels;
+  std::vector<ColorMapEffect> effects;
+  int blur = 2;
+  int runs = 3;
+  fs::path csvPath;
+  std::vector<fs::path> inputs;
+};
+
+// A reference image, and the raw captures made from it
+struct Reference
+{
+  std::string name;
+  std::vector<uint8_t> jpeg;
+  int width = 0;
+  int height = 0;
+  std::vector<RGBColor> rgb;
+  std::vector<uint8_t> yuyv;
+  std::vector<uint8_t> rgb565;
+};
+
+// deltaE over one image, and how long it took
+struct Score
+{
+  double mean = 0.0;
+  double p50 = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+  double ms = 0.0;
+};
+
+// A panel's frame buffer, either kind
+struct PanelFrame
+{
+  std::shared_ptr<ImageView<IndexedColor>> view;
+  IndexedColor border;
+};
+
+std::shared_ptr<IndexedColorMap> panelColorMap(const Panel& panel)
+{
+  switch (panel.capability)
+  {
+    case ColorCapability::SevenColor:
+      return inkyUC8159ColorMap();
+    case ColorCapability::Spectra6:
+      return inkyE673ColorMap();
+    default:
+      return inkySSD1683ColorMap(panel.capability);
+  }
+}
+
+PanelFrame makePanelFrame(const Panel& panel, const IndexedColorMap& panelMap)
+{
+  PanelFrame frame;
+  frame.border = panelMap.toIndexedColor(ColorName::Black);
+  if (panel.layout == FrameLayout::Packed4Bit)
+  {
+    frame.view = std::make_shared<Packed4BitIndexedImage>(panel.width, panel.height);
+  }
+  else
+  {
+    frame.view = inkySSD1683Frame(panel.width, panel.height, panelMap, panel.capability);
+  }
+  return frame;
+}
+
+// Inky::clear()
+void clearFrame(PanelFrame& frame)
+{
+  ImageView<IndexedColor>& view = *frame.view;
+  for (int y=0; y < view.height; ++y)
+  {
+    for (int x=0; x < view.width; ++x)
+    {
+      view.setPixel(x, y, frame.border);
+    }
+  }
+}
+
+// What the decoders logged since the last call, on one line. None of it
+// belongs in the tables, but it says why a run failed.
+std::string drainLog()
+{
+  std::string text;
+  DeferredLog::drain([&](const LogEntry& entry)
+  {
+    char line[128];
+    formatLogEntry(entry, line, sizeof(line));
+    text += (text.empty() ? "" : "; ") + std::string(line);
+  });
+  return text;
+}
+
+// The reference decoded once, and as the camera's raw formats would carry
+// it (BT.601 full range YUYV, as the bench command makes it)
+bool loadReference(const fs::path& path, Reference& ref)
+{
+  std::ifstream in(path, std::ios::binary);
+  ref.name = path.stem().string();
+  ref.jpeg.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  if (ref.jpeg.empty() || !jpegDimensions(ref.jpeg.data(), ref.jpeg.size(), ref.width, ref.height))
+  {
+    std::cerr << path.string() << ": not a JPEG" << std::endl;
+    return false;
+  }
+
+  Image<RGBColor> image(ref.width, ref.height);
+  MemoryByteSource src(ref.jpeg.data(), (uint32_t)ref.jpeg.size());
+  if (!decodeImageJPG(ref.width, ref.height, src, image))
+  {
+    std::cerr << path.string() << ": decode failed: " << drainLog() << std::endl;
+    return false;
+  }
+
+  ref.rgb.resize(ref.width * ref.height);
+  ref.yuyv.resize(ref.width * ref.height * 2);
+  ref.rgb565.resize(ref.width * ref.height * 2);
+  for (int y=0; y < ref.height; ++y)
+  {
+    for (int x=0; x < ref.width; ++x)
+    {
+      int i = y * ref.width + x;
+      RGBColor c = image.getPixel(x, y);
+      ref.rgb[i] = c;
+      uint8_t* p = ref.yuyv.data() + i * 2;
+      p[0] = (uint8_t)std::clamp((77 * c.R + 150 * c.G + 29 * c.B) >> 8, 0, 255);
+      p[1] = (x % 2 == 0) ? (uint8_t)std::clamp(((-43 * c.R - 85 * c.G + 128 * c.B) >> 8) + 128, 0, 255)
+                          : (uint8_t)std::clamp(((128 * c.R - 107 * c.G - 21 * c.B) >> 8) + 128, 0, 255);
+      uint16_t rgb565 = (uint16_t)(((c.R >> 3) << 11) | ((c.G >> 2) << 5) | (c.B >> 3));
+      memcpy(ref.rgb565.data() + i * 2, &rgb565, 2);
+    }
+  }
+  return true;
+}
+
+// Decode and dither the reference into frame one way
+bool render(const Reference& ref, InputPath path, float accuracy, PanelFrame& frame, const IndexedColorMap& colorMap)
+{
+  ImageView<IndexedColor>& display = *frame.view;
+  MemoryByteSource jpeg(ref.jpeg.data(), (uint32_t)ref.jpeg.size());
+  switch (path)
+  {
+    case InputPath::JpegRgb:
+    {
+      LabDitherView buffer(display, colorMap);
+      buffer.ditherAccuracy = accuracy;
+      AlignCenterView centered(buffer, ref.width, ref.height);
+      return decodeImageJPG(ref.width, ref.height, jpeg, centered);
+    }
+    case InputPath::JpegLab:
+    {
+      LabInputDitherView buffer(display, colorMap);
+      buffer.ditherAccuracy = accuracy;
+      AlignCenterView centered(buffer, ref.width, ref.height);
+      return decodeImageJPG(ref.width, ref.height, jpeg, centered);
+    }
+    case InputPath::Yuyv:
+    {
+      MemoryByteSource src(ref.yuyv.data(), (uint32_t)ref.yuyv.size());
+      LabInputDitherView buffer(display, colorMap);
+      buffer.ditherAccuracy = accuracy;
+      AlignCenterView centered(buffer, ref.width, ref.height);
+      return decodeImageYUYV(ref.width, ref.height, src, centered);
+    }
+    case InputPath::Rgb565:
+    {
+      MemoryByteSource src(ref.rgb565.data(), (uint32_t)ref.rgb565.size());
+      LabInputDitherView buffer(display, colorMap);
+      buffer.ditherAccuracy = accuracy;
+      AlignCenterView centered(buffer, ref.width, ref.height);
+      return decodeImageRGB565(ref.width, ref.height, src, centered);
+    }
+    case InputPath::Luma:
+    {
+      LumaDitherView buffer(display, colorMap);
+      buffer.ditherAccuracy = accuracy;
+      AlignCenterView centered(buffer, ref.width, ref.height);
+      return decodeImageJPG(ref.width, ref.height, jpeg, centered);
+    }
+  }
+  return false;
+}
+
+// passes of a [1 2 1] / 4 filter each way, edges clamped
+void blur(std::vector<LabColor>& image, int width, int height, int passes)
+{
+  std::vector<LabColor> line(std::max(width, height));
+  auto filter = [&](LabColor* first, int count, int stride)
+  {
+    for (int i=0; i < count; ++i)
+    {
+      line[i] = first[i * stride];
+    }
+    for (int i=0; i < count; ++i)
+    {
+      const LabColor& a = line[std::max(i - 1, 0)];
+      const LabColor& b = line[i];
+      const LabColor& c = line[std::min(i + 1, count - 1)];
+      first[i * stride] = LabColor{(a.L + 2 * b.L + c.L) / 4, (a.a + 2 * b.a + c.a) / 4, (a.b + 2 * b.b + c.b) / 4};
+    }
+  };
+  for (int pass=0; pass < passes; ++pass)
+  {
+    for (int y=0; y < height; ++y)
+    {
+      filter(image.data() + y * width, width, 1);
+    }
+    for (int x=0; x < width; ++x)
+    {
+      filter(image.data() + x, height, width);
+    }
+  }
+}
+
+// The part of the display the reference covers, from the source and as the
+// panel shows it, compared after blurring
+Score scoreFrame(const Reference& ref, const PanelFrame& frame, const IndexedColorMap& panelMap, int blurPasses)
+{
+  const ImageView<IndexedColor>& display = *frame.view;
+  int dx = (display.width - ref.width) / 2;
+  int dy = (display.height - ref.height) / 2;
+  int x0 = std::max(dx, 0);
+  int y0 = std::max(dy, 0);
+  int width = std::min(display.width, dx + ref.width) - x0;
+  int height = std::min(display.height, dy + ref.height) - y0;
+
+  std::vector<LabColor> source(width * height);
+  std::vector<LabColor> shown(width * height);
+  for (int y=0; y < height; ++y)
+  {
+    for (int x=0; x < width; ++x)
+    {
+      source[y * width + x] = ref.rgb[(y0 + y - dy) * ref.width + (x0 + x - dx)].toLab();
+      shown[y * width + x] = panelMap.toLabColor(display.getPixel(x0 + x, y0 + y));
+    }
+  }
+  blur(source, width, height, blurPasses);
+  blur(shown, width, height, blurPasses);
+
+  std::vector<float> deltaE(width * height);
+  double sum = 0.0;
+  for (size_t i=0; i < deltaE.size(); ++i)
+  {
+    deltaE[i] = source[i].deltaE(shown[i]);
+    sum += deltaE[i];
+  }
+  std::sort(deltaE.begin(), deltaE.end());
+  auto percentile = [&](double p) { return (double)deltaE[std::min(deltaE.size() - 1, (size_t)(p * deltaE.size()))]; };
+
+  Score score;
+  score.mean = sum / std::max<size_t>(deltaE.size(), 1);
+  score.p50 = percentile(0.50);
+  score.p95 = percentile(0.95);
+  score.p99 = percentile(0.99);
+  return score;
+}
+
+struct Summary
+{
+  std::string config;
+  Score score;
+  int images = 0;
+  bool pareto = false;
+};
+
+// Averages over the corpus, fastest first, with the Pareto front marked
+void printSummary(const std::string& title, std::vector<Summary>& summaries)
+{
+  for (Summary& s : summaries)
+  {
+    s.score.mean /= s.images;
+    s.score.p50 /= s.images;
+    s.score.p95 /= s.images;
+    s.score.p99 /= s.images;
+    s.score.ms /= s.images;
+  }
+  for (Summary& s : summaries)
+  {
+    s.pareto = std::none_of(summaries.begin(), summaries.end(), [&](const Summary& other)
+    {
+      return other.score.ms <= s.score.ms && other.score.mean <= s.score.mean &&
+             (other.score.ms < s.score.ms || other.score.mean < s.score.mean);
+    });
+  }
+  std::sort(summaries.begin(), summaries.end(), [](const Summary& a, const Summary& b) { return a.score.ms < b.score.ms; });
+
+  std::cout << title << std::endl;
+  std::cout << "    " << std::left << std::setw(32) << "config" << std::right << std::setw(10) << "ms/frame"
+            << std::setw(10) << "mean dE" << std::setw(8) << "p50" << std::setw(8) << "p95" << std::setw(8) << "p99" << std::endl;
+  for (const Summary& s : summaries)
+  {
+    std::cout << "  " << (s.pareto ? "* " : "  ") << std::left << std::setw(32) << s.config << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10) << s.score.ms << std::setprecision(2) << std::setw(10) << s.score.mean
+              << std::setw(8) << s.score.p50 << std::setw(8) << s.score.p95 << std::setw(8) << s.score.p99 << std::defaultfloat << std::endl;
+  }
+}
+
+bool isJpeg(const fs::path& path)
+{
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  return ext == ".jpg" || ext == ".jpeg";
+}
+
+void usage()
+{
+  std::cerr << "usage: pinky_quality [--panel NAME ...] [--effect NAME|all ...] [--blur N] [--runs N] [--csv FILE] INPUT..." << std::endl;
+  std::cerr << "  INPUT is a JPEG or a directory of them" << std::endl;
+  std::cerr << "  panels:";
+  for (const Panel& panel : Panels)
+  {
+    std::cerr << " " << panel.name;
+  }
+  std::cerr << std::endl;
+}
+
+bool parseArgs(int argc, char** argv, Options& options)
+{
+  for (int i=1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--panel" && hasValue)
+    {
+      std::string name = argv[++i];
+      const Panel* found = nullptr;
+      for (const Panel& panel : Panels)
+      {
+        found = name == panel.name ? &panel : found;
+      }
+      if (!found)
+      {
+        std::cerr << "Unknown panel " << name << std::endl;
+        return false;
+      }
+      options.panels.push_back(found);
+    }
+    else if (arg == "--effect" && hasValue)
+    {
+      std::string name = argv[++i];
+      if (name == "all")
+      {
+        for (ColorMapEffect effect : magic_enum::enum_values<ColorMapEffect>())
+        {
+          options.effects.push_back(effect);
+        }
+        continue;
+      }
+      std::optional<ColorMapEffect> effect = magic_enum::enum_cast<ColorMapEffect>(name, magic_enum::case_insensitive);
+      if (!effect)
+      {
+        std::cerr << "Unknown effect " << name << std::endl;
+        return false;
+      }
+      options.effects.push_back(effect.value());
+    }
+    else if (arg == "--blur" && hasValue)
+    {
+      options.blur = std::max(atoi(argv[++i]), 0);
+    }
+    else if (arg == "--runs" && hasValue)
+    {
+      options.runs = std::max(atoi(argv[++i]), 1);
+    }
+    else if (arg == "--csv" && hasValue)
+    {
+      options.csvPath = argv[++i];
+    }
+    else if (!arg.empty() && arg[0] != '-')
+    {
+      options.inputs.push_back(arg);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return !options.inputs.empty();
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!parseArgs(argc, argv, options))
+  {
+    usage();
+    return 2;
+  }
+  if (options.panels.empty())
+  {
+    options.panels = {&Panels[0], &Panels[2]};
+  }
+  if (options.effects.empty())
+  {
+    options.effects = {ColorMapEffect::None};
+  }
+
+  std::vector<fs::path> files;
+  for (const fs::path& input : options.inputs)
+  {
+    std::error_code error;
+    if (fs::is_directory(input, error))
+    {
+      for (const fs::directory_entry& entry : fs::directory_iterator(input, error))
+      {
+        if (entry.is_regular_file() && isJpeg(entry.path()))
+        {
+          files.push_back(entry.path());
+        }
+      }
+    }
+    else
+    {
+      files.push_back(input);
+    }
+  }
+  std::sort(files.begin(), files.end());
+
+  std::vector<Reference> corpus;
+  for (const fs::path& file : files)
+  {
+    Reference ref;
+    if (loadReference(file, ref))
+    {
+      corpus.push_back(std::move(ref));
+    }
+    drainLog();
+  }
+  if (corpus.empty())
+  {
+    return 1;
+  }
+
+  std::ofstream csv;
+  if (!options.csvPath.empty())
+  {
+    csv.open(options.csvPath);
+    csv << "panel,effect,config,image,mean,p50,p95,p99,ms" << std::endl;
+  }
+
+  int failed = 0;
+  for (const Panel* panel : options.panels)
+  {
+    std::shared_ptr<IndexedColorMap> panelMap = panelColorMap(*panel);
+    PanelFrame frame = makePanelFrame(*panel, *panelMap);
+
+    for (ColorMapEffect effect : options.effects)
+    {
+      // Same as the effect command: an effect the panel can't do leaves
+      // the panel's own map in place, so there's nothing new to measure
+      std::shared_ptr<IndexedColorMap> effectMap = getColorMapWithEffect(*panelMap, effect);
+      if (effect != ColorMapEffect::None && !effectMap)
+      {
+        continue;
+      }
+      const IndexedColorMap& colorMap = effectMap ? *effectMap : *panelMap;
+      std::string effectName(magic_enum::enum_name(effect));
+
+      std::vector<InputPath> paths = {InputPath::JpegRgb, InputPath::JpegLab, InputPath::Yuyv, InputPath::Rgb565};
+      if (colorMap.isMonochrome())
+      {
+        paths.push_back(InputPath::Luma);
+      }
+
+      std::vector<Summary> summaries;
+      for (InputPath path : paths)
+      {
+        for (float accuracy : DitherAccuracies)
+        {
+          std::ostringstream config;
+          config << inputPathName(path) << "/" << accuracy;
+          Summary summary;
+          summary.config = config.str();
+
+          for (const Reference& ref : corpus)
+          {
+            double bestMs = 1e30;
+            bool ok = true;
+            for (int run=0; run < options.runs && ok; ++run)
+            {
+              clearFrame(frame);
+              auto start = std::chrono::steady_clock::now();
+              ok = render(ref, path, accuracy, frame, colorMap);
+              bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            }
+            std::string log = drainLog();
+            if (!ok)
+            {
+              std::cerr << ref.name << ": " << summary.config << " failed on " << panel->name << ": " << log << std::endl;
+              ++failed;
+              continue;
+            }
+
+            Score score = scoreFrame(ref, frame, *panelMap, options.blur);
+            score.ms = bestMs;
+            summary.score.mean += score.mean;
+            summary.score.p50 += score.p50;
+            summary.score.p95 += score.p95;
+            summary.score.p99 += score.p99;
+            summary.score.ms += score.ms;
+            ++summary.images;
+            if (csv.is_open())
+            {
+              csv << panel->name << "," << effectName << "," << summary.config << "," << ref.name << "," << score.mean << ","
+                  << score.p50 << "," << score.p95 << "," << score.p99 << "," << score.ms << std::endl;
+            }
+          }
+          if (summary.images > 0)
+          {
+            summaries.push_back(summary);
+          }
+        }
+      }
+
+      std::ostringstream title;
+      title << panel->name << ", " << effectName << ", " << corpus.size() << " images, deltaE after " << options.blur
+            << " blur passes (* is the Pareto front):";
+      printSummary(title.str(), summaries);
+      std::cout << std::endl;
+    }
+  }
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,437 @@
+// Runs the firmware's snap path on the host against a simulated board: the
+// Inky driver talks to a simulated panel controller and EEPROM over the
+// HAL (Hal.hpp), and pictures come from files through a replay camera.
+//
+//   pinky_sim --panel e673 [--effect Saturated] [--dither 0.95]
+//             [--format jpg|yuv|rgb565 --size WxH] [--no-downsample]
+//             [--heap KB] [--cpu-scale X] [--refresh-ms MS] [--spool]
+//             [--trace trace.txt] [--stats] [-o outdir] photo.jpg capture.yuv ...
+//   pinky_sim --panel e673 --cpu-scale X --bench all
+//
+// Each refresh the panel sees is written to outdir/<name>.png in the
+// panel's colors. Alongside it comes the modeled on-device latency of the
+// snap, split into camera, SPI, sleeping/BUSY and I2C time, and the longest
+// it went without yielding to the main loop's tasks. Computation is
+// only modeled when --cpu-scale gives how many times slower the device is
+// than this host, so the figures are a floor, not a measurement. --trace
+// writes the timing spans as the trace command prints them, for
+// tools/trace2chrome.py. --stats prints the stats command's throughput
+// figures for the snaps at the end. --spool copies each capture out of the
+// camera before decoding it, as the firmware's spool property does, into
+// RAM standing in for flash. --bench runs the bench command's stages
+// instead of snapping, which only times computation with --cpu-scale.
+
+#include "Bench.hpp"
+#include "ColorMapEffect.hpp"
+#include "DeferredLog.hpp"
+#include "ImageDecode.hpp"
+#include "Inky.hpp"
+#include "MemWatch.hpp"
+#include "PhotoPipeline.hpp"
+#include "ReplayCamera.hpp"
+#include "Scheduler.hpp"
+#include "SimInky.hpp"
+#include "Stats.hpp"
+#include "Trace.hpp"
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Count allocations the way the firmware's wrapped operator new does, so
+// the AllocationGuard around each snap works here too
+void* operator new(size_t size)
+{
+  void* ptr = malloc(size);
+  if (!ptr)
+  {
+    throw std::bad_alloc();
+  }
+  MemWatch::noteAlloc(size, __builtin_return_address(0));
+  return ptr;
+}
+
+void* operator new[](size_t size)
+{
+  void* ptr = malloc(size);
+  if (!ptr)
+  {
+    throw std::bad_alloc();
+  }
+  MemWatch::noteAlloc(size, __builtin_return_address(0));
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  if (ptr)
+  {
+    MemWatch::noteFree();
+  }
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+  operator delete(ptr);
+}
+
+struct Panel
+{
+  const char* name;
+  DisplayVariant variant;
+};
+
+const Panel Panels[] =
+{
+  {"uc8159", DisplayVariant::Seven_Colour_UC8159},
+  {"uc8159-640", DisplayVariant::Seven_Colour_640x400_UC8159},
+  {"e673", DisplayVariant::Spectra_6_7_3_800x480_E673},
+  {"ssd1683", DisplayVariant::Black_wHAT_SSD1683},
+  {"ssd1683-red", DisplayVariant::Red_wHAT_SSD1683},
+  {"ssd1683-yellow", DisplayVariant::Yellow_wHAT_SSD1683},
+};
+
+struct Options
+{
+  const Panel* panel = nullptr;
+  ColorMapEffect effect = ColorMapEffect::None;
+  float ditherAccuracy = 0.95f;
+  std::optional<CaptureFormat> format;
+  int width = 0;
+  int height = 0;
+  bool yuvDownsample = true;
+  uint32_t heapKB = 0;
+  double cpuScale = 0.0;
+  uint32_t refreshMs = 0;
+  bool spool = false;
+  fs::path tracePath;
+  bool stats = false;
+  std::string bench;
+  fs::path outDir = ".";
+  std::vector<fs::path> inputs;
+};
+
+// JPEGs by extension, anything else needs --format and --size
+bool loadPicture(const fs::path& path, const Options& options, ReplayCamera::Picture& picture)
+{
+  std::ifstream in(path, std::ios::binary);
+  picture.name = path.stem().string();
+  picture.data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  if (picture.data.empty())
+  {
+    std::cerr << path.string() << ": can't read" << std::endl;
+    return false;
+  }
+
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+  picture.format = options.format.value_or(ext == ".jpg" || ext == ".jpeg" ? CaptureFormat::JPG : CaptureFormat::YUV);
+  if (picture.format == CaptureFormat::JPG)
+  {
+    if (!jpegDimensions(picture.data.data(), picture.data.size(), picture.width, picture.height))
+    {
+      std::cerr << path.string() << ": not a JPEG" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  picture.width = options.width;
+  picture.height = options.height;
+  if ((size_t)picture.width * picture.height * 2 != picture.data.size())
+  {
+    std::cerr << path.string() << ": " << picture.data.size() << " bytes is not a " << picture.width << "x" << picture.height << " capture (--size)" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+double ms(uint64_t us)
+{
+  return us / 1000.0;
+}
+
+void usage()
+{
+  std::cerr << "usage: pinky_sim --panel NAME [--effect NAME] [--dither 0.0-1.0] [--format jpg|yuv|rgb565] [--size WxH]" << std::endl;
+  std::cerr << "                 [--no-downsample] [--heap KB] [--cpu-scale X] [--refresh-ms MS] [--spool] [--trace FILE] [--stats] [-o DIR] INPUT..." << std::endl;
+  std::cerr << "       pinky_sim --panel NAME [--cpu-scale X] --bench STAGES" << std::endl;
+  std::cerr << "  INPUT is a JPEG, or a raw capture in --format at --size" << std::endl;
+  std::cerr << "  panels:";
+  for (const Panel& panel : Panels)
+  {
+    std::cerr << " " << panel.name;
+  }
+  std::cerr << std::endl;
+}
+
+bool parseArgs(int argc, char** argv, Options& options)
+{
+  for (int i=1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--panel" && hasValue)
+    {
+      std::string name = argv[++i];
+      for (const Panel& panel : Panels)
+      {
+        options.panel = name == panel.name ? &panel : options.panel;
+      }
+      if (!options.panel)
+      {
+        std::cerr << "Unknown panel " << name << std::endl;
+        return false;
+      }
+    }
+    else if (arg == "--effect" && hasValue)
+    {
+      std::string name = argv[++i];
+      std::optional<ColorMapEffect> effect = magic_enum::enum_cast<ColorMapEffect>(name, magic_enum::case_insensitive);
+      if (!effect)
+      {
+        effect = magic_enum::enum_cast<ColorMapEffect>(atoi(name.c_str()));
+      }
+      if (!effect)
+      {
+        std::cerr << "Unknown effect " << name << std::endl;
+        return false;
+      }
+      options.effect = effect.value();
+    }
+    else if (arg == "--dither" && hasValue)
+    {
+      options.ditherAccuracy = std::clamp((float)atof(argv[++i]), 0.0f, 1.0f);
+    }
+    else if (arg == "--format" && hasValue)
+    {
+      std::string name = argv[++i];
+      options.format = magic_enum::enum_cast<CaptureFormat>(name, magic_enum::case_insensitive);
+      if (!options.format)
+      {
+        std::cerr << "Unknown format " << name << std::endl;
+        return false;
+      }
+    }
+    else if (arg == "--size" && hasValue)
+    {
+      if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2)
+      {
+        return false;
+      }
+    }
+    else if (arg == "--no-downsample")
+    {
+      options.yuvDownsample = false;
+    }
+    else if (arg == "--heap" && hasValue)
+    {
+      options.heapKB = atoi(argv[++i]);
+    }
+    else if (arg == "--cpu-scale" && hasValue)
+    {
+      options.cpuScale = atof(argv[++i]);
+    }
+    else if (arg == "--refresh-ms" && hasValue)
+    {
+      options.refreshMs = atoi(argv[++i]);
+    }
+    else if (arg == "--spool")
+    {
+      options.spool = true;
+    }
+    else if (arg == "--trace" && hasValue)
+    {
+      options.tracePath = argv[++i];
+    }
+    else if (arg == "--stats")
+    {
+      options.stats = true;
+    }
+    else if (arg == "--bench" && hasValue)
+    {
+      options.bench = argv[++i];
+    }
+    else if (arg == "-o" && hasValue)
+    {
+      options.outDir = argv[++i];
+    }
+    else if (!arg.empty() && arg[0] != '-')
+    {
+      options.inputs.push_back(arg);
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return options.panel && (!options.inputs.empty() || !options.bench.empty());
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+  if (!parseArgs(argc, argv, options))
+  {
+    usage();
+    return 2;
+  }
+
+  ReplayCamera camera;
+  int loaded = 0;
+  size_t largest = 0;
+  for (const fs::path& input : options.inputs)
+  {
+    ReplayCamera::Picture picture;
+    if (loadPicture(input, options, picture))
+    {
+      largest = std::max(largest, picture.data.size());
+      camera.add(std::move(picture));
+      ++loaded;
+    }
+  }
+  if (loaded == 0 && options.bench.empty())
+  {
+    return 1;
+  }
+  fs::create_directories(options.outDir);
+
+  SimBoard& board = SimBoard::instance();
+  board.clock.cpuScale = options.cpuScale;
+  board.freeHeap = options.heapKB > 0 ? options.heapKB * 1024 : board.freeHeap;
+  Trace::enabled = !options.tracePath.empty();
+
+  SimInky panel(options.panel->variant);
+  panel.timing.refreshMs = options.refreshMs > 0 ? options.refreshMs : panel.timing.refreshMs;
+
+  // Same start up as the firmware: the driver comes from the EEPROM
+  std::unique_ptr<Inky> inky = InkyCreate();
+  if (!inky)
+  {
+    std::cerr << "No display" << std::endl;
+    return 1;
+  }
+
+  PhotoPipeline pipeline(*inky);
+  pipeline.ditherAccuracy = options.ditherAccuracy;
+  pipeline.yuvDownsample = options.yuvDownsample;
+  pipeline.specialColorMap = getColorMapWithEffect(inky->colorMap(), options.effect);
+
+  // The firmware spools to flash, this to RAM set aside up front. Both
+  // yield a sector at a time.
+  std::vector<uint8_t> spool(largest);
+  MemoryByteSource spooled(nullptr, 0);
+  pipeline.spoolCaptures = options.spool;
+  pipeline.spooler = [&](Camera& source) -> ByteSource*
+  {
+    constexpr uint32_t SectorSize = 4096;
+    ByteSource& src = source.picture();
+    uint32_t size = src.remaining();
+    bool ok = size <= spool.size();
+    for (uint32_t done = 0; ok && done < size; done += SectorSize)
+    {
+      ok = readFully(src, spool.data() + done, std::min(size - done, SectorSize));
+      Scheduler::yield();
+    }
+    src.discard();
+    if (!ok)
+    {
+      return nullptr;
+    }
+    spooled = MemoryByteSource(spool.data(), size);
+    return &spooled;
+  };
+
+  if (!options.bench.empty())
+  {
+    Bench bench(*inky, pipeline, std::cout);
+    bool ok = bench.run(options.bench);
+    DeferredLog::drain(printLogEntry);
+    return ok ? 0 : 1;
+  }
+
+  // Stands in for the firmware's button task, so waits wake to poll it as
+  // they would on the device and the gaps between yields can be measured
+  Scheduler::add("button", 20, TaskWhen::Always, []() { });
+
+  int failed = 0;
+  for (int i=0; i < loaded; ++i)
+  {
+    SimBoardStats before = board.stats();
+    uint64_t startUs = board.clock.nowUs();
+    uint64_t captureUs = camera.captureUs + camera.readoutUs;
+    size_t refreshes = panel.refreshes.size();
+    auto hostStart = std::chrono::steady_clock::now();
+
+    Scheduler::resetLongestGap();
+    bool ok = pipeline.snap(camera, camera.format());
+
+    auto hostMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - hostStart).count();
+    DeferredLog::drain(printLogEntry);
+    const ReplayCamera::Picture& picture = *camera.current();
+    if (!ok || panel.refreshes.size() == refreshes)
+    {
+      std::cerr << picture.name << ": snap failed" << std::endl;
+      ++failed;
+      continue;
+    }
+
+    const SimInky::Refresh& refresh = panel.refreshes.back();
+    fs::path out = options.outDir / (picture.name + ".png");
+    if (!writePng(out.string(), refresh.width, refresh.height, refresh.pixels))
+    {
+      std::cerr << out.string() << ": can't write output" << std::endl;
+      ++failed;
+      continue;
+    }
+
+    std::cout << picture.name << ": " << picture.width << "x" << picture.height << " "
+              << magic_enum::enum_name(picture.format) << " -> " << out.string() << std::endl;
+    SimBoardStats after = board.stats();
+    std::cout << "  modeled " << ms(board.clock.nowUs() - startUs) << " ms:"
+              << " camera " << ms(camera.captureUs + camera.readoutUs - captureUs)
+              << ", spi " << ms(after.spiUs - before.spiUs) << " (" << after.spiBytes - before.spiBytes << " bytes)"
+              << ", sleep/busy " << ms(after.sleptUs - before.sleptUs)
+              << ", i2c " << ms(after.i2cUs - before.i2cUs)
+              << "; longest without yielding " << ms(Scheduler::longestGapUs())
+              << "; host " << hostMs << " ms" << std::endl;
+  }
+
+  if (!options.tracePath.empty())
+  {
+    std::ofstream trace(options.tracePath);
+    printTrace(trace);
+  }
+  if (options.stats)
+  {
+    printSnapStats(std::cout);
+  }
+  if (DeferredLog::dropped() > 0)
+  {
+    std::cout << "Log dropped " << DeferredLog::dropped() << " messages" << std::endl;
+  }
+
+  std::cout << "Simulated " << loaded - failed << " of " << loaded << " snaps on " << options.panel->name
+            << ", " << ms(board.clock.nowUs()) << " ms modeled in total" << std::endl;
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Turn the output of the pinky `trace` command into a Chrome trace.
+
+Reads the dump from a file (a saved terminal log, or pinky_sim --trace) or
+fetches it from the device, and writes JSON that chrome://tracing and
+https://ui.perfetto.dev open as a timeline, one track per core. A summary of
+where the time went is printed as well.
+
+    trace2chrome.py log.txt -o snap.json
+    trace2chrome.py --port /dev/ttyACM0 -o snap.json
+"""
+
+import argparse
+import json
+import os
+import select
+import sys
+import termios
+import time
+import tty
+
+# Panel commands the WaitBusy and SpiUpload spans are tagged with (UC8159,
+# E673 and SSD1683 share some of the numbers, so both names are given)
+COMMANDS = {
+    0x02: "POF",
+    0x04: "PON",
+    0x10: "DTM1",
+    0x12: "DRF / SW_RESET",
+    0x20: "MASTER_ACTIVATE",
+    0x24: "WRITE_RAM",
+    0x26: "WRITE_ALTRAM",
+}
+
+# What the arg of each span is
+ARGS = {
+    "CameraRead": "bursts",
+    "DecodeRow": "row",
+    "Dither": "row",
+    "SpiUpload": "command",
+    "WaitBusy": "command",
+}
+
+WRAP = 1 << 32
+
+
+def parse(lines):
+    """Events from the last dump in lines, as (span, core, start, duration, arg)"""
+    events = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith("Trace: "):
+            events = []
+        elif line == "Trace end":
+            if events is not None:
+                return events
+        elif events is not None:
+            fields = line.split()
+            if len(fields) == 5:
+                events.append((fields[0],) + tuple(int(f) for f in fields[1:]))
+    if events is None:
+        raise ValueError("no trace dump found")
+    return events
+
+
+def fetch(port, timeout=10.0):
+    """Run the trace command on the device and read back its output"""
+    fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd, termios.TCSANOW)
+    try:
+        os.write(fd, b"trace\n")
+        data = b""
+        deadline = time.time() + timeout
+        while b"Trace end" not in data:
+            remaining = deadline - time.time()
+            if remaining <= 0 or not select.select([fd], [], [], remaining)[0]:
+                raise TimeoutError("no trace from the device")
+            data += os.read(fd, 4096)
+        return data.decode(errors="replace").splitlines()
+    finally:
+        os.close(fd)
+
+
+def to_chrome(events):
+    """Chrome trace events, with timestamps unwrapped from 32 bits"""
+    trace = []
+    base = 0
+    last = None
+    for span, core, start, duration, arg in events:
+        if last is not None and start + base < last - WRAP // 2:
+            base += WRAP
+        last = start + base
+        event = {"name": span, "ph": "X", "ts": start + base, "dur": duration, "pid": 0, "tid": core}
+        if span in ARGS:
+            name = ARGS[span]
+            event["args"] = {name: COMMANDS.get(arg, "0x%02x" % arg) if name == "command" else arg}
+        if span == "WaitBusy" and arg in COMMANDS:
+            event["name"] = "WaitBusy " + COMMANDS[arg]
+        trace.append(event)
+    for core in sorted({e["tid"] for e in trace}):
+        trace.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": core, "args": {"name": "core%d" % core}})
+    return trace
+
+
+def summarize(events):
+    totals = {}
+    for span, _core, _start, duration, _arg in events:
+        count, total = totals.get(span, (0, 0))
+        totals[span] = (count + 1, total + duration)
+    print("%-12s %8s %12s %10s" % ("span", "count", "total ms", "mean us"))
+    for span, (count, total) in sorted(totals.items(), key=lambda item: -item[1][1]):
+        print("%-12s %8d %12.1f %10.1f" % (span, count, total / 1000.0, total / count))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dump", nargs="?", help="file holding the trace command's output")
+    parser.add_argument("--port", help="serial port of the device, to fetch the trace from")
+    parser.add_argument("-o", "--output", default="trace.json", help="Chrome trace to write")
+    args = parser.parse_args()
+
+    try:
+        if args.port:
+            lines = fetch(args.port)
+        elif args.dump:
+            with open(args.dump, errors="replace") as f:
+                lines = f.read().splitlines()
+        else:
+            parser.error("give a dump file or --port")
+        events = parse(lines)
+        with open(args.output, "w") as f:
+            json.dump({"traceEvents": to_chrome(events), "displayTimeUnit": "ms"}, f)
+    except (OSError, ValueError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    print("%d events -> %s" % (len(events), args.output))
+    summarize(events)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())